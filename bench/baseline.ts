@@ -0,0 +1,63 @@
+import { existsSync, mkdirSync, readFileSync, writeFileSync } from 'node:fs';
+import { dirname } from 'node:path';
+import { IRouteResult } from './load-driver';
+
+export interface IBenchReport {
+  createdAt: string;
+  node: string;
+  // backend the app talked to, 'stub' or 'simulator'
+  rippled?: string;
+  settings: Record<string, number>;
+  routes: IRouteResult[];
+}
+
+export interface IRegression {
+  route: string;
+  metric: 'p99' | 'requestsPerSecond' | 'errors';
+  baseline: number;
+  current: number;
+}
+
+export function readReport(path: string): IBenchReport | undefined {
+  return existsSync(path) ? JSON.parse(readFileSync(path, 'utf8')) : undefined;
+}
+
+export function writeReport(path: string, report: IBenchReport) {
+  mkdirSync(dirname(path), { recursive: true });
+  writeFileSync(path, JSON.stringify(report, null, 2) + '\n');
+}
+
+/**
+ * Routes slower than the baseline by more than the tolerance, in p99 latency or in throughput, or failing
+ * requests that did not fail before. Routes missing from either side are not compared.
+ */
+export function findRegressions(baseline: IBenchReport, current: IBenchReport, tolerance: number): IRegression[] {
+  const regressions: IRegression[] = [];
+  const baselineRoutes = new Map(baseline.routes.map((route) => [route.name, route]));
+  current.routes.forEach((route) => {
+    const before = baselineRoutes.get(route.name);
+    if (!before) {
+      return;
+    }
+    if (route.latencyMs.p99 > before.latencyMs.p99 * (1 + tolerance)) {
+      regressions.push({
+        route: route.name,
+        metric: 'p99',
+        baseline: before.latencyMs.p99,
+        current: route.latencyMs.p99,
+      });
+    }
+    if (route.requestsPerSecond < before.requestsPerSecond * (1 - tolerance)) {
+      regressions.push({
+        route: route.name,
+        metric: 'requestsPerSecond',
+        baseline: before.requestsPerSecond,
+        current: route.requestsPerSecond,
+      });
+    }
+    if (route.errors > before.errors) {
+      regressions.push({ route: route.name, metric: 'errors', baseline: before.errors, current: route.errors });
+    }
+  });
+  return regressions;
+}
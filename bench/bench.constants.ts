@@ -0,0 +1,43 @@
+import { join } from 'node:path';
+
+// concurrent requests kept open per route and requests measured per route after the warmup
+export const BENCH_CONCURRENCY = parseInt(process.env.BENCH_CONCURRENCY || '32');
+export const BENCH_REQUESTS = parseInt(process.env.BENCH_REQUESTS || '2000');
+export const BENCH_WARMUP_REQUESTS = parseInt(process.env.BENCH_WARMUP_REQUESTS || '200');
+
+// only routes whose name matches are driven, e.g. BENCH_ROUTES='^GET'
+export const BENCH_ROUTES = new RegExp(process.env.BENCH_ROUTES || '.*');
+
+// latency added by the rippled stub to every response, uniformly spread by the jitter
+export const BENCH_STUB_LATENCY_MS = parseInt(process.env.BENCH_STUB_LATENCY_MS || '5');
+export const BENCH_STUB_JITTER_MS = parseInt(process.env.BENCH_STUB_JITTER_MS || '2');
+export const BENCH_LEDGER_INTERVAL_MS = parseInt(process.env.BENCH_LEDGER_INTERVAL_MS || '3500');
+
+// 'stub' replays the recorded fixtures, 'simulator' applies transactions to a ledger seeded from them
+export const BENCH_RIPPLED = process.env.BENCH_RIPPLED || 'stub';
+// code run by the simulator for seeded hooks and port of the standalone simulator
+export const BENCH_HOOK_CODE = process.env.BENCH_HOOK_CODE || join(__dirname, '..', 'build', 'rental_state_hook.wasm');
+export const SIMULATOR_PORT = parseInt(process.env.SIMULATOR_PORT || '6006');
+// id, fees and reserves (in drops) of the simulated network, the id defaults to the one the service signs for
+export const SIMULATOR_NETWORK = {
+  networkId: parseInt(process.env.NETWORK_ID || '21338'),
+  baseFee: 10,
+  reserveBase: 1000000,
+  reserveIncrement: 200000,
+};
+
+export const BENCH_FIXTURES = process.env.BENCH_FIXTURES || join(__dirname, 'fixtures', 'rippled-responses.json');
+export const BENCH_BASELINE = process.env.BENCH_BASELINE || join(__dirname, 'baselines', 'baseline.json');
+export const BENCH_RESULTS = process.env.BENCH_RESULTS || join(__dirname, 'results', 'latest.json');
+
+// relative slowdown of p99 latency or throughput tolerated against the baseline before the run fails
+export const BENCH_TOLERANCE = parseFloat(process.env.BENCH_TOLERANCE || '0.15');
+
+// genesis account of a fresh rippled, a valid key pair is needed because transactions are signed locally
+export const BENCH_ACCOUNT = {
+  address: 'rHb9CJAWyB4rj91VRWn96DkukG4bwdtyTh',
+  secret: 'snoPBrXtMeMyMHUVTgbuqAfg1SUTb',
+};
+export const BENCH_DESTINATION = 'rPqH8xKmKGLLiCgiZvXp2kYV4Cr3eNs6Mq';
+export const BENCH_URI_TOKEN_INDEX = '0FAC3CD45FCB800BB9CCCF907775E7D4FB167847D8999FF05CE7456D6C3A70FA';
+export const BENCH_HOOK_NS = '959178BFB45D36ACF0FB00D09AEA3512C387173CCD7BD4D9D2270DB3D9820FE2';
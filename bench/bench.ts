@@ -0,0 +1,136 @@
+/**
+ * Hermetic load benchmark: boots the Nest app against a local rippled stub replaying recorded responses,
+ * drives every route at fixed concurrency and compares p99 latency and throughput with the stored baseline.
+ * With BENCH_RIPPLED=simulator the app talks to the ledger simulator instead, so submits run the hook.
+ *
+ *   npm run bench                    run and fail on regressions against bench/baselines/baseline.json,
+ *                                    fails without running when no baseline is stored
+ *   npm run bench -- --update-baseline
+ *                                    run and store the results as the new baseline
+ */
+import { INestApplication } from '@nestjs/common';
+import { AddressInfo } from 'node:net';
+import { readFileSync } from 'node:fs';
+import { loadFixtures, RippledStub } from './rippled-stub';
+import { RippledSimulator } from './simulator/rippled-simulator';
+import { IRouteResult, LoadDriver } from './load-driver';
+import { findRegressions, IBenchReport, readReport, writeReport } from './baseline';
+import { BENCH_ROUTE_LIST, IBenchRoute } from './routes';
+import {
+  BENCH_BASELINE,
+  BENCH_CONCURRENCY,
+  BENCH_FIXTURES,
+  BENCH_HOOK_CODE,
+  BENCH_LEDGER_INTERVAL_MS,
+  BENCH_REQUESTS,
+  BENCH_RESULTS,
+  BENCH_RIPPLED,
+  BENCH_ROUTES,
+  BENCH_STUB_JITTER_MS,
+  BENCH_STUB_LATENCY_MS,
+  BENCH_TOLERANCE,
+  BENCH_WARMUP_REQUESTS,
+  SIMULATOR_NETWORK,
+} from './bench.constants';
+
+function createRippled(): RippledStub | RippledSimulator {
+  const fixtures = loadFixtures(BENCH_FIXTURES);
+  const timing = {
+    latencyMs: BENCH_STUB_LATENCY_MS,
+    jitterMs: BENCH_STUB_JITTER_MS,
+    ledgerIntervalMs: BENCH_LEDGER_INTERVAL_MS,
+  };
+  if (BENCH_RIPPLED === 'simulator') {
+    return RippledSimulator.fromFixtures(fixtures, readFileSync(BENCH_HOOK_CODE), { ...timing, ...SIMULATOR_NETWORK });
+  }
+  return new RippledStub(fixtures, timing);
+}
+
+async function startApp(endpoint: string): Promise<INestApplication> {
+  // the service reads its configuration from the environment when its modules are first imported
+  process.env.SERVER_API_ENDPOINT = endpoint;
+  // every submitting route signs for the same account, its lane has to hold all concurrent requests
+  process.env.SUBMISSION_MAX_QUEUED_PER_ACCOUNT = String(BENCH_CONCURRENCY * 2);
+  const { createApp } = await import('../src/app.factory');
+  const { AsyncLogger } = await import('../src/logging/async.logger');
+  const app = await createApp({ logger: new AsyncLogger('warn') });
+  await app.listen(0, '127.0.0.1');
+  return app;
+}
+
+async function runRoutes(app: INestApplication, routes: IBenchRoute[]): Promise<IRouteResult[]> {
+  const { port } = app.getHttpServer().address() as AddressInfo;
+  const driver = new LoadDriver(`http://127.0.0.1:${port}`, BENCH_CONCURRENCY);
+  const results: IRouteResult[] = [];
+  try {
+    for (const route of routes) {
+      const result = await driver.run(route, {
+        concurrency: BENCH_CONCURRENCY,
+        requests: BENCH_REQUESTS,
+        warmupRequests: BENCH_WARMUP_REQUESTS,
+      });
+      results.push(result);
+      console.log(
+        `${route.name.padEnd(48)} ${String(result.requestsPerSecond).padStart(9)} req/s` +
+          `  p50 ${result.latencyMs.p50} ms  p99 ${result.latencyMs.p99} ms` +
+          `  loop p99 ${result.eventLoopDelayMs.p99} ms  statuses ${JSON.stringify(result.statuses)}`
+      );
+    }
+  } finally {
+    driver.close();
+  }
+  return results;
+}
+
+async function bench() {
+  const updateBaseline = process.argv.includes('--update-baseline');
+  // a missing baseline fails the run instead of silently becoming the new one
+  const baseline = readReport(BENCH_BASELINE);
+  if (!updateBaseline && !baseline) {
+    console.error(`No baseline in ${BENCH_BASELINE}, store one with: npm run bench -- --update-baseline`);
+    process.exitCode = 1;
+    return;
+  }
+  const rippled = createRippled();
+  const app = await startApp(await rippled.start());
+
+  const report: IBenchReport = {
+    createdAt: new Date().toISOString(),
+    node: process.version,
+    rippled: BENCH_RIPPLED,
+    settings: {
+      concurrency: BENCH_CONCURRENCY,
+      requests: BENCH_REQUESTS,
+      warmupRequests: BENCH_WARMUP_REQUESTS,
+      stubLatencyMs: BENCH_STUB_LATENCY_MS,
+      stubJitterMs: BENCH_STUB_JITTER_MS,
+    },
+    routes: [],
+  };
+  try {
+    report.routes = await runRoutes(app, BENCH_ROUTE_LIST.filter(({ name }) => BENCH_ROUTES.test(name)));
+  } finally {
+    await app.close();
+    await rippled.stop();
+  }
+  console.log(`rippled requests served by the ${BENCH_RIPPLED}: ${JSON.stringify(rippled.getRequestCounts())}`);
+  writeReport(BENCH_RESULTS, report);
+
+  if (updateBaseline) {
+    writeReport(BENCH_BASELINE, report);
+    console.log(`Baseline stored in ${BENCH_BASELINE}`);
+    return;
+  }
+  const regressions = findRegressions(baseline, report, BENCH_TOLERANCE);
+  regressions.forEach(({ route, metric, baseline: before, current }) =>
+    console.error(`Regression in ${route}: ${metric} ${before} -> ${current}`)
+  );
+  if (regressions.length > 0) {
+    process.exitCode = 1;
+  }
+}
+
+bench().catch((err) => {
+  console.error(err);
+  process.exitCode = 1;
+});
@@ -0,0 +1,134 @@
+import { Agent, request } from 'node:http';
+import { monitorEventLoopDelay } from 'node:perf_hooks';
+import { IBenchRoute } from './routes';
+
+export interface ILatencySummary {
+  p50: number;
+  p99: number;
+  max: number;
+  mean: number;
+}
+
+export interface IRouteResult {
+  name: string;
+  requests: number;
+  concurrency: number;
+  requestsPerSecond: number;
+  // response latency as seen by the client, in milliseconds
+  latencyMs: ILatencySummary;
+  // delay of the event loop shared by the app, the stub and the driver while the route was driven
+  eventLoopDelayMs: ILatencySummary;
+  statuses: Record<string, number>;
+  errors: number;
+}
+
+export interface ILoadOptions {
+  concurrency: number;
+  requests: number;
+  warmupRequests: number;
+}
+
+export function percentile(sorted: number[], p: number): number {
+  if (sorted.length === 0) {
+    return 0;
+  }
+  return sorted[Math.min(sorted.length - 1, Math.ceil((p / 100) * sorted.length) - 1)];
+}
+
+function summarize(values: number[]): ILatencySummary {
+  const sorted = [...values].sort((a, b) => a - b);
+  const total = sorted.reduce((sum, value) => sum + value, 0);
+  return {
+    p50: round(percentile(sorted, 50)),
+    p99: round(percentile(sorted, 99)),
+    max: round(sorted[sorted.length - 1] ?? 0),
+    mean: round(sorted.length === 0 ? 0 : total / sorted.length),
+  };
+}
+
+const round = (value: number) => Math.round(value * 1000) / 1000;
+
+/**
+ * Closed-loop load: `concurrency` workers each send the next request once their previous one completed,
+ * over keep-alive connections, so the measured latency includes queueing inside the app only.
+ */
+export class LoadDriver {
+  private readonly agent: Agent;
+
+  constructor(
+    private readonly baseUrl: string,
+    concurrency: number
+  ) {
+    this.agent = new Agent({ keepAlive: true, maxSockets: concurrency });
+  }
+
+  async run(route: IBenchRoute, options: ILoadOptions): Promise<IRouteResult> {
+    await this.drive(route, options.warmupRequests, options.concurrency);
+    const eventLoopDelay = monitorEventLoopDelay({ resolution: 10 });
+    eventLoopDelay.enable();
+    const start = process.hrtime.bigint();
+    const samples = await this.drive(route, options.requests, options.concurrency);
+    const elapsedSeconds = Number(process.hrtime.bigint() - start) / 1e9;
+    eventLoopDelay.disable();
+    const statuses: Record<string, number> = {};
+    samples.forEach(({ status }) => (statuses[status] = (statuses[status] ?? 0) + 1));
+    return {
+      name: route.name,
+      requests: samples.length,
+      concurrency: options.concurrency,
+      requestsPerSecond: round(samples.length / elapsedSeconds),
+      latencyMs: summarize(samples.map(({ latencyMs }) => latencyMs)),
+      eventLoopDelayMs: {
+        p50: round(eventLoopDelay.percentile(50) / 1e6),
+        p99: round(eventLoopDelay.percentile(99) / 1e6),
+        max: round(eventLoopDelay.max / 1e6),
+        mean: round(eventLoopDelay.mean / 1e6),
+      },
+      statuses,
+      errors: samples.filter(({ status }) => status === 'error').length,
+    };
+  }
+
+  close() {
+    this.agent.destroy();
+  }
+
+  private async drive(route: IBenchRoute, total: number, concurrency: number) {
+    const samples: Array<{ status: string; latencyMs: number }> = [];
+    let issued = 0;
+    const worker = async () => {
+      while (issued < total) {
+        issued++;
+        const start = process.hrtime.bigint();
+        const status = await this.send(route).catch(() => 'error');
+        samples.push({ status, latencyMs: Number(process.hrtime.bigint() - start) / 1e6 });
+      }
+    };
+    await Promise.all(Array.from({ length: Math.min(concurrency, total) }, worker));
+    return samples;
+  }
+
+  private send(route: IBenchRoute): Promise<string> {
+    const body = route.body ? JSON.stringify(route.body()) : undefined;
+    return new Promise((resolve, reject) => {
+      const req = request(
+        `${this.baseUrl}${route.path}`,
+        {
+          method: route.method,
+          agent: this.agent,
+          headers: {
+            ...route.headers,
+            ...(body && { 'content-type': 'application/json', 'content-length': Buffer.byteLength(body) }),
+          },
+        },
+        (res) => {
+          res.resume();
+          res.on('end', () => resolve(String(res.statusCode)));
+          res.on('error', reject);
+        }
+      );
+      req.on('error', reject);
+      req.end(body);
+    });
+  }
+}
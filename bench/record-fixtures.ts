@@ -0,0 +1,54 @@
+/**
+ * Refreshes the stub fixtures from a live node: replays the requests the service issues for the bench
+ * account and stores the responses under their command, keeping the match keys of the existing fixtures.
+ *
+ *   SERVER_API_ENDPOINT=wss://... BENCH_RECORD_ACCOUNT=r... npm run bench:record
+ */
+import { Client } from '@transia/xrpl';
+import { writeFileSync } from 'node:fs';
+import { loadFixtures } from './rippled-stub';
+import { BENCH_FIXTURES, BENCH_HOOK_NS, BENCH_URI_TOKEN_INDEX } from './bench.constants';
+
+const ENDPOINT = process.env.SERVER_API_ENDPOINT || 'wss://hooks-testnet-v3.xrpl-labs.com';
+const ACCOUNT = process.env.BENCH_RECORD_ACCOUNT;
+
+// read-only requests, submit and the error fixtures are kept as they are
+const RECORDED_REQUESTS: Array<Record<string, unknown>> = [
+  { command: 'server_info' },
+  { command: 'fee' },
+  { command: 'account_info', account: ACCOUNT, ledger_index: 'validated' },
+  { command: 'account_objects', account: ACCOUNT, type: 'uri_token', ledger_index: 'validated' },
+  { command: 'account_namespace', account: ACCOUNT, namespace_id: BENCH_HOOK_NS },
+  { command: 'ledger_entry', hook: { account: ACCOUNT } },
+  { command: 'ledger_entry', index: BENCH_URI_TOKEN_INDEX, ledger_index: 'validated' },
+];
+
+async function record() {
+  if (!ACCOUNT) {
+    throw new Error('BENCH_RECORD_ACCOUNT must name the account whose responses are recorded');
+  }
+  const fixtures = loadFixtures(BENCH_FIXTURES);
+  const client = new Client(ENDPOINT);
+  await client.connect();
+  try {
+    for (const request of RECORDED_REQUESTS) {
+      const command = request.command as string;
+      const { result } = await client.request(request as any);
+      const existing = fixtures[command] ?? [];
+      const match = request.hook ? { hook: {} } : request.index ? { index: request.index } : undefined;
+      const position = existing.findIndex((fixture) => JSON.stringify(fixture.match) === JSON.stringify(match));
+      const fixture = { ...(match && { match }), result: result as Record<string, unknown> };
+      fixtures[command] =
+        position === -1 ? [fixture, ...existing] : existing.map((entry, i) => (i === position ? fixture : entry));
+      console.log(`Recorded ${command}`);
+    }
+  } finally {
+    await client.disconnect();
+  }
+  writeFileSync(BENCH_FIXTURES, JSON.stringify(fixtures, null, 2) + '\n');
+}
+
+record().catch((err) => {
+  console.error(err);
+  process.exitCode = 1;
+});
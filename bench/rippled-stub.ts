@@ -0,0 +1,130 @@
+import { readFileSync } from 'node:fs';
+import { AddressInfo } from 'node:net';
+import { WebSocketServer } from 'ws';
+
+/**
+ * Recorded answer to a rippled command. The first fixture of a command whose `match` is a subset of the
+ * request is replayed, a fixture without `match` answers any request of its command.
+ */
+export interface IRippledFixture {
+  match?: Record<string, unknown>;
+  result?: Record<string, unknown>;
+  error?: string;
+  error_code?: number;
+}
+
+export type RippledFixtures = Record<string, IRippledFixture[]>;
+
+export interface IRippledStubOptions {
+  latencyMs: number;
+  jitterMs: number;
+  ledgerIntervalMs: number;
+}
+
+export function loadFixtures(path: string): RippledFixtures {
+  return JSON.parse(readFileSync(path, 'utf8'));
+}
+
+function matches(expected: unknown, actual: unknown): boolean {
+  if (expected && typeof expected === 'object') {
+    return (
+      !!actual &&
+      typeof actual === 'object' &&
+      Object.entries(expected).every(([key, value]) => matches(value, (actual as Record<string, unknown>)[key]))
+    );
+  }
+  return expected === actual;
+}
+
+/**
+ * WebSocket server speaking enough of the rippled API for the service to run against it: requests are
+ * answered from recorded fixtures after a configurable latency, and subscribers receive a ledgerClosed
+ * event on every ledger interval.
+ */
+export class RippledStub {
+  private server?: WebSocketServer;
+  private ledgerTimer?: NodeJS.Timeout;
+  private ledgerIndex: number;
+  private readonly requestCounts = new Map<string, number>();
+  private readonly subscribers = new Set<any>();
+
+  constructor(
+    private readonly fixtures: RippledFixtures,
+    private readonly options: IRippledStubOptions
+  ) {
+    this.ledgerIndex = (this.find({ command: 'ledger' })?.result?.ledger_index as number) ?? 1000;
+  }
+
+  start(): Promise<string> {
+    return new Promise((resolve) => {
+      this.server = new WebSocketServer({ host: '127.0.0.1', port: 0 });
+      this.server.on('connection', (socket) => {
+        socket.on('message', (data) => this.onRequest(socket, JSON.parse(data.toString())));
+        socket.on('close', () => this.subscribers.delete(socket));
+      });
+      this.server.on('listening', () => {
+        const { port } = this.server.address() as AddressInfo;
+        resolve(`ws://127.0.0.1:${port}`);
+      });
+      this.ledgerTimer = setInterval(() => this.closeLedger(), this.options.ledgerIntervalMs);
+    });
+  }
+
+  async stop(): Promise<void> {
+    clearInterval(this.ledgerTimer);
+    this.server?.clients.forEach((socket) => socket.terminate());
+    await new Promise((resolve) => this.server?.close(resolve));
+  }
+
+  getRequestCounts(): Record<string, number> {
+    return Object.fromEntries(this.requestCounts);
+  }
+
+  private onRequest(socket, request: Record<string, any>) {
+    const command = request.command;
+    this.requestCounts.set(command, (this.requestCounts.get(command) ?? 0) + 1);
+    if (command === 'subscribe') {
+      this.subscribers.add(socket);
+    }
+    const fixture = this.find(request) ?? { error: 'unknownCmd' };
+    const response = fixture.error
+      ? { id: request.id, type: 'response', status: 'error', error: fixture.error, error_code: fixture.error_code }
+      : { id: request.id, type: 'response', status: 'success', result: this.resultFor(command, request, fixture) };
+    const delay = this.options.latencyMs + (Math.random() * 2 - 1) * this.options.jitterMs;
+    setTimeout(() => socket.send(JSON.stringify(response)), Math.max(0, delay));
+  }
+
+  private find(request: Record<string, any>): IRippledFixture | undefined {
+    return this.fixtures[request.command]?.find(({ match }) => !match || matches(match, request));
+  }
+
+  // fields tied to the live request or ledger are filled in, everything else is replayed as recorded
+  private resultFor(command: string, request: Record<string, any>, fixture: IRippledFixture) {
+    if (command === 'submit') {
+      return { ...fixture.result, tx_blob: request.tx_blob };
+    }
+    if (command === 'subscribe' || command === 'ledger' || command === 'server_info') {
+      return { ...fixture.result, ledger_index: this.ledgerIndex };
+    }
+    return { ...fixture.result, ledger_current_index: this.ledgerIndex + 1, ledger_index: this.ledgerIndex };
+  }
+
+  private closeLedger() {
+    this.ledgerIndex++;
+    const ledger = this.find({ command: 'subscribe' })?.result ?? {};
+    const event = JSON.stringify({
+      type: 'ledgerClosed',
+      fee_base: ledger.fee_base ?? 10,
+      fee_ref: ledger.fee_ref ?? 10,
+      reserve_base: ledger.reserve_base ?? 1000000,
+      reserve_inc: ledger.reserve_inc ?? 200000,
+      ledger_hash: this.ledgerIndex.toString(16).toUpperCase().padStart(64, '0'),
+      ledger_index: this.ledgerIndex,
+      ledger_time: Math.floor(Date.now() / 1000) - 946684800,
+      txn_count: 0,
+      validated_ledgers: `1-${this.ledgerIndex}`,
+      ...(ledger.network_id !== undefined && { network_id: ledger.network_id }),
+    });
+    this.subscribers.forEach((socket) => socket.send(event));
+  }
+}
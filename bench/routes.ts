@@ -0,0 +1,91 @@
+import { BENCH_ACCOUNT, BENCH_DESTINATION, BENCH_HOOK_NS, BENCH_URI_TOKEN_INDEX } from './bench.constants';
+
+export interface IBenchRoute {
+  // stable name used as the key of the baseline
+  name: string;
+  method: 'GET' | 'POST' | 'PUT' | 'DELETE';
+  path: string;
+  body?: () => object;
+  headers?: Record<string, string>;
+}
+
+const TOKEN_URI =
+  '68747470733A2F2F6D656469612E74656E6F722E636F6D2F666752755A7A662D374B5541414141642F6465616C2D776974682D69742D73756E676C61737365732E6A736F6E';
+const OFFER_INDEX = 'F2EE2E7FC5A3E8FBBA0F0F1D9E39E9F0D9C4A6A0B8C97C0F6E4A3D2B1C0E9F8A';
+const deadline = () => new Date(Date.now() + 24 * 60 * 60 * 1000).toISOString();
+const { address, secret } = BENCH_ACCOUNT;
+
+// every controller route, with bodies accepted by the request validation
+export const BENCH_ROUTE_LIST: IBenchRoute[] = [
+  { name: 'GET /account/:num/info', method: 'GET', path: `/account/${address}/info` },
+  {
+    name: 'GET /account/:num/namespace/:namespace',
+    method: 'GET',
+    path: `/account/${address}/namespace/${BENCH_HOOK_NS}`,
+  },
+  {
+    name: 'GET /account/:num/namespace/:namespace/entries',
+    method: 'GET',
+    path: `/account/${address}/namespace/${BENCH_HOOK_NS}/entries`,
+  },
+  { name: 'GET /hook/:address', method: 'GET', path: `/hook/${address}` },
+  {
+    name: 'GET /hook/:address ndjson',
+    method: 'GET',
+    path: `/hook/${address}`,
+    headers: { accept: 'application/x-ndjson' },
+  },
+  { name: 'POST /hook', method: 'POST', path: '/hook', body: () => ({ address, secret, namespace: BENCH_HOOK_NS }) },
+  { name: 'PUT /hook/reset', method: 'PUT', path: '/hook/reset', body: () => ({ address, secret }) },
+  { name: 'DELETE /hook', method: 'DELETE', path: '/hook', body: () => ({ address, secret }) },
+  { name: 'GET /uri-tokens/:address', method: 'GET', path: `/uri-tokens/${address}` },
+  {
+    name: 'POST /uri-tokens',
+    method: 'POST',
+    path: '/uri-tokens',
+    body: () => ({ account: BENCH_ACCOUNT, uri: TOKEN_URI }),
+  },
+  {
+    name: 'DELETE /uri-tokens/:index',
+    method: 'DELETE',
+    path: `/uri-tokens/${BENCH_URI_TOKEN_INDEX}`,
+    body: () => BENCH_ACCOUNT,
+  },
+  {
+    name: 'POST /offers?type=START',
+    method: 'POST',
+    path: '/offers?type=START',
+    body: () => ({
+      account: BENCH_ACCOUNT,
+      destinationAccount: BENCH_DESTINATION,
+      uri: BENCH_URI_TOKEN_INDEX,
+      totalAmount: 600,
+      rentalType: 'COLLATERAL_FREE',
+      deadline: deadline(),
+    }),
+  },
+  {
+    name: 'DELETE /offers/:index',
+    method: 'DELETE',
+    path: `/offers/${OFFER_INDEX}`,
+    body: () => ({ account: BENCH_ACCOUNT }),
+  },
+  {
+    name: 'POST /offers/:index/accept-start',
+    method: 'POST',
+    path: `/offers/${OFFER_INDEX}/accept-start`,
+    body: () => ({ renterAccount: BENCH_ACCOUNT, deadline: deadline(), totalAmount: 600 }),
+  },
+  {
+    name: 'POST /offers/:index/accept-return',
+    method: 'POST',
+    path: `/offers/${OFFER_INDEX}/accept-return`,
+    body: () => ({ renterAccount: BENCH_ACCOUNT, deadline: deadline(), totalAmount: 600 }),
+  },
+  { name: 'GET /rentals/lender/:address', method: 'GET', path: `/rentals/lender/${address}` },
+  { name: 'GET /rentals/renter/:address', method: 'GET', path: `/rentals/renter/${address}` },
+  { name: 'GET /rentals/expiring', method: 'GET', path: '/rentals/expiring' },
+  { name: 'GET /rentals/returns', method: 'GET', path: '/rentals/returns' },
+  { name: 'GET /transactions/:hash', method: 'GET', path: `/transactions/${OFFER_INDEX}` },
+  { name: 'GET /metrics', method: 'GET', path: '/metrics' },
+];
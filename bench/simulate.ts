@@ -0,0 +1,37 @@
+/**
+ * Standalone ledger simulator for offline runs of the service: a local WebSocket endpoint seeded from the
+ * bench fixtures that applies submitted transactions and runs their hooks. The integration tests start their
+ * own (test-it/simulator.setup.ts).
+ *
+ *   npm run simulator
+ *   SERVER_API_ENDPOINT=ws://127.0.0.1:6006 npm run start
+ */
+import { readFileSync } from 'node:fs';
+import { loadFixtures } from './rippled-stub';
+import { RippledSimulator } from './simulator/rippled-simulator';
+import {
+  BENCH_ACCOUNT,
+  BENCH_FIXTURES,
+  BENCH_HOOK_CODE,
+  BENCH_LEDGER_INTERVAL_MS,
+  SIMULATOR_NETWORK,
+  SIMULATOR_PORT,
+} from './bench.constants';
+
+async function simulate() {
+  const simulator = RippledSimulator.fromFixtures(loadFixtures(BENCH_FIXTURES), readFileSync(BENCH_HOOK_CODE), {
+    latencyMs: 0,
+    jitterMs: 0,
+    ledgerIntervalMs: BENCH_LEDGER_INTERVAL_MS,
+    traceHooks: process.env.SIMULATOR_TRACE_HOOKS === 'true',
+    ...SIMULATOR_NETWORK,
+  });
+  const endpoint = await simulator.start(SIMULATOR_PORT);
+  console.log(`Ledger simulator listening on ${endpoint}, funded account: ${BENCH_ACCOUNT.address}`);
+  process.on('SIGINT', () => simulator.stop().then(() => process.exit(0)));
+}
+
+simulate().catch((err) => {
+  console.error(err);
+  process.exitCode = 1;
+});
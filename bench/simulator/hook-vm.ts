@@ -0,0 +1,302 @@
+// return codes of the hook API (hookapi error.h)
+export const HOOK_API_ERROR = {
+  OUT_OF_BOUNDS: -1n,
+  TOO_BIG: -3n,
+  TOO_SMALL: -4n,
+  DOESNT_EXIST: -5n,
+  INVALID_ARGUMENT: -7n,
+  CANT_RETURN_NEGATIVE: -33n,
+  INVALID_FLOAT: -10024n,
+};
+
+// HookResult of a hook execution as reported in the transaction metadata
+export enum HookExitType {
+  WASM_ERROR = 1,
+  ROLLBACK = 2,
+  ACCEPT = 3,
+}
+
+const HOOK_STATE_KEY_BYTES = 32;
+const HOOK_STATE_MAX_DATA_BYTES = 256;
+const ACCOUNT_ID_BYTES = 20;
+
+/**
+ * What a hook can observe while it runs: the originating transaction, the last closed ledger and the
+ * committed hook state of any account. Fields are given in their serialized form, without length prefix.
+ */
+export interface IHookContext {
+  hookAccount: Buffer;
+  namespace: Buffer;
+  otxnType: number;
+  ledgerLastTime: number;
+  otxnField(fieldId: number): Buffer | undefined;
+  otxnParam(name: Buffer): Buffer | undefined;
+  readState(account: Buffer, namespace: Buffer, key: Buffer): Buffer | undefined;
+}
+
+export interface IHookExecution {
+  exitType: HookExitType;
+  returnCode: bigint;
+  returnString: string;
+  // state written by the hook, keyed by the hex of the padded key, undefined for deleted entries
+  stateChanges: Map<string, Buffer | undefined>;
+}
+
+class HookExit {
+  constructor(
+    readonly exitType: HookExitType,
+    readonly returnCode: bigint,
+    readonly returnString: string
+  ) {}
+}
+
+/**
+ * Runs hook wasm with the subset of the hook API the rental hook imports. Modules are compiled once per
+ * HookHash and instantiated per execution, so every run starts from fresh linear memory like on xahaud.
+ */
+export class HookVm {
+  private readonly modules = new Map<string, WebAssembly.Module>();
+
+  constructor(private readonly trace: (message: string) => void = () => undefined) {}
+
+  run(hookHash: string, code: Buffer, context: IHookContext): IHookExecution {
+    const stateChanges = new Map<string, Buffer | undefined>();
+    let memory: WebAssembly.Memory;
+    const host = new HookHostApi(() => memory, context, stateChanges, this.trace);
+    try {
+      const instance = new WebAssembly.Instance(this.compile(hookHash, code), { env: host.imports() });
+      memory = instance.exports.memory as WebAssembly.Memory;
+      (instance.exports.hook as (ctx: number) => bigint)(0);
+      return { exitType: HookExitType.ACCEPT, returnCode: 0n, returnString: '', stateChanges };
+    } catch (err) {
+      if (err instanceof HookExit) {
+        const accepted = err.exitType === HookExitType.ACCEPT;
+        return { ...err, stateChanges: accepted ? stateChanges : new Map() };
+      }
+      this.trace(`hook ${hookHash} failed: ${err?.message}`);
+      return { exitType: HookExitType.WASM_ERROR, returnCode: -1n, returnString: '', stateChanges: new Map() };
+    }
+  }
+
+  private compile(hookHash: string, code: Buffer): WebAssembly.Module {
+    let module = this.modules.get(hookHash);
+    if (!module) {
+      module = new WebAssembly.Module(exportMemory(code));
+      this.modules.set(hookHash, module);
+    }
+    return module;
+  }
+}
+
+class HookHostApi {
+  constructor(
+    private readonly memory: () => WebAssembly.Memory,
+    private readonly context: IHookContext,
+    private readonly stateChanges: Map<string, Buffer | undefined>,
+    private readonly trace: (message: string) => void
+  ) {}
+
+  imports(): Record<string, (...args: any[]) => bigint | number> {
+    const { context } = this;
+    return {
+      _g: () => 1,
+      accept: (ptr: number, len: number, code: bigint) => this.exit(HookExitType.ACCEPT, ptr, len, code),
+      rollback: (ptr: number, len: number, code: bigint) => this.exit(HookExitType.ROLLBACK, ptr, len, code),
+      trace: (mptr: number, mlen: number, dptr: number, dlen: number, asHex: number) => {
+        const data = this.read(dptr, dlen);
+        this.trace(`${this.read(mptr, mlen)} ${asHex ? data.toString('hex').toUpperCase() : data.toString()}`);
+        return 0n;
+      },
+      trace_num: (ptr: number, len: number, value: bigint) => {
+        this.trace(`${this.read(ptr, len)} ${value}`);
+        return 0n;
+      },
+      otxn_type: () => BigInt(context.otxnType),
+      ledger_last_time: () => BigInt(context.ledgerLastTime),
+      hook_account: (ptr: number, len: number) => this.write(ptr, len, context.hookAccount),
+      otxn_field: (ptr: number, len: number, fieldId: number) => this.write(ptr, len, context.otxnField(fieldId)),
+      otxn_param: (ptr: number, len: number, nptr: number, nlen: number) => {
+        if (nlen === 0) {
+          return HOOK_API_ERROR.TOO_SMALL;
+        }
+        if (nlen > HOOK_STATE_KEY_BYTES) {
+          return HOOK_API_ERROR.TOO_BIG;
+        }
+        return this.write(ptr, len, context.otxnParam(this.read(nptr, nlen)));
+      },
+      state: (ptr: number, len: number, kptr: number, klen: number) =>
+        this.readState(ptr, len, kptr, klen, context.hookAccount, context.namespace),
+      state_foreign: (ptr, len, kptr, klen, nptr, nlen, aptr, alen) => {
+        if (nptr === 0 && aptr === 0) {
+          return this.readState(ptr, len, kptr, klen, context.hookAccount, context.namespace);
+        }
+        if (nlen !== HOOK_STATE_KEY_BYTES || alen !== ACCOUNT_ID_BYTES) {
+          return HOOK_API_ERROR.INVALID_ARGUMENT;
+        }
+        return this.readState(ptr, len, kptr, klen, this.read(aptr, alen), this.read(nptr, nlen));
+      },
+      state_set: (ptr: number, len: number, kptr: number, klen: number) => {
+        const key = this.stateKey(kptr, klen);
+        if (typeof key === 'bigint') {
+          return key;
+        }
+        if (len > HOOK_STATE_MAX_DATA_BYTES) {
+          return HOOK_API_ERROR.TOO_BIG;
+        }
+        this.stateChanges.set(key.toString('hex').toUpperCase(), len === 0 ? undefined : this.read(ptr, len));
+        return BigInt(len);
+      },
+      float_int: (value: bigint, decimals: number, absolute: number) => floatInt(value, decimals, absolute !== 0),
+    };
+  }
+
+  private readState(ptr: number, len: number, kptr: number, klen: number, account: Buffer, namespace: Buffer) {
+    const key = this.stateKey(kptr, klen);
+    if (typeof key === 'bigint') {
+      return key;
+    }
+    const own = account.equals(this.context.hookAccount) && namespace.equals(this.context.namespace);
+    const hexKey = key.toString('hex').toUpperCase();
+    const data =
+      own && this.stateChanges.has(hexKey)
+        ? this.stateChanges.get(hexKey)
+        : this.context.readState(account, namespace, key);
+    return this.write(ptr, len, data);
+  }
+
+  // keys shorter than 32 bytes are left padded with zeros
+  private stateKey(kptr: number, klen: number): Buffer | bigint {
+    if (klen === 0) {
+      return HOOK_API_ERROR.TOO_SMALL;
+    }
+    if (klen > HOOK_STATE_KEY_BYTES) {
+      return HOOK_API_ERROR.TOO_BIG;
+    }
+    return Buffer.concat([Buffer.alloc(HOOK_STATE_KEY_BYTES - klen), this.read(kptr, klen)]);
+  }
+
+  private exit(exitType: HookExitType, ptr: number, len: number, code: bigint): never {
+    throw new HookExit(exitType, code, this.read(ptr, len).toString().replace(/\0+$/, ''));
+  }
+
+  private read(ptr: number, len: number): Buffer {
+    const buffer = Buffer.from(this.memory().buffer);
+    if (ptr + len > buffer.length) {
+      throw new Error(`hook read out of bounds at ${ptr}`);
+    }
+    return Buffer.from(buffer.subarray(ptr, ptr + len));
+  }
+
+  private write(ptr: number, len: number, data: Buffer | undefined): bigint {
+    if (data === undefined) {
+      return HOOK_API_ERROR.DOESNT_EXIST;
+    }
+    if (len < data.length) {
+      return HOOK_API_ERROR.TOO_SMALL;
+    }
+    const buffer = Buffer.from(this.memory().buffer);
+    if (ptr + data.length > buffer.length) {
+      return HOOK_API_ERROR.OUT_OF_BOUNDS;
+    }
+    data.copy(buffer, ptr);
+    return BigInt(data.length);
+  }
+}
+
+/**
+ * float_int of the hook API: the integer part of an XFL (sign bit 62, exponent + 97 in bits 54-61,
+ * normalized 16 digit mantissa below) after shifting it by the requested decimal places.
+ */
+export function floatInt(xfl: bigint, decimals: number, absolute: boolean): bigint {
+  if (xfl === 0n) {
+    return 0n;
+  }
+  if (decimals > 15) {
+    return HOOK_API_ERROR.INVALID_ARGUMENT;
+  }
+  const mantissa = xfl & ((1n << 54n) - 1n);
+  if (xfl < 0n || mantissa < 10n ** 15n || mantissa >= 10n ** 16n) {
+    return HOOK_API_ERROR.INVALID_FLOAT;
+  }
+  if (((xfl >> 62n) & 1n) === 0n && !absolute) {
+    return HOOK_API_ERROR.CANT_RETURN_NEGATIVE;
+  }
+  const exponent = Number((xfl >> 54n) & 0xffn) - 97 + decimals;
+  const value = exponent >= 0 ? mantissa * 10n ** BigInt(exponent) : mantissa / 10n ** BigInt(-exponent);
+  return value >= 1n << 63n ? HOOK_API_ERROR.TOO_BIG : value;
+}
+
+/**
+ * Hooks keep their linear memory internal while the host API has to read and write it, so the memory
+ * is added to the export section of the module under the name `memory`.
+ */
+export function exportMemory(code: Buffer): Buffer {
+  const sections: Array<{ id: number; body: Buffer }> = [];
+  let offset = 8;
+  while (offset < code.length) {
+    const id = code[offset];
+    const [size, start] = readUleb(code, offset + 1);
+    sections.push({ id, body: code.subarray(start, start + size) });
+    offset = start + size;
+  }
+  const exportSection = sections.find(({ id }) => id === EXPORT_SECTION_ID);
+  const [count, entriesStart] = exportSection ? readUleb(exportSection.body, 0) : [0, 0];
+  const entries = exportSection ? exportSection.body.subarray(entriesStart) : Buffer.alloc(0);
+  if (exportsMemory(entries, count)) {
+    return code;
+  }
+  const memoryExport = Buffer.concat([writeUleb(6), Buffer.from('memory'), Buffer.from([EXTERNAL_KIND_MEMORY, 0])]);
+  const body = Buffer.concat([writeUleb(count + 1), entries, memoryExport]);
+  if (exportSection) {
+    exportSection.body = body;
+  } else {
+    // sections are ordered by id, custom sections (0) aside
+    const position = sections.findIndex(({ id }) => id > EXPORT_SECTION_ID);
+    sections.splice(position === -1 ? sections.length : position, 0, { id: EXPORT_SECTION_ID, body });
+  }
+  return Buffer.concat([
+    code.subarray(0, 8),
+    ...sections.flatMap(({ id, body }) => [Buffer.from([id]), writeUleb(body.length), body]),
+  ]);
+}
+
+const EXPORT_SECTION_ID = 7;
+const EXTERNAL_KIND_MEMORY = 2;
+
+function exportsMemory(entries: Buffer, count: number): boolean {
+  let offset = 0;
+  for (let i = 0; i < count; i++) {
+    const [nameLength, nameStart] = readUleb(entries, offset);
+    const kind = entries[nameStart + nameLength];
+    if (kind === EXTERNAL_KIND_MEMORY) {
+      return true;
+    }
+    offset = readUleb(entries, nameStart + nameLength + 1)[1];
+  }
+  return false;
+}
+
+function readUleb(buffer: Buffer, offset: number): [number, number] {
+  let value = 0;
+  let shift = 0;
+  let byte: number;
+  do {
+    byte = buffer[offset++];
+    value += (byte & 0x7f) * 2 ** shift;
+    shift += 7;
+  } while (byte & 0x80);
+  return [value, offset];
+}
+
+function writeUleb(value: number): Buffer {
+  const bytes: number[] = [];
+  do {
+    let byte = value & 0x7f;
+    value = Math.floor(value / 128);
+    if (value > 0) {
+      byte |= 0x80;
+    }
+    bytes.push(byte);
+  } while (value > 0);
+  return Buffer.from(bytes);
+}
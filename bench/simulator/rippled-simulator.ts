@@ -0,0 +1,437 @@
+import { AddressInfo } from 'node:net';
+import { WebSocketServer } from 'ws';
+import { accountKeylet, hookDefinitionKeylet, hookKeylet, sha512Half } from '../../src/xrpl/keylet/keylet.utils';
+import { HOOK_ON } from '../../src/hooks/hook.constants';
+import { RippledFixtures } from '../rippled-stub';
+import { HookVm } from './hook-vm';
+import { LedgerObject, SimulatedLedger } from './simulated-ledger';
+import { ENGINE_RESULT_CODES, IAppliedTransaction, TransactionEngine } from './transaction-engine';
+
+export interface IRippledSimulatorOptions {
+  latencyMs: number;
+  jitterMs: number;
+  ledgerIntervalMs: number;
+  networkId: number;
+  baseFee: number;
+  reserveBase: number;
+  reserveIncrement: number;
+  // logs the trace calls of executed hooks
+  traceHooks?: boolean;
+}
+
+class RippledError {
+  constructor(
+    readonly error: string,
+    readonly error_code: number
+  ) {}
+}
+
+const RIPPLE_EPOCH_OFFSET = 946684800;
+// reported in the xahaud format, clients decide from it whether transactions carry a NetworkID
+const BUILD_VERSION = '2023.10.30-release+simulator';
+const ACCOUNT_OBJECT_TYPES = { uri_token: 'URIToken', hook: 'Hook', hook_definition: 'HookDefinition' };
+const DEFAULT_PAGE_LIMIT = 200;
+// submitted transactions kept for the tx command, the oldest are forgotten first
+const MAX_KEPT_TRANSACTIONS = 10000;
+
+const rippleTime = () => Math.floor(Date.now() / 1000) - RIPPLE_EPOCH_OFFSET;
+
+/**
+ * Ledger holding what the recorded fixtures describe: account roots, owned objects, hooks and the state of
+ * the recorded namespaces. Hooks whose definition was not recorded run the given code.
+ */
+export function ledgerFromFixtures(fixtures: RippledFixtures, hookCode: Buffer): SimulatedLedger {
+  const ledger = new SimulatedLedger();
+  const results = (command: string): Array<Record<string, any>> =>
+    (fixtures[command] ?? []).map(({ result }) => result).filter((result) => !!result);
+  results('account_info').forEach(({ account_data }) => ledger.put(account_data));
+  results('account_objects').forEach(({ account_objects }) => account_objects.forEach((object) => ledger.put(object)));
+  results('ledger_entry')
+    .filter(({ node }) => node)
+    .forEach(({ index, node }) => {
+      // Hook objects are looked up by account, whatever index they were recorded under
+      const account = node.Account ?? node.Owner;
+      const isHook = node.LedgerEntryType === 'Hook';
+      ledger.put(isHook ? { ...node, Account: account, index: hookKeylet(account) } : { ...node, index });
+    });
+  results('account_namespace').forEach(({ account, namespace_id, namespace_entries }) =>
+    namespace_entries.forEach(({ HookStateKey, HookStateData }) =>
+      ledger.putState(account, namespace_id, HookStateKey, HookStateData)
+    )
+  );
+  const hookHashes = results('ledger_entry')
+    .flatMap(({ node }) => node?.Hooks ?? [])
+    .map(({ Hook }) => Hook.HookHash);
+  new Set(hookHashes).forEach((hookHash) => {
+    if (hookHash && !ledger.read(hookDefinitionKeylet(hookHash))) {
+      ledger.put({
+        CreateCode: hookCode.toString('hex').toUpperCase(),
+        Flags: 0,
+        HookApiVersion: 0,
+        HookHash: hookHash,
+        HookOn: HOOK_ON,
+        LedgerEntryType: 'HookDefinition',
+        ReferenceCount: '1',
+        index: hookDefinitionKeylet(hookHash),
+      });
+    }
+  });
+  return ledger;
+}
+
+/**
+ * Local stand-in for a xahaud node, speaking the subset of the WebSocket API the service uses. Submitted
+ * transactions are applied to the open ledger at once, running the installed hooks, and are published to
+ * the transactions stream when the ledger closes on the configured interval. Reads for the current ledger
+ * see the open ledger, every other read sees the last closed one.
+ */
+export class RippledSimulator {
+  private server?: WebSocketServer;
+  private ledgerTimer?: NodeJS.Timeout;
+  private readonly engine: TransactionEngine;
+  private closed: SimulatedLedger;
+  private ledgerIndex: number;
+  private readonly firstLedgerIndex: number;
+  private ledgerHash: string;
+  private closeTime = rippleTime();
+  private pending: IAppliedTransaction[] = [];
+  private readonly transactions = new Map<string, { applied: IAppliedTransaction; ledgerIndex?: number }>();
+  private readonly requestCounts = new Map<string, number>();
+  private readonly ledgerSubscribers = new Set<any>();
+  private readonly transactionSubscribers = new Set<any>();
+  private readonly commands: Record<string, (request: Record<string, any>, socket) => Record<string, any>> = {
+    server_info: () => this.serverInfo(),
+    fee: () => this.fee(),
+    ping: () => ({}),
+    ledger: (request) => this.ledger(request),
+    subscribe: (request, socket) => this.subscribe(request, socket),
+    unsubscribe: (request, socket) => this.unsubscribe(request, socket),
+    account_info: (request) => this.accountInfo(request),
+    account_objects: (request) => this.accountObjects(request),
+    account_namespace: (request) => this.accountNamespace(request),
+    ledger_entry: (request) => this.ledgerEntry(request),
+    submit: (request) => this.submit(request),
+    tx: (request) => this.tx(request),
+  };
+
+  constructor(
+    private readonly open: SimulatedLedger,
+    private readonly options: IRippledSimulatorOptions,
+    ledgerIndex = 1000
+  ) {
+    const vm = new HookVm(options.traceHooks ? (message) => console.log(`[hook] ${message}`) : undefined);
+    this.engine = new TransactionEngine(vm, options);
+    this.closed = open.snapshot();
+    this.ledgerIndex = ledgerIndex;
+    this.firstLedgerIndex = ledgerIndex;
+    this.ledgerHash = this.hashLedger();
+  }
+
+  static fromFixtures(fixtures: RippledFixtures, hookCode: Buffer, options: IRippledSimulatorOptions) {
+    const ledgerIndex = fixtures.ledger?.[0]?.result?.ledger_index as number;
+    return new RippledSimulator(ledgerFromFixtures(fixtures, hookCode), options, ledgerIndex);
+  }
+
+  start(port = 0): Promise<string> {
+    return new Promise((resolve) => {
+      this.server = new WebSocketServer({ host: '127.0.0.1', port });
+      this.server.on('connection', (socket) => {
+        socket.on('message', (data) => this.onRequest(socket, JSON.parse(data.toString())));
+        socket.on('close', () => {
+          this.ledgerSubscribers.delete(socket);
+          this.transactionSubscribers.delete(socket);
+        });
+      });
+      this.server.on('listening', () => {
+        const { port } = this.server.address() as AddressInfo;
+        resolve(`ws://127.0.0.1:${port}`);
+      });
+      this.ledgerTimer = setInterval(() => this.closeLedger(), this.options.ledgerIntervalMs);
+    });
+  }
+
+  async stop(): Promise<void> {
+    clearInterval(this.ledgerTimer);
+    this.server?.clients.forEach((socket) => socket.terminate());
+    await new Promise((resolve) => this.server?.close(resolve));
+  }
+
+  getRequestCounts(): Record<string, number> {
+    return Object.fromEntries(this.requestCounts);
+  }
+
+  private onRequest(socket, request: Record<string, any>) {
+    const command = request.command;
+    this.requestCounts.set(command, (this.requestCounts.get(command) ?? 0) + 1);
+    let response: Record<string, any>;
+    try {
+      const handler = this.commands[command];
+      if (!handler) {
+        throw new RippledError('unknownCmd', 32);
+      }
+      response = { id: request.id, type: 'response', status: 'success', result: handler(request, socket) };
+    } catch (err) {
+      const { error, error_code } = err instanceof RippledError ? err : new RippledError('internal', 73);
+      response = { id: request.id, type: 'response', status: 'error', error, error_code, request };
+    }
+    const delay = this.options.latencyMs + (Math.random() * 2 - 1) * this.options.jitterMs;
+    setTimeout(() => socket.send(JSON.stringify(response)), Math.max(0, delay));
+  }
+
+  private closeLedger() {
+    this.ledgerIndex++;
+    this.closeTime = rippleTime();
+    this.ledgerHash = this.hashLedger();
+    this.closed = this.open.snapshot();
+    const validated = this.pending;
+    this.pending = [];
+    this.send(this.ledgerSubscribers, {
+      type: 'ledgerClosed',
+      ...this.ledgerFees(),
+      ledger_hash: this.ledgerHash,
+      ledger_index: this.ledgerIndex,
+      ledger_time: this.closeTime,
+      txn_count: validated.length,
+      validated_ledgers: `${this.firstLedgerIndex}-${this.ledgerIndex}`,
+      network_id: this.options.networkId,
+    });
+    validated.forEach((applied) => {
+      this.transactions.set(applied.hash, { applied, ledgerIndex: this.ledgerIndex });
+      this.send(this.transactionSubscribers, {
+        type: 'transaction',
+        ...this.engineResult(applied.engineResult),
+        ledger_hash: this.ledgerHash,
+        ledger_index: this.ledgerIndex,
+        meta: applied.meta,
+        transaction: applied.tx,
+        validated: true,
+      });
+    });
+  }
+
+  private send(sockets: Set<any>, event: Record<string, any>) {
+    const message = JSON.stringify(event);
+    sockets.forEach((socket) => socket.send(message));
+  }
+
+  private hashLedger(): string {
+    return sha512Half(Buffer.from(`${this.ledgerIndex}:${this.closeTime}`));
+  }
+
+  private ledgerFees() {
+    return {
+      fee_base: this.options.baseFee,
+      fee_ref: this.options.baseFee,
+      reserve_base: this.options.reserveBase,
+      reserve_inc: this.options.reserveIncrement,
+    };
+  }
+
+  private engineResult(engineResult: string) {
+    return {
+      engine_result: engineResult,
+      engine_result_code: ENGINE_RESULT_CODES[engineResult],
+      engine_result_message:
+        engineResult === 'tesSUCCESS' ? 'The transaction was applied. Only final in a validated ledger.' : engineResult,
+    };
+  }
+
+  // ledger_index 'current' (the default) reads the open ledger, anything else the last closed one
+  private select(request: Record<string, any>): { ledger: SimulatedLedger; fields: Record<string, any> } {
+    if (request.ledger_index === undefined || request.ledger_index === 'current') {
+      return { ledger: this.open, fields: { ledger_current_index: this.ledgerIndex + 1 } };
+    }
+    return {
+      ledger: this.closed,
+      fields: { ledger_hash: this.ledgerHash, ledger_index: this.ledgerIndex, validated: true },
+    };
+  }
+
+  private serverInfo() {
+    return {
+      info: {
+        build_version: BUILD_VERSION,
+        complete_ledgers: `${this.firstLedgerIndex}-${this.ledgerIndex}`,
+        load_factor: 1,
+        network_id: this.options.networkId,
+        server_state: 'full',
+        validated_ledger: {
+          age: Math.max(0, rippleTime() - this.closeTime),
+          base_fee_xrp: this.options.baseFee / 1e6,
+          hash: this.ledgerHash,
+          reserve_base_xrp: this.options.reserveBase / 1e6,
+          reserve_inc_xrp: this.options.reserveIncrement / 1e6,
+          seq: this.ledgerIndex,
+        },
+      },
+    };
+  }
+
+  private fee() {
+    const baseFee = String(this.options.baseFee);
+    return {
+      current_ledger_size: String(this.pending.length),
+      current_queue_size: '0',
+      drops: { base_fee: baseFee, median_fee: baseFee, minimum_fee: baseFee, open_ledger_fee: baseFee },
+      expected_ledger_size: '1000',
+      ledger_current_index: this.ledgerIndex + 1,
+      levels: { median_level: '256', minimum_level: '256', open_ledger_level: '256', reference_level: '256' },
+      max_queue_size: '2000',
+    };
+  }
+
+  private ledger(request: Record<string, any>) {
+    if (request.ledger_index === 'current') {
+      return { ledger_current_index: this.ledgerIndex + 1 };
+    }
+    return {
+      ledger_hash: this.ledgerHash,
+      ledger_index: this.ledgerIndex,
+      validated: true,
+      ledger: {
+        base_fee: this.options.baseFee,
+        close_time: this.closeTime,
+        closed: true,
+        ledger_hash: this.ledgerHash,
+        ledger_index: String(this.ledgerIndex),
+      },
+    };
+  }
+
+  private subscribe(request: Record<string, any>, socket) {
+    const streams: string[] = request.streams ?? [];
+    if (streams.includes('transactions')) {
+      this.transactionSubscribers.add(socket);
+    }
+    if (!streams.includes('ledger')) {
+      return {};
+    }
+    this.ledgerSubscribers.add(socket);
+    return {
+      ...this.ledgerFees(),
+      ledger_hash: this.ledgerHash,
+      ledger_index: this.ledgerIndex,
+      ledger_time: this.closeTime,
+      network_id: this.options.networkId,
+      validated_ledgers: `${this.firstLedgerIndex}-${this.ledgerIndex}`,
+    };
+  }
+
+  private unsubscribe(request: Record<string, any>, socket) {
+    const streams: string[] = request.streams ?? [];
+    if (streams.includes('transactions')) {
+      this.transactionSubscribers.delete(socket);
+    }
+    if (streams.includes('ledger')) {
+      this.ledgerSubscribers.delete(socket);
+    }
+    return {};
+  }
+
+  private accountInfo(request: Record<string, any>) {
+    const { ledger, fields } = this.select(request);
+    const account = ledger.getAccount(request.account);
+    if (!account) {
+      throw new RippledError('actNotFound', 19);
+    }
+    return { account_data: account, ...fields };
+  }
+
+  private accountObjects(request: Record<string, any>) {
+    const { ledger, fields } = this.select(request);
+    if (!ledger.getAccount(request.account)) {
+      throw new RippledError('actNotFound', 19);
+    }
+    const type = ACCOUNT_OBJECT_TYPES[request.type];
+    const objects = ledger
+      .ownedObjects(request.account)
+      .filter((object) => !request.type || object.LedgerEntryType === type);
+    const page = paginate(objects, request);
+    return { account: request.account, account_objects: page.entries, ...page.marker, ...fields };
+  }
+
+  private accountNamespace(request: Record<string, any>) {
+    const { ledger, fields } = this.select(request);
+    if (!ledger.getAccount(request.account)) {
+      throw new RippledError('actNotFound', 19);
+    }
+    const page = paginate(ledger.namespaceEntries(request.account, request.namespace_id), request);
+    return {
+      account: request.account,
+      namespace_entries: page.entries,
+      namespace_id: request.namespace_id,
+      ...page.marker,
+      ...fields,
+    };
+  }
+
+  private ledgerEntry(request: Record<string, any>) {
+    const { ledger, fields } = this.select(request);
+    const index = this.ledgerEntryIndex(request);
+    const node = index && (ledger.read(index) ?? ledger.findHookState(index));
+    if (!node) {
+      throw new RippledError('entryNotFound', 21);
+    }
+    return { index, node, ...fields };
+  }
+
+  private ledgerEntryIndex(request: Record<string, any>): string | undefined {
+    if (request.index) {
+      return request.index;
+    }
+    if (request.account_root) {
+      return accountKeylet(request.account_root);
+    }
+    if (request.hook) {
+      return hookKeylet(typeof request.hook === 'string' ? request.hook : request.hook.account);
+    }
+    if (request.hook_definition) {
+      return hookDefinitionKeylet(request.hook_definition);
+    }
+  }
+
+  private submit(request: Record<string, any>) {
+    const applied = this.engine.apply(this.open, request.tx_blob, {
+      ledgerIndex: this.ledgerIndex + 1,
+      lastCloseTime: this.closeTime,
+      transactionIndex: this.pending.length,
+    });
+    if (applied.applied) {
+      this.pending.push(applied);
+      this.transactions.set(applied.hash, { applied });
+      if (this.transactions.size > MAX_KEPT_TRANSACTIONS) {
+        this.transactions.delete(this.transactions.keys().next().value);
+      }
+    }
+    return {
+      accepted: applied.applied,
+      applied: applied.applied,
+      broadcast: applied.applied,
+      ...this.engineResult(applied.engineResult),
+      kept: applied.applied,
+      queued: false,
+      tx_blob: request.tx_blob,
+      tx_json: applied.tx,
+    };
+  }
+
+  private tx(request: Record<string, any>) {
+    const entry = this.transactions.get(request.transaction);
+    if (!entry) {
+      throw new RippledError('txnNotFound', 29);
+    }
+    const { applied, ledgerIndex } = entry;
+    return {
+      ...applied.tx,
+      ...(ledgerIndex !== undefined && { ledger_index: ledgerIndex, meta: applied.meta }),
+      validated: ledgerIndex !== undefined,
+    };
+  }
+}
+
+function paginate(entries: LedgerObject[], request: Record<string, any>) {
+  const start = request.marker ? parseInt(request.marker) : 0;
+  const limit = request.limit ?? DEFAULT_PAGE_LIMIT;
+  const end = start + limit;
+  return { entries: entries.slice(start, end), marker: end < entries.length ? { marker: String(end) } : {} };
+}
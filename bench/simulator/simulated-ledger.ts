@@ -0,0 +1,253 @@
+import { accountKeylet, hookKeylet, hookStateKeylet } from '../../src/xrpl/keylet/keylet.utils';
+
+export type LedgerObject = Record<string, any> & { LedgerEntryType: string; index: string };
+
+export interface ILedgerReader {
+  read(index: string): LedgerObject | undefined;
+  readState(account: string, namespace: string, key: string): string | undefined;
+  stateKeys(account: string, namespace: string): string[];
+}
+
+// fields kept out of the NewFields, FinalFields and PreviousFields of metadata nodes
+const NODE_HEADER_FIELDS = ['LedgerEntryType', 'index', 'PreviousTxnID', 'PreviousTxnLgrSeq'];
+
+const stateOwner = (account: string, namespace: string) => `${account}:${namespace}`;
+
+/**
+ * Ledger objects by index and hook state entries by account and namespace. Objects and namespaces are
+ * replaced on change and never mutated in place, so closing a ledger only copies the top-level maps.
+ */
+export class SimulatedLedger implements ILedgerReader {
+  constructor(
+    private readonly objects = new Map<string, LedgerObject>(),
+    private readonly hookState = new Map<string, Map<string, string>>()
+  ) {}
+
+  snapshot(): SimulatedLedger {
+    return new SimulatedLedger(new Map(this.objects), new Map(this.hookState));
+  }
+
+  read(index: string): LedgerObject | undefined {
+    return this.objects.get(index);
+  }
+
+  readState(account: string, namespace: string, key: string): string | undefined {
+    return this.hookState.get(stateOwner(account, namespace))?.get(key);
+  }
+
+  stateKeys(account: string, namespace: string): string[] {
+    return [...(this.hookState.get(stateOwner(account, namespace))?.keys() ?? [])];
+  }
+
+  getAccount(address: string): LedgerObject | undefined {
+    return this.objects.get(accountKeylet(address));
+  }
+
+  getHook(address: string): LedgerObject | undefined {
+    return this.objects.get(hookKeylet(address));
+  }
+
+  ownedObjects(address: string): LedgerObject[] {
+    return [...this.objects.values()].filter(
+      (object) =>
+        object.Owner === address || (object.LedgerEntryType !== 'AccountRoot' && object.Account === address)
+    );
+  }
+
+  namespaceEntries(account: string, namespace: string): LedgerObject[] {
+    return [...(this.hookState.get(stateOwner(account, namespace)) ?? [])].map(([key, data]) =>
+      hookStateObject(account, namespace, key, data)
+    );
+  }
+
+  findHookState(index: string): LedgerObject | undefined {
+    for (const [owner, entries] of this.hookState) {
+      const [account, namespace] = owner.split(':');
+      for (const [key, data] of entries) {
+        if (hookStateKeylet(account, key, namespace) === index) {
+          return hookStateObject(account, namespace, key, data);
+        }
+      }
+    }
+  }
+
+  put(object: LedgerObject) {
+    this.objects.set(object.index, object);
+  }
+
+  remove(index: string) {
+    this.objects.delete(index);
+  }
+
+  putState(account: string, namespace: string, key: string, data: string | undefined) {
+    const owner = stateOwner(account, namespace);
+    const entries = new Map(this.hookState.get(owner));
+    if (data === undefined) {
+      entries.delete(key);
+    } else {
+      entries.set(key, data);
+    }
+    if (entries.size === 0) {
+      this.hookState.delete(owner);
+    } else {
+      this.hookState.set(owner, entries);
+    }
+  }
+}
+
+/**
+ * Changes of one transaction staged over the ledger, or over another view for changes that are discarded
+ * on their own (the effects of a transaction whose fee is claimed anyway). Committing the outermost view
+ * writes the changes into the ledger and describes them as metadata AffectedNodes.
+ */
+export class LedgerView implements ILedgerReader {
+  private readonly changes = new Map<string, LedgerObject | undefined>();
+  private readonly stateChanges = new Map<string, Map<string, string | undefined>>();
+
+  constructor(private readonly parent: ILedgerReader) {}
+
+  read(index: string): LedgerObject | undefined {
+    return this.changes.has(index) ? this.changes.get(index) : this.parent.read(index);
+  }
+
+  readState(account: string, namespace: string, key: string): string | undefined {
+    const staged = this.stateChanges.get(stateOwner(account, namespace));
+    return staged?.has(key) ? staged.get(key) : this.parent.readState(account, namespace, key);
+  }
+
+  stateKeys(account: string, namespace: string): string[] {
+    const keys = new Set(this.parent.stateKeys(account, namespace));
+    this.stateChanges
+      .get(stateOwner(account, namespace))
+      ?.forEach((data, key) => (data === undefined ? keys.delete(key) : keys.add(key)));
+    return [...keys];
+  }
+
+  write(object: LedgerObject) {
+    this.changes.set(object.index, object);
+  }
+
+  erase(index: string) {
+    this.changes.set(index, undefined);
+  }
+
+  /**
+   * Hook state entries count towards HookStateCount of their account, whose HookNamespaces lists every
+   * namespace holding at least one entry.
+   */
+  setState(account: string, namespace: string, key: string, data: string | undefined) {
+    const existed = this.readState(account, namespace, key) !== undefined;
+    const owner = stateOwner(account, namespace);
+    this.stateChanges.set(owner, new Map(this.stateChanges.get(owner)).set(key, data));
+    const exists = data !== undefined;
+    const accountRoot = this.read(accountKeylet(account));
+    if (existed === exists || !accountRoot) {
+      return;
+    }
+    const namespaces = new Set<string>(accountRoot.HookNamespaces ?? []);
+    if (this.stateKeys(account, namespace).length > 0) {
+      namespaces.add(namespace);
+    } else {
+      namespaces.delete(namespace);
+    }
+    const { HookNamespaces, HookStateCount, ...fields } = accountRoot;
+    const count = (HookStateCount ?? 0) + (exists ? 1 : -1);
+    this.write({
+      ...fields,
+      ...(namespaces.size > 0 && { HookNamespaces: [...namespaces] }),
+      ...(count > 0 && { HookStateCount: count }),
+    } as LedgerObject);
+  }
+
+  deleteNamespace(account: string, namespace: string) {
+    this.stateKeys(account, namespace).forEach((key) => this.setState(account, namespace, key, undefined));
+  }
+
+  mergeInto(target: LedgerView) {
+    this.changes.forEach((object, index) => target.changes.set(index, object));
+    this.stateChanges.forEach((entries, owner) =>
+      target.stateChanges.set(owner, new Map([...(target.stateChanges.get(owner) ?? []), ...entries]))
+    );
+  }
+
+  commit(ledger: SimulatedLedger, txHash: string, ledgerIndex: number): Array<Record<string, any>> {
+    const nodes: Array<Record<string, any>> = [];
+    this.changes.forEach((object, index) => {
+      const before = ledger.read(index);
+      if (object === undefined) {
+        if (before) {
+          ledger.remove(index);
+          nodes.push(deletedNode(before));
+        }
+        return;
+      }
+      const after = { ...object, PreviousTxnID: txHash, PreviousTxnLgrSeq: ledgerIndex };
+      ledger.put(after);
+      nodes.push(before ? modifiedNode(before, after) : createdNode(after));
+    });
+    this.stateChanges.forEach((entries, owner) => {
+      const [account, namespace] = owner.split(':');
+      entries.forEach((data, key) => {
+        const previous = ledger.readState(account, namespace, key);
+        if (previous === data) {
+          return;
+        }
+        ledger.putState(account, namespace, key, data);
+        const before = previous !== undefined && hookStateObject(account, namespace, key, previous);
+        const after = data !== undefined && hookStateObject(account, namespace, key, data);
+        nodes.push(!after ? deletedNode(before) : before ? modifiedNode(before, after) : createdNode(after));
+      });
+    });
+    return nodes;
+  }
+}
+
+function hookStateObject(account: string, namespace: string, key: string, data: string): LedgerObject {
+  return {
+    Flags: 0,
+    HookStateData: data,
+    HookStateKey: key,
+    LedgerEntryType: 'HookState',
+    OwnerNode: '0',
+    index: hookStateKeylet(account, key, namespace),
+  };
+}
+
+function fieldsOf(object: LedgerObject): Record<string, any> {
+  return Object.fromEntries(Object.entries(object).filter(([name]) => !NODE_HEADER_FIELDS.includes(name)));
+}
+
+function createdNode(object: LedgerObject) {
+  return {
+    CreatedNode: { LedgerEntryType: object.LedgerEntryType, LedgerIndex: object.index, NewFields: fieldsOf(object) },
+  };
+}
+
+function deletedNode(object: LedgerObject) {
+  return {
+    DeletedNode: { LedgerEntryType: object.LedgerEntryType, LedgerIndex: object.index, FinalFields: fieldsOf(object) },
+  };
+}
+
+// PreviousFields holds the prior value of every field that changed, fields removed included
+function modifiedNode(before: LedgerObject, after: LedgerObject) {
+  const previous = fieldsOf(before);
+  const final = fieldsOf(after);
+  const names = new Set([...Object.keys(previous), ...Object.keys(final)]);
+  const previousFields = Object.fromEntries(
+    [...names]
+      .filter((name) => JSON.stringify(previous[name]) !== JSON.stringify(final[name]))
+      .filter((name) => previous[name] !== undefined)
+      .map((name) => [name, previous[name]])
+  );
+  return {
+    ModifiedNode: {
+      LedgerEntryType: after.LedgerEntryType,
+      LedgerIndex: after.index,
+      FinalFields: final,
+      PreviousFields: previousFields,
+      ...(before.PreviousTxnID && { PreviousTxnID: before.PreviousTxnID }),
+      ...(before.PreviousTxnLgrSeq && { PreviousTxnLgrSeq: before.PreviousTxnLgrSeq }),
+    },
+  };
+}
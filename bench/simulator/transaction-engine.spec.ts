@@ -0,0 +1,146 @@
+import { encode } from '@transia/ripple-binary-codec';
+import { HookTransactionFactory } from '../../src/hooks/hook.factory';
+import { SetHookType } from '../../src/hooks/hook.constants';
+import { getForeignAccountTxParams, getRentalContextHookParams } from '../../src/rentals/rental.utils';
+import { accountKeylet, uriTokenKeylet } from '../../src/xrpl/keylet/keylet.utils';
+import { TEST_ADDRESS_ALICE, TEST_ADDRESS_BOB, TEST_HOOK_NS, TEST_TOKEN_URI } from '../../src/test-utils/test-utils';
+import { HookVm } from './hook-vm';
+import { SimulatedLedger } from './simulated-ledger';
+import { IAppliedTransaction, TransactionEngine } from './transaction-engine';
+
+const NETWORK = { networkId: 21338, baseFee: 10, reserveBase: 1000000 };
+const RIPPLE_EPOCH_OFFSET = 946684800;
+const DAY_IN_MS = 24 * 60 * 60 * 1000;
+const RENTER_HOOK_NS = 'A'.repeat(64);
+
+// the engine runs the hook build the service installs, so these cases follow contracts/rental_state_hook.c
+describe('TransactionEngine unit spec', () => {
+  let ledger: SimulatedLedger;
+  let engine: TransactionEngine;
+  let ledgerIndex: number;
+  const lender = TEST_ADDRESS_ALICE;
+  const renter = TEST_ADDRESS_BOB;
+  const tokenID = uriTokenKeylet(lender, TEST_TOKEN_URI);
+
+  beforeEach(() => {
+    ledger = new SimulatedLedger();
+    engine = new TransactionEngine(new HookVm(), NETWORK);
+    ledgerIndex = 10;
+    [lender, renter].forEach((account) => ledger.put(accountRoot(account)));
+  });
+
+  test('should save the rental deadline in the hook state once a START sell offer is bought', () => {
+    //given: both accounts run the rental hook and the lender holds a URIToken
+    installRentalHook(lender, TEST_HOOK_NS);
+    installRentalHook(renter, RENTER_HOOK_NS);
+    expect(submit({ TransactionType: 'URITokenMint', Account: lender, URI: TEST_TOKEN_URI, Flags: 1 })).toMatchObject({
+      engineResult: 'tesSUCCESS',
+    });
+    const deadline = new Date(Date.now() + 3 * DAY_IN_MS).toISOString();
+    //when: the lender offers the token for the rental and the renter buys the offer
+    const startOffer = submit({
+      TransactionType: 'URITokenCreateSellOffer',
+      Account: lender,
+      URITokenID: tokenID,
+      Amount: '5000000',
+      Destination: renter,
+      HookParameters: [
+        ...getRentalContextHookParams({ deadline, totalAmount: 5 }),
+        ...getForeignAccountTxParams(renter, RENTER_HOOK_NS),
+      ],
+    });
+    const buy = submit({
+      TransactionType: 'URITokenBuy',
+      Account: renter,
+      URITokenID: tokenID,
+      Amount: '5000000',
+      HookParameters: getRentalContextHookParams({ deadline, totalAmount: 0 }),
+    });
+    //then: both are applied and the deadline is kept under the URITokenID key of the renter namespace
+    expect(startOffer).toMatchObject({ engineResult: 'tesSUCCESS', applied: true });
+    expect(buy).toMatchObject({ engineResult: 'tesSUCCESS', applied: true });
+    expect(ledger.read(tokenID)).toMatchObject({ Owner: renter });
+    expect(ledger.readState(renter, RENTER_HOOK_NS, tokenID)).toBeDefined();
+    expect(buy.meta.AffectedNodes).toContainEqual({
+      CreatedNode: expect.objectContaining({ LedgerEntryType: 'HookState' }),
+    });
+  });
+
+  test('should roll back a START sell offer whose deadline has passed and claim only the fee', () => {
+    //given: the lender runs the rental hook and holds a URIToken
+    installRentalHook(lender, TEST_HOOK_NS);
+    submit({ TransactionType: 'URITokenMint', Account: lender, URI: TEST_TOKEN_URI, Flags: 1 });
+    const balance = BigInt(ledger.getAccount(lender).Balance);
+    //when: offering the token with a deadline an hour ago
+    const result = submit({
+      TransactionType: 'URITokenCreateSellOffer',
+      Account: lender,
+      URITokenID: tokenID,
+      Amount: '5000000',
+      Destination: renter,
+      HookParameters: [
+        ...getRentalContextHookParams({ deadline: new Date(Date.now() - 3600000).toISOString(), totalAmount: 5 }),
+        ...getForeignAccountTxParams(renter, RENTER_HOOK_NS),
+      ],
+    });
+    //then: the hook rolls the offer back, leaving the token without an offer and the fee claimed
+    expect(result).toMatchObject({ engineResult: 'tecHOOK_REJECTED', applied: true });
+    expect(result.meta.HookExecutions).toHaveLength(1);
+    expect(ledger.read(tokenID).Amount).toBeUndefined();
+    expect(BigInt(ledger.getAccount(lender).Balance)).toEqual(balance - 12n);
+    expect(ledger.getAccount(lender).Sequence).toEqual(4);
+  });
+
+  test.each([
+    [-1, 'tefPAST_SEQ'],
+    [1, 'terPRE_SEQ'],
+  ])('should not apply a transaction whose Sequence is off by %d', (offset, engineResult) => {
+    //given: a payment with a Sequence other than the one of the account
+    const tx = {
+      TransactionType: 'Payment',
+      Account: lender,
+      Destination: renter,
+      Amount: '1000000',
+      Sequence: ledger.getAccount(lender).Sequence + offset,
+    };
+    //when: applying it
+    const result = submit(tx);
+    //then: it is rejected before the fee is claimed and the ledger is left as it was
+    expect(result).toMatchObject({ engineResult, applied: false });
+    expect(result.meta).toBeUndefined();
+    expect(ledger.getAccount(lender)).toEqual(accountRoot(lender));
+  });
+
+  // applies the transaction to a new open ledger, filling the common fields like the service does
+  function submit(tx: Record<string, any>): IAppliedTransaction {
+    const txBlob = encode({
+      NetworkID: NETWORK.networkId,
+      Fee: '12',
+      Sequence: ledger.getAccount(tx.Account).Sequence,
+      SigningPubKey: '',
+      ...tx,
+    } as any);
+    return engine.apply(ledger, txBlob, {
+      ledgerIndex: ++ledgerIndex,
+      lastCloseTime: Math.floor(Date.now() / 1000) - RIPPLE_EPOCH_OFFSET,
+      transactionIndex: 0,
+    });
+  }
+
+  function installRentalHook(account: string, hookNamespace: string) {
+    const setHookTx = HookTransactionFactory.prepareSetHookTx({ type: SetHookType.INSTALL, account, hookNamespace });
+    expect(submit(setHookTx)).toMatchObject({ engineResult: 'tesSUCCESS', applied: true });
+  }
+});
+
+function accountRoot(account: string) {
+  return {
+    Account: account,
+    Balance: '100000000000',
+    Flags: 0,
+    LedgerEntryType: 'AccountRoot',
+    OwnerCount: 0,
+    Sequence: 1,
+    index: accountKeylet(account),
+  };
+}
@@ -0,0 +1,525 @@
+import { decode } from '@transia/ripple-binary-codec';
+import { Field, TransactionType } from '@transia/ripple-binary-codec/dist/enums';
+import { AccountID, coreTypes } from '@transia/ripple-binary-codec/dist/types';
+import { SetHookFlags } from '@transia/xrpl';
+import {
+  accountKeylet,
+  hookDefinitionKeylet,
+  hookKeylet,
+  sha512Half,
+  uriTokenKeylet,
+} from '../../src/xrpl/keylet/keylet.utils';
+import { HookExitType, HookVm, IHookExecution } from './hook-vm';
+import { LedgerObject, LedgerView, SimulatedLedger } from './simulated-ledger';
+
+// engine_result_code of the results the simulator produces
+export const ENGINE_RESULT_CODES: Record<string, number> = {
+  tesSUCCESS: 0,
+  tecUNFUNDED_PAYMENT: 104,
+  tecNO_DST: 124,
+  tecNO_DST_INSUF_XRP: 125,
+  tecNO_LINE: 135,
+  tecNO_PERMISSION: 139,
+  tecNO_ENTRY: 140,
+  tecDUPLICATE: 149,
+  tecHAS_OBLIGATIONS: 151,
+  tecHOOK_REJECTED: 153,
+  tecREQUIRES_FLAG: 154,
+  tecINSUFFICIENT_PAYMENT: 161,
+  tefPAST_SEQ: -190,
+  tefMAX_LEDGER: -186,
+  telINSUF_FEE_P: -394,
+  telWRONG_NETWORK: -386,
+  temMALFORMED: -299,
+  temBAD_AMOUNT: -298,
+  terINSUF_FEE_B: -97,
+  terNO_ACCOUNT: -96,
+  terPRE_SEQ: -92,
+};
+
+const TX_HASH_PREFIX = Buffer.from('54584E00', 'hex');
+const TF_BURNABLE = 0x00000001;
+const LEGACY_NETWORK_ID_MAX = 1024;
+const ZERO_NAMESPACE = '0'.repeat(64);
+
+export interface ITransactionEngineOptions {
+  networkId: number;
+  baseFee: number;
+  reserveBase: number;
+}
+
+export interface IApplyContext {
+  // index of the open ledger the transaction is applied to
+  ledgerIndex: number;
+  // close time of the last closed ledger, in seconds since the ripple epoch
+  lastCloseTime: number;
+  transactionIndex: number;
+}
+
+export interface IAppliedTransaction {
+  tx: Record<string, any>;
+  hash: string;
+  engineResult: string;
+  // whether the transaction is part of the open ledger, with its fee claimed
+  applied: boolean;
+  meta?: Record<string, any>;
+}
+
+interface IStakeholderExecution {
+  account: string;
+  namespace: string;
+  hookHash: string;
+  execution: IHookExecution;
+}
+
+type TransactionHandler = (view: LedgerView, tx: Record<string, any>, context: IApplyContext) => string;
+
+// field ordinal as passed to otxn_field ((type << 16) + nth) to its definition
+const FIELDS_BY_ORDINAL = new Map<number, any>(
+  Object.values(Field)
+    .filter((field: any) => field?.name && field?.type)
+    .map((field: any) => [field.ordinal, field])
+);
+
+/**
+ * Applies signed transactions to the open ledger the way xahaud does for the transaction types the service
+ * submits: fee and Sequence are claimed first, the hooks of the accounts the transaction touches run before
+ * its effects are kept, and a rollback of any of them leaves only the claimed fee (tecHOOK_REJECTED).
+ * Signatures are not verified.
+ */
+export class TransactionEngine {
+  private readonly handlers: Record<string, TransactionHandler> = {
+    Payment: (view, tx, context) => this.applyPayment(view, tx, context),
+    URITokenMint: (view, tx) => this.applyURITokenMint(view, tx),
+    URITokenBurn: (view, tx) => this.applyURITokenBurn(view, tx),
+    URITokenCreateSellOffer: (view, tx) => this.applyURITokenCreateSellOffer(view, tx),
+    URITokenCancelSellOffer: (view, tx) => this.applyURITokenCancelSellOffer(view, tx),
+    URITokenBuy: (view, tx) => this.applyURITokenBuy(view, tx),
+    SetHook: (view, tx) => this.applySetHook(view, tx),
+    AccountDelete: (view, tx) => this.applyAccountDelete(view, tx),
+  };
+
+  constructor(
+    private readonly vm: HookVm,
+    private readonly options: ITransactionEngineOptions
+  ) {}
+
+  apply(ledger: SimulatedLedger, txBlob: string, context: IApplyContext): IAppliedTransaction {
+    let tx: Record<string, any>;
+    try {
+      tx = decode(txBlob);
+    } catch (err) {
+      return { tx: {}, hash: '', engineResult: 'temMALFORMED', applied: false };
+    }
+    const hash = sha512Half(TX_HASH_PREFIX, Buffer.from(txBlob, 'hex'));
+    tx.hash = hash;
+    const rejection = this.check(ledger, tx, context);
+    if (rejection) {
+      return { tx, hash, engineResult: rejection, applied: false };
+    }
+
+    const view = new LedgerView(ledger);
+    const account = view.read(accountKeylet(tx.Account));
+    view.write({
+      ...account,
+      Balance: (BigInt(account.Balance) - BigInt(tx.Fee)).toString(),
+      Sequence: account.Sequence + 1,
+    });
+    const effects = new LedgerView(view);
+    const handler = this.handlers[tx.TransactionType];
+    let engineResult = handler ? handler(effects, tx, context) : 'tesSUCCESS';
+    const executions = engineResult === 'tesSUCCESS' ? this.runHooks(ledger, tx, context) : [];
+    if (executions.some(({ execution }) => execution.exitType !== HookExitType.ACCEPT)) {
+      engineResult = 'tecHOOK_REJECTED';
+    }
+    if (engineResult === 'tesSUCCESS') {
+      executions.forEach(({ account, namespace, execution }) =>
+        execution.stateChanges.forEach((data, key) =>
+          effects.setState(account, namespace, key, data?.toString('hex').toUpperCase())
+        )
+      );
+      effects.mergeInto(view);
+    }
+    const meta = {
+      AffectedNodes: view.commit(ledger, hash, context.ledgerIndex),
+      TransactionIndex: context.transactionIndex,
+      TransactionResult: engineResult,
+      ...(executions.length > 0 && { HookExecutions: executions.map(hookExecutionNode) }),
+    };
+    return { tx, hash, engineResult, applied: true, meta };
+  }
+
+  // checks made before the fee is claimed, a transaction failing them never enters the ledger
+  private check(ledger: SimulatedLedger, tx: Record<string, any>, context: IApplyContext): string | undefined {
+    if (this.options.networkId > LEGACY_NETWORK_ID_MAX && tx.NetworkID !== this.options.networkId) {
+      return 'telWRONG_NETWORK';
+    }
+    if (['Amount', 'Fee'].some((field) => typeof tx[field] === 'string' && tx[field].startsWith('-'))) {
+      return 'temBAD_AMOUNT';
+    }
+    if (BigInt(tx.Fee ?? 0) < BigInt(this.options.baseFee)) {
+      return 'telINSUF_FEE_P';
+    }
+    const account = ledger.getAccount(tx.Account);
+    if (!account) {
+      return 'terNO_ACCOUNT';
+    }
+    if (tx.LastLedgerSequence !== undefined && tx.LastLedgerSequence < context.ledgerIndex) {
+      return 'tefMAX_LEDGER';
+    }
+    if (tx.Sequence < account.Sequence) {
+      return 'tefPAST_SEQ';
+    }
+    if (tx.Sequence > account.Sequence) {
+      return 'terPRE_SEQ';
+    }
+    if (BigInt(account.Balance) < BigInt(tx.Fee)) {
+      return 'terINSUF_FEE_B';
+    }
+  }
+
+  /**
+   * Hooks of the originating account run first, then those of the other stakeholders: the Destination of
+   * payments and sell offers and the seller of a bought URIToken. Execution stops at the first rejection.
+   */
+  private runHooks(ledger: SimulatedLedger, tx: Record<string, any>, context: IApplyContext): IStakeholderExecution[] {
+    const stakeholders = new Set<string>([tx.Account]);
+    if (['Payment', 'AccountDelete', 'URITokenCreateSellOffer'].includes(tx.TransactionType) && tx.Destination) {
+      stakeholders.add(tx.Destination);
+    }
+    if (tx.TransactionType === 'URITokenBuy') {
+      const owner = ledger.read(tx.URITokenID)?.Owner;
+      if (owner) {
+        stakeholders.add(owner);
+      }
+    }
+    const txType = TransactionType.from(tx.TransactionType).ordinal;
+    const executions: IStakeholderExecution[] = [];
+    for (const account of stakeholders) {
+      for (const { Hook: hook } of ledger.getHook(account)?.Hooks ?? []) {
+        const definition = hook.HookHash && ledger.read(hookDefinitionKeylet(hook.HookHash));
+        if (!definition || !isTriggered(hook.HookOn ?? definition.HookOn, txType)) {
+          continue;
+        }
+        const namespace = hook.HookNamespace ?? definition.HookNamespace ?? ZERO_NAMESPACE;
+        const execution = this.vm.run(hook.HookHash, Buffer.from(definition.CreateCode, 'hex'), {
+          hookAccount: accountIdBytes(account),
+          namespace: Buffer.from(namespace, 'hex'),
+          otxnType: txType,
+          ledgerLastTime: context.lastCloseTime,
+          otxnField: (fieldId) => serializeField(tx, fieldId),
+          otxnParam: (name) => hookParameter(tx, name),
+          readState: (stateAccount, stateNamespace, key) => {
+            const data = ledger.readState(
+              encodeAccountId(stateAccount),
+              stateNamespace.toString('hex').toUpperCase(),
+              key.toString('hex').toUpperCase()
+            );
+            return data === undefined ? undefined : Buffer.from(data, 'hex');
+          },
+        });
+        executions.push({ account, namespace, hookHash: hook.HookHash, execution });
+        if (execution.exitType !== HookExitType.ACCEPT) {
+          return executions;
+        }
+      }
+    }
+    return executions;
+  }
+
+  private applyPayment(view: LedgerView, tx: Record<string, any>, context: IApplyContext): string {
+    if (typeof tx.Amount !== 'string') {
+      return 'tecNO_LINE';
+    }
+    const amount = BigInt(tx.Amount);
+    const destination = view.read(accountKeylet(tx.Destination));
+    if (!destination && amount < BigInt(this.options.reserveBase)) {
+      return 'tecNO_DST_INSUF_XRP';
+    }
+    if (!this.debit(view, tx.Account, amount)) {
+      return 'tecUNFUNDED_PAYMENT';
+    }
+    view.write(
+      destination
+        ? { ...destination, Balance: (BigInt(destination.Balance) + amount).toString() }
+        : {
+            Account: tx.Destination,
+            Balance: amount.toString(),
+            Flags: 0,
+            LedgerEntryType: 'AccountRoot',
+            OwnerCount: 0,
+            Sequence: context.ledgerIndex,
+            index: accountKeylet(tx.Destination),
+          }
+    );
+    return 'tesSUCCESS';
+  }
+
+  private applyURITokenMint(view: LedgerView, tx: Record<string, any>): string {
+    const index = uriTokenKeylet(tx.Account, tx.URI);
+    if (view.read(index)) {
+      return 'tecDUPLICATE';
+    }
+    view.write({
+      Flags: (tx.Flags ?? 0) & TF_BURNABLE,
+      Issuer: tx.Account,
+      LedgerEntryType: 'URIToken',
+      Owner: tx.Account,
+      OwnerNode: '0',
+      URI: tx.URI,
+      ...(tx.Digest && { Digest: tx.Digest }),
+      ...(tx.Amount !== undefined && { Amount: tx.Amount }),
+      ...(tx.Destination && { Destination: tx.Destination }),
+      index,
+    });
+    this.adjustOwnerCount(view, tx.Account, 1);
+    return 'tesSUCCESS';
+  }
+
+  private applyURITokenBurn(view: LedgerView, tx: Record<string, any>): string {
+    const token = view.read(tx.URITokenID);
+    if (!token) {
+      return 'tecNO_ENTRY';
+    }
+    if (token.Owner !== tx.Account && !(token.Issuer === tx.Account && token.Flags & TF_BURNABLE)) {
+      return 'tecNO_PERMISSION';
+    }
+    view.erase(token.index);
+    this.adjustOwnerCount(view, token.Owner, -1);
+    return 'tesSUCCESS';
+  }
+
+  private applyURITokenCreateSellOffer(view: LedgerView, tx: Record<string, any>): string {
+    const token = view.read(tx.URITokenID);
+    if (!token) {
+      return 'tecNO_ENTRY';
+    }
+    if (token.Owner !== tx.Account) {
+      return 'tecNO_PERMISSION';
+    }
+    const { Destination, ...fields } = token;
+    view.write({ ...fields, Amount: tx.Amount, ...(tx.Destination && { Destination: tx.Destination }) });
+    return 'tesSUCCESS';
+  }
+
+  private applyURITokenCancelSellOffer(view: LedgerView, tx: Record<string, any>): string {
+    const token = view.read(tx.URITokenID);
+    if (!token) {
+      return 'tecNO_ENTRY';
+    }
+    if (token.Owner !== tx.Account || token.Amount === undefined) {
+      return 'tecNO_PERMISSION';
+    }
+    const { Amount, Destination, ...fields } = token;
+    view.write(fields as LedgerObject);
+    return 'tesSUCCESS';
+  }
+
+  private applyURITokenBuy(view: LedgerView, tx: Record<string, any>): string {
+    const token = view.read(tx.URITokenID);
+    if (!token) {
+      return 'tecNO_ENTRY';
+    }
+    if (token.Owner === tx.Account || token.Amount === undefined) {
+      return 'tecNO_PERMISSION';
+    }
+    if (token.Destination && token.Destination !== tx.Account) {
+      return 'tecNO_PERMISSION';
+    }
+    if (typeof tx.Amount !== 'string' || typeof token.Amount !== 'string') {
+      return 'tecNO_LINE';
+    }
+    if (BigInt(tx.Amount) < BigInt(token.Amount)) {
+      return 'tecINSUFFICIENT_PAYMENT';
+    }
+    if (!this.debit(view, tx.Account, BigInt(tx.Amount))) {
+      return 'tecUNFUNDED_PAYMENT';
+    }
+    const seller = view.read(accountKeylet(token.Owner));
+    view.write({ ...seller, Balance: (BigInt(seller.Balance) + BigInt(tx.Amount)).toString() });
+    const { Amount, Destination, ...fields } = token;
+    view.write({ ...fields, Owner: tx.Account } as LedgerObject);
+    this.adjustOwnerCount(view, token.Owner, -1);
+    this.adjustOwnerCount(view, tx.Account, 1);
+    return 'tesSUCCESS';
+  }
+
+  /**
+   * Each entry of Hooks updates the hook at the same position: CreateCode installs (replacing an existing
+   * hook requires hsfOverride), an empty CreateCode deletes, no CreateCode updates namespace and grants.
+   * hsfNSDelete clears the hook state kept under the namespace of the entry.
+   */
+  private applySetHook(view: LedgerView, tx: Record<string, any>): string {
+    const index = hookKeylet(tx.Account);
+    const existing = view.read(index);
+    const hooks: Array<Record<string, any>> = (existing?.Hooks ?? []).map(({ Hook }) => ({ ...Hook }));
+    for (const [position, { Hook: entry }] of (tx.Hooks ?? []).entries()) {
+      const current = hooks[position] ?? {};
+      const flags = entry.Flags ?? 0;
+      if (entry.CreateCode === undefined && Object.keys(entry).length === 0) {
+        continue;
+      }
+      if (flags & SetHookFlags.hsfNSDelete) {
+        view.deleteNamespace(tx.Account, entry.HookNamespace ?? current.HookNamespace ?? ZERO_NAMESPACE);
+      }
+      if (entry.CreateCode === '') {
+        if (!(flags & SetHookFlags.hsfOverride)) {
+          return 'tecREQUIRES_FLAG';
+        }
+        hooks[position] = {};
+        continue;
+      }
+      if (entry.CreateCode !== undefined) {
+        if (current.HookHash && !(flags & SetHookFlags.hsfOverride)) {
+          return 'tecREQUIRES_FLAG';
+        }
+        hooks[position] = this.installHook(view, tx.hash, entry);
+        continue;
+      }
+      if (!current.HookHash) {
+        return 'tecNO_ENTRY';
+      }
+      const { HookNamespace, HookGrants, HookOn, HookParameters } = entry;
+      hooks[position] = {
+        ...current,
+        ...(HookNamespace && { HookNamespace }),
+        ...(HookGrants && { HookGrants }),
+        ...(HookOn && { HookOn }),
+        ...(HookParameters && { HookParameters }),
+      };
+    }
+    while (hooks.length > 0 && !hooks[hooks.length - 1].HookHash) {
+      hooks.pop();
+    }
+    if (hooks.length === 0) {
+      if (existing) {
+        view.erase(index);
+        this.adjustOwnerCount(view, tx.Account, -1);
+      }
+      return 'tesSUCCESS';
+    }
+    view.write({
+      Account: tx.Account,
+      Flags: 0,
+      Hooks: hooks.map((hook) => ({ Hook: hook })),
+      LedgerEntryType: 'Hook',
+      OwnerNode: '0',
+      index,
+    });
+    if (!existing) {
+      this.adjustOwnerCount(view, tx.Account, 1);
+    }
+    return 'tesSUCCESS';
+  }
+
+  private installHook(view: LedgerView, txHash: string, entry: Record<string, any>) {
+    const hookHash = sha512Half(Buffer.from(entry.CreateCode, 'hex'));
+    const namespace = entry.HookNamespace ?? ZERO_NAMESPACE;
+    const definitionIndex = hookDefinitionKeylet(hookHash);
+    const definition = view.read(definitionIndex);
+    view.write(
+      definition
+        ? { ...definition, ReferenceCount: (BigInt(definition.ReferenceCount) + 1n).toString() }
+        : {
+            CreateCode: entry.CreateCode,
+            Fee: String(this.options.baseFee),
+            Flags: 0,
+            HookApiVersion: entry.HookApiVersion ?? 0,
+            HookHash: hookHash,
+            HookNamespace: namespace,
+            HookOn: entry.HookOn ?? ZERO_NAMESPACE,
+            HookSetTxnID: txHash,
+            LedgerEntryType: 'HookDefinition',
+            ReferenceCount: '1',
+            index: definitionIndex,
+          }
+    );
+    return {
+      HookHash: hookHash,
+      HookNamespace: namespace,
+      ...(entry.HookOn && { HookOn: entry.HookOn }),
+      ...(entry.HookGrants && { HookGrants: entry.HookGrants }),
+      ...(entry.HookParameters && { HookParameters: entry.HookParameters }),
+      ...(entry.Flags && { Flags: entry.Flags }),
+    };
+  }
+
+  private applyAccountDelete(view: LedgerView, tx: Record<string, any>): string {
+    const destination = view.read(accountKeylet(tx.Destination));
+    if (!destination) {
+      return 'tecNO_DST';
+    }
+    const account = view.read(accountKeylet(tx.Account));
+    if (account.OwnerCount > 0) {
+      return 'tecHAS_OBLIGATIONS';
+    }
+    view.write({ ...destination, Balance: (BigInt(destination.Balance) + BigInt(account.Balance)).toString() });
+    view.erase(account.index);
+    return 'tesSUCCESS';
+  }
+
+  private debit(view: LedgerView, address: string, amount: bigint): boolean {
+    const account = view.read(accountKeylet(address));
+    if (BigInt(account.Balance) < amount) {
+      return false;
+    }
+    view.write({ ...account, Balance: (BigInt(account.Balance) - amount).toString() });
+    return true;
+  }
+
+  private adjustOwnerCount(view: LedgerView, address: string, delta: number) {
+    const account = view.read(accountKeylet(address));
+    view.write({ ...account, OwnerCount: account.OwnerCount + delta });
+  }
+}
+
+// HookOn bits are inverted: a transaction type triggers the hook when its bit is clear, except SetHook
+function isTriggered(hookOn: string, txType: number): boolean {
+  const bit = (BigInt(`0x${hookOn || '0'}`) >> BigInt(txType)) & 1n;
+  return txType === TransactionType.from('SetHook').ordinal ? bit === 1n : bit === 0n;
+}
+
+function hookExecutionNode({ account, hookHash, execution }: IStakeholderExecution, index: number) {
+  return {
+    HookExecution: {
+      HookAccount: account,
+      HookEmitCount: 0,
+      HookExecutionIndex: index,
+      HookHash: hookHash,
+      HookInstructionCount: '0',
+      HookResult: execution.exitType,
+      HookReturnCode: hookReturnCode(execution.returnCode),
+      HookReturnString: Buffer.from(execution.returnString).toString('hex').toUpperCase(),
+      HookStateChangeCount: execution.stateChanges.size,
+    },
+  };
+}
+
+// negative return codes are reported with the sign in the high bit
+function hookReturnCode(code: bigint): string {
+  return (code < 0n ? (1n << 63n) - code : code).toString(16).toUpperCase();
+}
+
+function serializeField(tx: Record<string, any>, fieldId: number): Buffer | undefined {
+  const field = FIELDS_BY_ORDINAL.get(fieldId);
+  if (!field || tx[field.name] === undefined) {
+    return undefined;
+  }
+  return Buffer.from(coreTypes[field.type.name].from(tx[field.name]).toBytes());
+}
+
+function hookParameter(tx: Record<string, any>, name: Buffer): Buffer | undefined {
+  const hexName = name.toString('hex').toUpperCase();
+  const parameter = (tx.HookParameters ?? []).find(
+    ({ HookParameter }) => HookParameter.HookParameterName.toUpperCase() === hexName
+  );
+  return parameter && Buffer.from(parameter.HookParameter.HookParameterValue ?? '', 'hex');
+}
+
+function accountIdBytes(address: string): Buffer {
+  return Buffer.from(AccountID.from(address).toHex(), 'hex');
+}
+
+function encodeAccountId(accountId: Buffer): string {
+  return AccountID.from(accountId.toString('hex')).toJSON();
+}
@@ -48,6 +48,10 @@ describe('AccountController unit spec', () => {
       },
     } satisfies AccountInfoResponse),
     getAccountNamespace: jest.fn().mockResolvedValue(acountNamespace),
+    iterateAccountNamespace: jest.fn(async function* () {
+      yield { ...acountNamespace.result, marker: 'marker' };
+      yield acountNamespace.result;
+    }),
   };
 
   beforeEach(async () => {
@@ -78,4 +82,20 @@ describe('AccountController unit spec', () => {
       acountNamespace
     );
   });
+
+  test('should stream namespace entries of every page as NDJSON', async () => {
+    const chunks: string[] = [];
+    const res = {
+      setHeader: jest.fn(),
+      write: jest.fn((chunk: string) => chunks.push(chunk) > 0),
+      end: jest.fn((chunk: string) => chunks.push(chunk)),
+    };
+
+    await accountController.accountNamespaceEntries(TEST_ADDRESS_ALICE, TEST_HOOK_NS, res as any);
+
+    const entry = JSON.stringify(acountNamespace.result.namespace_entries[0]);
+    expect(res.setHeader).toBeCalledWith('Content-Type', 'application/x-ndjson');
+    expect(chunks.join('')).toEqual(`${entry}\n${entry}\n`);
+    expect(mockedXrplService.iterateAccountNamespace).toBeCalledWith(TEST_ADDRESS_ALICE, TEST_HOOK_NS, 256);
+  });
 });
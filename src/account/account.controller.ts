@@ -1,15 +1,20 @@
-import { Controller, Get, Param } from '@nestjs/common';
+import { Controller, Get, Param, Res } from '@nestjs/common';
+import { Response } from 'express';
 import { XrplService } from '../xrpl/client/client.service';
 import { AccountInfoOutputDto } from './interfaces/account.interface';
 import { AccountMapper } from './mapper/account.mapper';
-import { IHookNamespaceInfo } from '../xrpl/client/interfaces/namespace.interface';
+import { IHookNamespaceInfo, INamespaceEntry } from '../xrpl/client/interfaces/namespace.interface';
 import { AccountInfoRequest, AccountInfoResponse } from '@transia/xrpl';
+import { StreamFormat, streamJson } from '../common/stream.utils';
+import { ACCOUNT_NAMESPACE_PAGE_SIZE } from '../xrpl/client/client.constant';
+import { ConditionalGet } from '../common/conditional-get.interceptor';
 
 @Controller('account')
 export class AccountController {
   constructor(private readonly xrpl: XrplService) {}
 
   @Get(':num/info')
+  @ConditionalGet('num')
   async accountInfo(@Param('num') num: string): Promise<AccountInfoOutputDto> {
     const accountInfoReq: AccountInfoRequest = {
       command: 'account_info',
@@ -27,4 +32,23 @@ export class AccountController {
   ): Promise<IHookNamespaceInfo> {
     return await this.xrpl.getAccountNamespace(num, namespace);
   }
+
+  /**
+   * Streams the HookState entries of the namespace as NDJSON, one line per entry, reading account_namespace
+   * one page at a time; the next page is only requested once the socket has drained the previous one.
+   */
+  @Get(':num/namespace/:namespace/entries')
+  async accountNamespaceEntries(
+    @Param('num') num: string,
+    @Param('namespace') namespace: string,
+    @Res() res: Response
+  ): Promise<void> {
+    await streamJson(res, this.iterateNamespaceEntries(num, namespace), StreamFormat.NDJSON);
+  }
+
+  private async *iterateNamespaceEntries(num: string, namespace: string): AsyncGenerator<INamespaceEntry> {
+    for await (const page of this.xrpl.iterateAccountNamespace(num, namespace, ACCOUNT_NAMESPACE_PAGE_SIZE)) {
+      yield* page.namespace_entries;
+    }
+  }
 }
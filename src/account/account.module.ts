@@ -1,9 +1,7 @@
 import { Module } from '@nestjs/common';
 import { AccountController } from './account.controller';
-import { XrplService } from '../xrpl/client/client.service';
 
 @Module({
   controllers: [AccountController],
-  providers: [XrplService],
 })
 export class AccountModule {}
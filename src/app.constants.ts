@@ -0,0 +1 @@
+export const HTTP_PORT = parseInt(process.env.PORT || '3000');
@@ -0,0 +1,13 @@
+import { INestApplication, NestApplicationOptions } from '@nestjs/common';
+import { HttpAdapterHost, NestFactory } from '@nestjs/core';
+import { AppModule } from './app.module';
+import { ValidationPipe } from './hooks/validation';
+import { AllExceptionsFilter } from './exceptions/AllExceptionsFilter';
+
+// the application with the global validation pipe and exception filter, as booted by main.ts and the bench
+export async function createApp(options: NestApplicationOptions = {}): Promise<INestApplication> {
+  const app = await NestFactory.create(AppModule, options);
+  app.useGlobalPipes(new ValidationPipe());
+  app.useGlobalFilters(new AllExceptionsFilter(app.get(HttpAdapterHost)));
+  return app;
+}
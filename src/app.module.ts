@@ -4,8 +4,22 @@ import { UriTokenModule } from './uriToken/uri-token.module';
 import { ConfigModule } from '@nestjs/config';
 import { AccountModule } from './account/account.module';
 import { RentalModule } from './rentals/rental.module';
+import { ClientModule } from './xrpl/client.module';
+import { TransactionModule } from './transactions/transaction.module';
+import { MetricsModule } from './metrics/metrics.module';
+import { TracingModule } from './tracing/tracing.module';
 
 @Module({
-  imports: [ConfigModule.forRoot({ isGlobal: true }), HookModule, UriTokenModule, AccountModule, RentalModule],
+  imports: [
+    ConfigModule.forRoot({ isGlobal: true }),
+    TracingModule,
+    MetricsModule,
+    ClientModule,
+    HookModule,
+    UriTokenModule,
+    AccountModule,
+    RentalModule,
+    TransactionModule,
+  ],
 })
 export class AppModule {}
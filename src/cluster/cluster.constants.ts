@@ -0,0 +1,29 @@
+// worker processes behind the front process, 0 runs the service as a single process
+export const CLUSTER_WORKERS = parseInt(process.env.CLUSTER_WORKERS || '0');
+
+// set by the front process on every worker it forks
+export const CLUSTER_WORKER_INDEX = process.env.CLUSTER_WORKER_INDEX;
+
+// worker i listens on the loopback interface, port CLUSTER_WORKER_PORT_BASE + i
+export const CLUSTER_WORKER_PORT_BASE = parseInt(process.env.CLUSTER_WORKER_PORT_BASE || '3100');
+
+// bodies read by the front process to find the account of a request, larger ones are refused
+export const CLUSTER_MAX_BODY_BYTES = parseInt(process.env.CLUSTER_MAX_BODY_BYTES || '1048576');
+
+// delay before a worker that exited is forked again
+export const CLUSTER_RESTART_DELAY_MS = parseInt(process.env.CLUSTER_RESTART_DELAY_MS || '1000');
+
+// classic address, checked by its shape only: the front process never decodes it
+export const ACCOUNT_ADDRESS_PATTERN = /^r[1-9A-HJ-NP-Za-km-z]{24,34}$/;
+
+// request body fields naming the account a request acts for, the first one present wins
+export const ACCOUNT_BODY_FIELDS = ['address', 'account', 'renterAccount'];
+
+// added to every series when the metrics of the workers are merged
+export const WORKER_METRIC_LABEL = 'worker';
+
+// hop-by-hop headers belong to a single connection and are not forwarded
+export const HOP_BY_HOP_HEADERS = ['connection', 'keep-alive', 'proxy-connection', 'upgrade'];
+
+// sent by a worker to the front process once it accepts requests
+export const WORKER_LISTENING_MESSAGE = 'cluster-worker-listening';
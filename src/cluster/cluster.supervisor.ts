@@ -0,0 +1,51 @@
+import { Logger } from '@nestjs/common';
+import { ChildProcess, fork } from 'node:child_process';
+import { FrontProxy } from './front-proxy';
+import {
+  CLUSTER_RESTART_DELAY_MS,
+  CLUSTER_WORKER_PORT_BASE,
+  CLUSTER_WORKERS,
+  WORKER_LISTENING_MESSAGE,
+} from './cluster.constants';
+
+/**
+ * Forks CLUSTER_WORKERS copies of the service, each on its own loopback port, and starts the front proxy on
+ * the public port once all of them listen. A worker that exits is forked again under the same index, so it
+ * comes back on the same port and serves the same accounts.
+ */
+export class ClusterSupervisor {
+  private readonly workers = new Map<number, ChildProcess>();
+  private proxy?: FrontProxy;
+  private stopping = false;
+
+  async start(port: number, host?: string): Promise<number> {
+    const workerPorts = Array.from({ length: CLUSTER_WORKERS }, (_, index) => CLUSTER_WORKER_PORT_BASE + index);
+    await Promise.all(workerPorts.map((_, index) => new Promise<void>((resolve) => this.fork(index, resolve))));
+    this.proxy = new FrontProxy(workerPorts);
+    const boundPort = await this.proxy.listen(port, host);
+    Logger.log(`Cluster of ${CLUSTER_WORKERS} workers listening on port: ${boundPort}`);
+    return boundPort;
+  }
+
+  async stop(): Promise<void> {
+    this.stopping = true;
+    this.workers.forEach((worker) => worker.kill());
+    await this.proxy?.close();
+  }
+
+  private fork(index: number, onListening: () => void) {
+    const worker = fork(process.argv[1], process.argv.slice(2), {
+      env: { ...process.env, CLUSTER_WORKER_INDEX: String(index) },
+    });
+    this.workers.set(index, worker);
+    worker.on('message', (message) => message === WORKER_LISTENING_MESSAGE && onListening());
+    worker.once('exit', (code, signal) => {
+      this.workers.delete(index);
+      if (this.stopping) {
+        return;
+      }
+      Logger.error(`Cluster worker: ${index} exited with: ${signal ?? code}, it is forked again`);
+      setTimeout(() => this.fork(index, onListening), CLUSTER_RESTART_DELAY_MS);
+    });
+  }
+}
@@ -0,0 +1,60 @@
+import { accountFromBody, accountFromPath, mergeWorkerMetrics, workerIndexOf } from './cluster.utils';
+import { TEST_ADDRESS_ALICE, TEST_ADDRESS_BOB, TEST_SECRET, TEST_URI_INDEX } from '../test-utils/test-utils';
+
+describe('cluster utils unit spec', () => {
+  test.each([
+    [`/account/${TEST_ADDRESS_ALICE}/info`, TEST_ADDRESS_ALICE],
+    [`/hook/${TEST_ADDRESS_ALICE}`, TEST_ADDRESS_ALICE],
+    [`/rentals/lender/${TEST_ADDRESS_ALICE}`, TEST_ADDRESS_ALICE],
+    [`/uri-tokens/${TEST_URI_INDEX}`, undefined],
+    ['/hook/reset', undefined],
+  ])('should find the account of path %s', (path, account) => {
+    expect(accountFromPath(path)).toEqual(account);
+  });
+
+  test.each([
+    ['a hook body', { address: TEST_ADDRESS_ALICE, secret: TEST_SECRET }, TEST_ADDRESS_ALICE],
+    ['a URIToken body', { account: { address: TEST_ADDRESS_ALICE, secret: TEST_SECRET } }, TEST_ADDRESS_ALICE],
+    ['an accept offer body', { renterAccount: { address: TEST_ADDRESS_BOB }, totalAmount: 10 }, TEST_ADDRESS_BOB],
+    ['a body without an account', { uri: TEST_URI_INDEX }, undefined],
+  ])('should find the account of %s', (_, body, account) => {
+    expect(accountFromBody(Buffer.from(JSON.stringify(body)))).toEqual(account);
+  });
+
+  test('should find no account in a body which is not JSON', () => {
+    expect(accountFromBody(Buffer.from('address=' + TEST_ADDRESS_ALICE))).toBeUndefined();
+  });
+
+  test('should keep an account on one worker and spread accounts over the workers', () => {
+    expect(workerIndexOf(TEST_ADDRESS_ALICE, 4)).toEqual(workerIndexOf(TEST_ADDRESS_ALICE, 4));
+    const used = new Set(
+      Array.from({ length: 64 }, (_, i) => workerIndexOf(TEST_ADDRESS_ALICE.slice(0, -2) + i.toString(36), 4))
+    );
+    expect(used.size).toEqual(4);
+  });
+
+  test('should merge the metrics of the workers under one HELP and TYPE per family', () => {
+    const output = (requests: number) =>
+      [
+        '# HELP http_requests_total HTTP requests handled',
+        '# TYPE http_requests_total counter',
+        `http_requests_total{route="/hook"} ${requests}`,
+        '# HELP signing_queue_depth Signing jobs waiting',
+        '# TYPE signing_queue_depth gauge',
+        'signing_queue_depth 0',
+      ].join('\n') + '\n';
+
+    expect(mergeWorkerMetrics([output(1), undefined, output(2)])).toEqual(
+      [
+        '# HELP http_requests_total HTTP requests handled',
+        '# TYPE http_requests_total counter',
+        'http_requests_total{worker="0",route="/hook"} 1',
+        'http_requests_total{worker="2",route="/hook"} 2',
+        '# HELP signing_queue_depth Signing jobs waiting',
+        '# TYPE signing_queue_depth gauge',
+        'signing_queue_depth{worker="0"} 0',
+        'signing_queue_depth{worker="2"} 0',
+      ].join('\n') + '\n'
+    );
+  });
+});
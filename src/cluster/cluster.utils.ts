@@ -0,0 +1,68 @@
+import { ACCOUNT_ADDRESS_PATTERN, ACCOUNT_BODY_FIELDS, WORKER_METRIC_LABEL } from './cluster.constants';
+
+// /account/:num/..., /hook/:address, /uri-tokens/:address and /rentals/(lender|renter)/:address
+export function accountFromPath(path: string): string | undefined {
+  return path.split('/').find((segment) => ACCOUNT_ADDRESS_PATTERN.test(segment));
+}
+
+// { address }, { account: { address } } and { renterAccount: { address } } bodies of the submitting routes
+export function accountFromBody(body: Buffer): string | undefined {
+  let parsed: any;
+  try {
+    parsed = JSON.parse(body.toString());
+  } catch (err) {
+    return undefined;
+  }
+  for (const field of ACCOUNT_BODY_FIELDS) {
+    const value = parsed?.[field];
+    const account = typeof value === 'string' ? value : value?.address;
+    if (typeof account === 'string' && ACCOUNT_ADDRESS_PATTERN.test(account)) {
+      return account;
+    }
+  }
+  return undefined;
+}
+
+// FNV-1a, stable across processes and restarts so an account keeps its worker
+export function workerIndexOf(account: string, workers: number): number {
+  let hash = 0x811c9dc5;
+  for (let i = 0; i < account.length; i++) {
+    hash ^= account.charCodeAt(i);
+    hash = Math.imul(hash, 0x01000193);
+  }
+  return (hash >>> 0) % workers;
+}
+
+function withWorkerLabel(sample: string, worker: number): string {
+  const label = `${WORKER_METRIC_LABEL}="${worker}"`;
+  const space = sample.indexOf(' ');
+  const brace = sample.indexOf('{');
+  if (brace !== -1 && brace < space) {
+    return `${sample.slice(0, brace + 1)}${label},${sample.slice(brace + 1)}`;
+  }
+  return `${sample.slice(0, space)}{${label}}${sample.slice(space)}`;
+}
+
+/**
+ * Merges the Prometheus text of every worker into one document: each family keeps a single HELP and TYPE,
+ * followed by the samples of all workers told apart by a worker label. Workers that did not answer are undefined.
+ */
+export function mergeWorkerMetrics(outputs: Array<string | undefined>): string {
+  const families = new Map<string, { header: string[]; samples: string[] }>();
+  outputs.forEach((output, worker) => {
+    let family: { header: string[]; samples: string[] } | undefined;
+    for (const line of (output ?? '').split('\n')) {
+      if (line.startsWith('# HELP ') || line.startsWith('# TYPE ')) {
+        const name = line.split(' ')[2];
+        family = families.get(name) ?? { header: [], samples: [] };
+        families.set(name, family);
+        if (!family.header.includes(line)) {
+          family.header.push(line);
+        }
+      } else if (line.length > 0 && !line.startsWith('#')) {
+        family?.samples.push(withWorkerLabel(line, worker));
+      }
+    }
+  });
+  return [...families.values()].map(({ header, samples }) => [...header, ...samples].join('\n') + '\n').join('');
+}
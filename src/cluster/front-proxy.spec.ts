@@ -0,0 +1,116 @@
+import { createServer, request, Server } from 'node:http';
+import { AddressInfo } from 'node:net';
+import { FrontProxy } from './front-proxy';
+import { workerIndexOf } from './cluster.utils';
+import { TEST_ADDRESS_ALICE, TEST_ADDRESS_BOB, TEST_SECRET, TEST_TX_HASH } from '../test-utils/test-utils';
+
+const WORKERS = 3;
+// the only worker tracking TEST_TX_HASH
+const SUBMITTING_WORKER = 1;
+
+interface IProxyResponse {
+  statusCode: number;
+  body: string;
+}
+
+// answers with its own index and what it received, like a worker would answer from its process-local state
+function startStubWorker(index: number): Promise<Server> {
+  const server = createServer((req, res) => {
+    const chunks: Buffer[] = [];
+    req.on('data', (chunk) => chunks.push(chunk));
+    req.on('end', () => {
+      if (req.url === '/metrics') {
+        res.writeHead(200, { 'content-type': 'text/plain; version=0.0.4' });
+        res.end(`# HELP requests_total Requests\n# TYPE requests_total counter\nrequests_total ${index}\n`);
+        return;
+      }
+      if (req.url.startsWith('/transactions/') && index !== SUBMITTING_WORKER) {
+        res.writeHead(404, { 'content-type': 'application/json' });
+        res.end(JSON.stringify({ statusCode: 404 }));
+        return;
+      }
+      res.writeHead(200, { 'content-type': 'application/json' });
+      res.end(JSON.stringify({ worker: index, url: req.url, body: Buffer.concat(chunks).toString() }));
+    });
+  });
+  return new Promise((resolve) => server.listen(0, '127.0.0.1', () => resolve(server)));
+}
+
+function send(port: number, method: string, path: string, body?: object): Promise<IProxyResponse> {
+  return new Promise((resolve, reject) => {
+    const req = request({ host: '127.0.0.1', port, method, path }, (res) => {
+      const chunks: Buffer[] = [];
+      res.on('data', (chunk) => chunks.push(chunk));
+      res.on('end', () => resolve({ statusCode: res.statusCode, body: Buffer.concat(chunks).toString() }));
+    });
+    req.on('error', reject);
+    req.end(body ? JSON.stringify(body) : undefined);
+  });
+}
+
+describe('FrontProxy unit spec', () => {
+  let workers: Server[];
+  let underTest: FrontProxy;
+  let port: number;
+
+  beforeEach(async () => {
+    workers = await Promise.all(Array.from({ length: WORKERS }, (_, index) => startStubWorker(index)));
+    underTest = new FrontProxy(workers.map((worker) => (worker.address() as AddressInfo).port), 1024);
+    port = await underTest.listen(0, '127.0.0.1');
+  });
+
+  afterEach(async () => {
+    await underTest.close();
+    await Promise.all(workers.map((worker) => new Promise((resolve) => worker.close(resolve))));
+  });
+
+  test('should route reads and writes of an account to the worker the account hashes to', async () => {
+    const expected = workerIndexOf(TEST_ADDRESS_ALICE, WORKERS);
+
+    const read = await send(port, 'GET', `/uri-tokens/${TEST_ADDRESS_ALICE}?limit=10`);
+    const write = await send(port, 'POST', '/uri-tokens', {
+      account: { address: TEST_ADDRESS_ALICE, secret: TEST_SECRET },
+    });
+    const hookWrite = await send(port, 'PUT', '/hook/reset', { address: TEST_ADDRESS_ALICE, secret: TEST_SECRET });
+
+    expect([read, write, hookWrite].map(({ body }) => JSON.parse(body).worker)).toEqual([expected, expected, expected]);
+    expect(JSON.parse(read.body).url).toEqual(`/uri-tokens/${TEST_ADDRESS_ALICE}?limit=10`);
+    expect(JSON.parse(JSON.parse(write.body).body)).toEqual({
+      account: { address: TEST_ADDRESS_ALICE, secret: TEST_SECRET },
+    });
+  });
+
+  test('should send requests without an account to the workers in turn', async () => {
+    const answered = [];
+    for (let i = 0; i < WORKERS; i++) {
+      answered.push(JSON.parse((await send(port, 'GET', '/rentals/expiring')).body).worker);
+    }
+
+    expect(answered.sort()).toEqual([0, 1, 2]);
+  });
+
+  test('should answer a transaction status from the worker tracking it', async () => {
+    const response = await send(port, 'GET', `/transactions/${TEST_TX_HASH}`);
+
+    expect(response.statusCode).toEqual(200);
+    expect(JSON.parse(response.body).worker).toEqual(SUBMITTING_WORKER);
+  });
+
+  test('should merge the metrics of every worker', async () => {
+    const response = await send(port, 'GET', '/metrics');
+
+    expect(response.body).toEqual(
+      '# HELP requests_total Requests\n# TYPE requests_total counter\n' +
+        'requests_total{worker="0"} 0\nrequests_total{worker="1"} 1\nrequests_total{worker="2"} 2\n'
+    );
+  });
+
+  test('should refuse bodies too large to look for an account in', async () => {
+    const response = await send(port, 'POST', '/offers', {
+      account: { address: TEST_ADDRESS_BOB },
+      pad: 'x'.repeat(2048),
+    });
+
+    expect(response.statusCode).toEqual(413);
+  });
+});
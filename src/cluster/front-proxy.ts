@@ -0,0 +1,180 @@
+import { Agent, createServer, IncomingHttpHeaders, IncomingMessage, request, Server, ServerResponse } from 'node:http';
+import { AddressInfo } from 'node:net';
+import { accountFromBody, accountFromPath, mergeWorkerMetrics, workerIndexOf } from './cluster.utils';
+import { CLUSTER_MAX_BODY_BYTES, HOP_BY_HOP_HEADERS } from './cluster.constants';
+
+interface IBufferedResponse {
+  statusCode: number;
+  headers: IncomingHttpHeaders;
+  body: Buffer;
+}
+
+class PayloadTooLargeError extends Error {}
+
+function withoutHopByHop(headers: IncomingHttpHeaders): IncomingHttpHeaders {
+  const forwarded = { ...headers };
+  HOP_BY_HOP_HEADERS.forEach((name) => delete forwarded[name]);
+  return forwarded;
+}
+
+function readBody(req: IncomingMessage, maxBytes: number): Promise<Buffer> {
+  return new Promise((resolve, reject) => {
+    const chunks: Buffer[] = [];
+    let length = 0;
+    req.on('data', (chunk: Buffer) => {
+      length += chunk.length;
+      if (length > maxBytes) {
+        // the rest is read and discarded so the refusal can still be sent on this connection
+        req.removeAllListeners('data');
+        req.resume();
+        reject(new PayloadTooLargeError(`Request body exceeds ${maxBytes} bytes`));
+        return;
+      }
+      chunks.push(chunk);
+    });
+    req.on('end', () => resolve(Buffer.concat(chunks)));
+    req.on('error', reject);
+  });
+}
+
+/**
+ * Front process of the cluster mode. A request naming an account, in its path or in its JSON body, always
+ * goes to the worker the account hashes to, so the sequence allocation, caches and hook grant state of an
+ * account live in one process. Requests without an account go to the workers in turn, except transaction
+ * status lookups, which ask every worker since only the submitting one tracks the transaction, and metrics,
+ * which are merged from all workers.
+ */
+export class FrontProxy {
+  private readonly agent = new Agent({ keepAlive: true });
+  private readonly server: Server = createServer((req, res) => this.handle(req, res));
+  private nextWorker = 0;
+
+  constructor(
+    private readonly workerPorts: number[],
+    private readonly maxBodyBytes: number = CLUSTER_MAX_BODY_BYTES
+  ) {}
+
+  listen(port: number, host?: string): Promise<number> {
+    return new Promise((resolve, reject) => {
+      this.server.once('error', reject);
+      this.server.listen(port, host, () => resolve((this.server.address() as AddressInfo).port));
+    });
+  }
+
+  close(): Promise<void> {
+    this.agent.destroy();
+    return new Promise((resolve) => this.server.close(() => resolve()));
+  }
+
+  private async handle(req: IncomingMessage, res: ServerResponse) {
+    try {
+      const [path] = req.url.split('?');
+      const [, resource] = path.split('/');
+      if (req.method === 'GET' && resource === 'transactions') {
+        await this.firstFound(req, res);
+        return;
+      }
+      if (req.method === 'GET' && resource === 'metrics') {
+        await this.mergedMetrics(req, res);
+        return;
+      }
+      let account = accountFromPath(path);
+      let body: Buffer | undefined;
+      if (!account && req.method !== 'GET') {
+        body = await readBody(req, this.maxBodyBytes);
+        account = accountFromBody(body);
+      }
+      const worker = account
+        ? workerIndexOf(account, this.workerPorts.length)
+        : this.nextWorker++ % this.workerPorts.length;
+      this.forward(req, res, worker, body);
+    } catch (err) {
+      this.fail(req, res, err instanceof PayloadTooLargeError ? 413 : 502, err?.message);
+    }
+  }
+
+  private forward(req: IncomingMessage, res: ServerResponse, worker: number, body?: Buffer) {
+    const upstream = request(
+      {
+        host: '127.0.0.1',
+        port: this.workerPorts[worker],
+        method: req.method,
+        path: req.url,
+        headers: withoutHopByHop(req.headers),
+        agent: this.agent,
+      },
+      (response) => {
+        res.writeHead(response.statusCode, withoutHopByHop(response.headers));
+        response.pipe(res);
+      }
+    );
+    upstream.on('error', (err) => this.fail(req, res, 502, err.message));
+    // a client leaving mid-response frees the worker connection, a finished one goes back to the pool
+    res.on('close', () => !res.writableFinished && upstream.destroy());
+    if (body) {
+      upstream.end(body);
+    } else {
+      req.pipe(upstream);
+    }
+  }
+
+  private async firstFound(req: IncomingMessage, res: ServerResponse) {
+    const responses = await this.askAll(req);
+    const found = responses.find((response) => response && response.statusCode !== 404);
+    const answer = found ?? responses.find((response) => !!response);
+    if (!answer) {
+      this.fail(req, res, 502, 'No worker answered');
+      return;
+    }
+    res.writeHead(answer.statusCode, withoutHopByHop(answer.headers));
+    res.end(answer.body);
+  }
+
+  private async mergedMetrics(req: IncomingMessage, res: ServerResponse) {
+    const responses = await this.askAll(req);
+    const outputs = responses.map((response) => (response?.statusCode === 200 ? response.body.toString() : undefined));
+    const contentType = responses.find((response) => response?.statusCode === 200)?.headers['content-type'];
+    res.writeHead(200, { 'content-type': contentType ?? 'text/plain' });
+    res.end(mergeWorkerMetrics(outputs));
+  }
+
+  // a worker that cannot be reached leaves an undefined response
+  private askAll(req: IncomingMessage): Promise<Array<IBufferedResponse | undefined>> {
+    return Promise.all(
+      this.workerPorts.map(
+        (port) =>
+          new Promise<IBufferedResponse | undefined>((resolve) => {
+            const upstream = request(
+              {
+                host: '127.0.0.1',
+                port,
+                method: req.method,
+                path: req.url,
+                headers: withoutHopByHop(req.headers),
+                agent: this.agent,
+              },
+              (response) => {
+                const chunks: Buffer[] = [];
+                response.on('data', (chunk: Buffer) => chunks.push(chunk));
+                response.on('end', () =>
+                  resolve({ statusCode: response.statusCode, headers: response.headers, body: Buffer.concat(chunks) })
+                );
+                response.on('error', () => resolve(undefined));
+              }
+            );
+            upstream.on('error', () => resolve(undefined));
+            upstream.end();
+          })
+      )
+    );
+  }
+
+  private fail(req: IncomingMessage, res: ServerResponse, statusCode: number, message: string) {
+    if (res.headersSent) {
+      res.destroy();
+      return;
+    }
+    res.writeHead(statusCode, { 'content-type': 'application/json' });
+    res.end(JSON.stringify({ statusCode, timestamp: new Date().toISOString(), message, path: req.url }));
+  }
+}
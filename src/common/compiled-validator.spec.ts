@@ -0,0 +1,86 @@
+import { plainToClass } from 'class-transformer';
+import { IsString, validate, ValidateNested } from 'class-validator';
+import { compileValidator, getCompiledValidator } from './compiled-validator';
+import { CancelRentalOfferDTO, URITokenInputDTO } from '../rentals/dto/rental.dto';
+import { HookInputDTO } from '../hooks/dto/hook-input.dto';
+import { RentalType } from '../uriToken/uri-token.constant';
+import { TEST_ADDRESS_ALICE, TEST_ADDRESS_BOB, TEST_SECRET } from '../test-utils/test-utils';
+
+const TEST_URI_TOKEN_ID = '0FAC3CD45FCB800BB9CCCF907775E7D4FB167847D8999FF05CE7456D6C3A70FA';
+
+const VALID_URI_TOKEN_INPUT = {
+  account: { address: TEST_ADDRESS_ALICE, secret: TEST_SECRET },
+  destinationAccount: TEST_ADDRESS_BOB,
+  uri: TEST_URI_TOKEN_ID,
+  totalAmount: 10,
+  rentalType: RentalType.COLLATERAL_FREE,
+  deadline: '2030-01-01T00:00:00Z',
+};
+
+class NestedInputDTO {
+  @ValidateNested()
+  readonly inner: HookInputDTO;
+}
+
+class LabelInputDTO {
+  @IsString()
+  readonly label: string;
+}
+
+async function reflectiveVerdict(metatype: Function, value: unknown): Promise<boolean> {
+  return (await validate(plainToClass(metatype as any, value))).length === 0;
+}
+
+describe('compileValidator unit spec', () => {
+  test.each([
+    ['valid input', VALID_URI_TOKEN_INPUT],
+    ['inherited field of the wrong type', { ...VALID_URI_TOKEN_INPUT, totalAmount: '10' }],
+    ['non positive amount', { ...VALID_URI_TOKEN_INPUT, totalAmount: 0 }],
+    ['unknown rental type', { ...VALID_URI_TOKEN_INPUT, rentalType: 'LEASE' }],
+    ['invalid deadline', { ...VALID_URI_TOKEN_INPUT, deadline: 'tomorrow' }],
+    ['uri of the wrong length', { ...VALID_URI_TOKEN_INPUT, uri: TEST_URI_TOKEN_ID.slice(1) }],
+    ['empty destination', { ...VALID_URI_TOKEN_INPUT, destinationAccount: '' }],
+    ['missing fields', { uri: TEST_URI_TOKEN_ID }],
+    ['unvalidated nested account', { ...VALID_URI_TOKEN_INPUT, account: { address: 1 } }],
+  ])('should give the reflective verdict on URITokenInputDTO for %s', async (_, value) => {
+    const compiled = compileValidator(URITokenInputDTO);
+
+    expect(compiled(value)).toEqual(await reflectiveVerdict(URITokenInputDTO, value));
+  });
+
+  test.each([
+    ['without the optional namespace', { address: TEST_ADDRESS_ALICE, secret: TEST_SECRET }],
+    ['with a namespace', { address: TEST_ADDRESS_ALICE, secret: TEST_SECRET, namespace: 'ns' }],
+    ['with a null namespace', { address: TEST_ADDRESS_ALICE, secret: TEST_SECRET, namespace: null }],
+    ['with a namespace of the wrong type', { address: TEST_ADDRESS_ALICE, secret: TEST_SECRET, namespace: 1 }],
+  ])('should skip optional properties of HookInputDTO like the reflective validator %s', async (_, value) => {
+    const compiled = compileValidator(HookInputDTO);
+
+    expect(compiled(value)).toEqual(await reflectiveVerdict(HookInputDTO, value));
+  });
+
+  test('should reject classes without validation metadata as unknown values', async () => {
+    const value = { account: { address: TEST_ADDRESS_ALICE, secret: TEST_SECRET } };
+
+    expect(compileValidator(CancelRentalOfferDTO)(value)).toEqual(false);
+    expect(await reflectiveVerdict(CancelRentalOfferDTO, value)).toEqual(false);
+  });
+
+  test('should reject bodies which are not objects', () => {
+    const compiled = compileValidator(LabelInputDTO);
+
+    expect(compiled(null)).toEqual(false);
+    expect(compiled([{ label: 'a' }])).toEqual(false);
+    expect(compiled('label')).toEqual(false);
+  });
+
+  test('should fall back to reflective validation for nested validation', async () => {
+    const compiled = compileValidator(NestedInputDTO);
+
+    await expect(compiled({ inner: { address: TEST_ADDRESS_ALICE, secret: '' } })).resolves.toEqual(false);
+  });
+
+  test('should compile a class once', () => {
+    expect(getCompiledValidator(LabelInputDTO)).toBe(getCompiledValidator(LabelInputDTO));
+  });
+});
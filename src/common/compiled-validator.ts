@@ -0,0 +1,94 @@
+import { plainToClass } from 'class-transformer';
+import { getMetadataStorage, MetadataStorage, validate, ValidationArguments, ValidationTypes } from 'class-validator';
+
+export type CompiledValidator = (value: unknown) => boolean | Promise<boolean>;
+
+type ValidationMetadata = ReturnType<MetadataStorage['getTargetValidationMetadatas']>[number];
+
+type PropertyCheck = (object: object) => boolean;
+
+const CONSTRAINT_TYPES: string[] = [ValidationTypes.CUSTOM_VALIDATION, ValidationTypes.IS_DEFINED];
+
+const compiledValidators = new WeakMap<Function, CompiledValidator>();
+
+/**
+ * Returns the validator of a DTO class, compiling it from the class-validator metadata the first time the
+ * class is validated.
+ */
+export function getCompiledValidator(metatype: Function): CompiledValidator {
+  let validator = compiledValidators.get(metatype);
+  if (!validator) {
+    validator = compileValidator(metatype);
+    compiledValidators.set(metatype, validator);
+  }
+  return validator;
+}
+
+/**
+ * Resolves the decorators of a DTO class, inherited ones included, into one synchronous predicate over the
+ * plain request body, giving the verdict of `validate(plainToClass(metatype, body))` without instantiating
+ * the class or walking the metadata on every request. Classes using nested, `each` or asynchronous
+ * validation keep the reflective path.
+ */
+export function compileValidator(metatype: Function): CompiledValidator {
+  const storage = getMetadataStorage();
+  const metadatas = storage.getTargetValidationMetadatas(metatype, undefined, false, false);
+  if (metadatas.length === 0) {
+    // forbidUnknownValues is on by default, a class without any validation metadata never validates
+    return () => false;
+  }
+  if (!metadatas.every((metadata) => isCompilable(storage, metadata))) {
+    return async (value) => (await validate(plainToClass(metatype as any, value))).length === 0;
+  }
+  const byProperty = new Map<string, ValidationMetadata[]>();
+  metadatas.forEach((metadata) =>
+    byProperty.set(metadata.propertyName, [...(byProperty.get(metadata.propertyName) ?? []), metadata])
+  );
+  const checks = [...byProperty].map(([property, propertyMetadatas]) =>
+    compileProperty(storage, metatype.name, property, propertyMetadatas)
+  );
+  return (value) =>
+    value !== null && typeof value === 'object' && !Array.isArray(value) && checks.every((check) => check(value));
+}
+
+function isCompilable(storage: MetadataStorage, metadata: ValidationMetadata): boolean {
+  if (metadata.each) {
+    return false;
+  }
+  if (metadata.type === ValidationTypes.CONDITIONAL_VALIDATION || metadata.type === ValidationTypes.WHITELIST) {
+    return true;
+  }
+  return (
+    CONSTRAINT_TYPES.includes(metadata.type) &&
+    storage.getTargetValidatorConstraints(metadata.constraintCls).every((constraint) => !constraint.async)
+  );
+}
+
+// conditions (@IsOptional, @ValidateIf) skip the property when one of them fails, like the executor does
+function compileProperty(
+  storage: MetadataStorage,
+  targetName: string,
+  property: string,
+  metadatas: ValidationMetadata[]
+): PropertyCheck {
+  const conditions: Array<(object: object, value: unknown) => boolean> = metadatas
+    .filter((metadata) => metadata.type === ValidationTypes.CONDITIONAL_VALIDATION)
+    .map((metadata) => metadata.constraints[0]);
+  const constraints = metadatas
+    .filter((metadata) => CONSTRAINT_TYPES.includes(metadata.type))
+    .flatMap((metadata) =>
+      storage
+        .getTargetValidatorConstraints(metadata.constraintCls)
+        .map(({ instance }) => ({ instance, constraints: metadata.constraints }))
+    );
+  return (object) => {
+    const value = object[property];
+    if (!conditions.every((condition) => condition(object, value))) {
+      return true;
+    }
+    return constraints.every(({ instance, constraints }) => {
+      const args: ValidationArguments = { targetName, property, object, value, constraints };
+      return !!instance.validate(value, args);
+    });
+  };
+}
@@ -0,0 +1,81 @@
+import { setTimeout } from 'timers/promises';
+import { mapWithConcurrency } from './concurrency.utils';
+
+describe('mapWithConcurrency unit spec', () => {
+  test('should keep input order and never exceed the concurrency limit', async () => {
+    let active = 0;
+    let maxActive = 0;
+    const results: number[] = [];
+
+    for await (const result of mapWithConcurrency([30, 10, 20, 5, 15], 2, async (delay) => {
+      active++;
+      maxActive = Math.max(maxActive, active);
+      await setTimeout(delay);
+      active--;
+      return delay;
+    })) {
+      results.push(result);
+    }
+
+    expect(results).toEqual([30, 10, 20, 5, 15]);
+    expect(maxActive).toEqual(2);
+  });
+
+  test('should yield nothing for an empty input', async () => {
+    const fn = jest.fn();
+    for await (const result of mapWithConcurrency([], 4, fn)) {
+      fail(`unexpected result: ${result}`);
+    }
+    expect(fn).not.toBeCalled();
+  });
+
+  describe('with calls left running', () => {
+    const unhandled: unknown[] = [];
+    const onUnhandled = (reason: unknown) => unhandled.push(reason);
+
+    beforeEach(() => {
+      unhandled.length = 0;
+      process.on('unhandledRejection', onUnhandled);
+    });
+
+    afterEach(() => {
+      process.off('unhandledRejection', onUnhandled);
+    });
+
+    test('should throw the first failure and leave no rejection unhandled', async () => {
+      const failAfter = async (delay: number) => {
+        await setTimeout(delay);
+        throw new Error(`failed after ${delay}`);
+      };
+
+      const consume = async () => {
+        for await (const result of mapWithConcurrency([20, 5], 2, failAfter)) {
+          throw new Error(`unexpected result: ${result}`);
+        }
+      };
+
+      await expect(consume()).rejects.toThrow('failed after 20');
+      await setTimeout(30);
+      expect(unhandled).toEqual([]);
+    });
+
+    test('should leave no rejection unhandled when the consumer stops early', async () => {
+      const results: number[] = [];
+
+      for await (const result of mapWithConcurrency([1, 10, 15, 20], 3, async (delay) => {
+        await setTimeout(delay);
+        if (delay > 1) {
+          throw new Error(`failed after ${delay}`);
+        }
+        return delay;
+      })) {
+        results.push(result);
+        break;
+      }
+      await setTimeout(30);
+
+      expect(results).toEqual([1]);
+      expect(unhandled).toEqual([]);
+    });
+  });
+});
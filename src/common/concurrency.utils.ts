@@ -0,0 +1,29 @@
+/**
+ * Maps items through an async function running at most `limit` calls at a time,
+ * yielding the results in input order as soon as each one (and all before it) is ready.
+ * The first rejection in input order is thrown, calls already started are left to settle on their own.
+ */
+export async function* mapWithConcurrency<T, R>(
+  items: T[],
+  limit: number,
+  fn: (item: T) => Promise<R>
+): AsyncGenerator<R, void, undefined> {
+  const running: Promise<R>[] = [];
+  let next = 0;
+  // a call settling while an earlier one is awaited, or after the consumer stopped, is otherwise left unobserved
+  const start = (item: T) => {
+    const call = fn(item);
+    call.catch(() => undefined);
+    running.push(call);
+  };
+  while (next < items.length && running.length < limit) {
+    start(items[next++]);
+  }
+  while (running.length > 0) {
+    const result = await running.shift();
+    if (next < items.length) {
+      start(items[next++]);
+    }
+    yield result;
+  }
+}
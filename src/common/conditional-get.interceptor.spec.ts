@@ -0,0 +1,89 @@
+import { ExecutionContext } from '@nestjs/common';
+import { Reflector } from '@nestjs/core';
+import { lastValueFrom, of } from 'rxjs';
+import { ConditionalGet, ConditionalGetInterceptor, matchesETag } from './conditional-get.interceptor';
+import { AccountVersionTracker } from '../xrpl/client/account-version.tracker';
+import { NotModifiedException } from '../exceptions/NotModifiedException';
+import { TEST_ADDRESS_ALICE, TEST_TX_HASH } from '../test-utils/test-utils';
+
+const ETAG = `W/"90-${TEST_TX_HASH}"`;
+
+class TestController {
+  @ConditionalGet('address')
+  handler() {
+    return 'body';
+  }
+}
+
+function getContext(request: Record<string, any>, response: Record<string, any>): ExecutionContext {
+  return {
+    getHandler: () => TestController.prototype.handler,
+    switchToHttp: () => ({ getRequest: () => request, getResponse: () => response }),
+  } as any;
+}
+
+describe('ConditionalGetInterceptor unit spec', () => {
+  let underTest: ConditionalGetInterceptor;
+  let versions: jest.Mocked<AccountVersionTracker>;
+  const next = { handle: jest.fn(() => of('body')) };
+
+  beforeEach(() => {
+    versions = { getVersion: jest.fn().mockResolvedValue({ ledgerIndex: 90, txHash: TEST_TX_HASH }) } as any;
+    underTest = new ConditionalGetInterceptor(new Reflector(), versions);
+    next.handle.mockClear();
+  });
+
+  test('should tag the response with the account version', async () => {
+    const response = { setHeader: jest.fn() };
+    const result = await underTest.intercept(getContext({ params: { address: TEST_ADDRESS_ALICE } }, response), next);
+
+    expect(await lastValueFrom(result)).toEqual('body');
+    expect(versions.getVersion).toBeCalledWith(TEST_ADDRESS_ALICE);
+    expect(response.setHeader).toBeCalledWith('ETag', ETAG);
+    expect(response.setHeader).toBeCalledWith('Vary', 'Accept');
+  });
+
+  test('should tag an NDJSON response apart from the JSON array of the same version', async () => {
+    const response = { setHeader: jest.fn() };
+    const request = {
+      params: { address: TEST_ADDRESS_ALICE },
+      headers: { accept: 'application/x-ndjson', 'if-none-match': ETAG },
+    };
+
+    const result = await underTest.intercept(getContext(request, response), next);
+
+    expect(await lastValueFrom(result)).toEqual('body');
+    expect(response.setHeader).toBeCalledWith('ETag', `W/"90-${TEST_TX_HASH}-ndjson"`);
+    expect(response.setHeader).toBeCalledWith('Vary', 'Accept');
+  });
+
+  test('should answer a matching If-None-Match with 304 without running the handler', async () => {
+    const response = { setHeader: jest.fn() };
+    const request = { params: { address: TEST_ADDRESS_ALICE }, headers: { 'if-none-match': ETAG } };
+
+    await expect(underTest.intercept(getContext(request, response), next)).rejects.toThrow(NotModifiedException);
+    expect(response.setHeader).toBeCalledWith('ETag', ETAG);
+    expect(next.handle).not.toBeCalled();
+  });
+
+  test('should serve requests untagged without a version', async () => {
+    versions.getVersion.mockResolvedValue(null);
+    const response = { setHeader: jest.fn() };
+    const request = { params: { address: TEST_ADDRESS_ALICE }, headers: { 'if-none-match': ETAG } };
+
+    await underTest.intercept(getContext(request, response), next);
+    await underTest.intercept(getContext({ params: { address: 'not-an-address' } }, response), next);
+
+    expect(next.handle).toBeCalledTimes(2);
+    expect(response.setHeader).not.toBeCalled();
+    expect(versions.getVersion).toBeCalledTimes(1);
+  });
+
+  test('should compare entity tags weakly', () => {
+    expect(matchesETag(`"90-${TEST_TX_HASH}"`, ETAG)).toBe(true);
+    expect(matchesETag(`W/"89-${TEST_TX_HASH}", ${ETAG}`, ETAG)).toBe(true);
+    expect(matchesETag('*', ETAG)).toBe(true);
+    expect(matchesETag(`W/"89-${TEST_TX_HASH}"`, ETAG)).toBe(false);
+    expect(matchesETag(undefined, ETAG)).toBe(false);
+  });
+});
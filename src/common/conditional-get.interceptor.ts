@@ -0,0 +1,69 @@
+import {
+  applyDecorators,
+  CallHandler,
+  ExecutionContext,
+  Injectable,
+  NestInterceptor,
+  SetMetadata,
+  UseInterceptors,
+} from '@nestjs/common';
+import { Reflector } from '@nestjs/core';
+import { isValidAddress } from '@transia/xrpl';
+import { Observable } from 'rxjs';
+import { AccountVersionTracker, IAccountVersion } from '../xrpl/client/account-version.tracker';
+import { NotModifiedException } from '../exceptions/NotModifiedException';
+import { getStreamFormat, StreamFormat } from './stream.utils';
+
+const CONDITIONAL_GET_ACCOUNT_PARAM = 'conditionalGetAccountParam';
+
+/**
+ * Tags the responses of a read route with the version of the account named by the route parameter, the
+ * response being derived from that account's ledger state only.
+ */
+export const ConditionalGet = (accountParam: string) =>
+  applyDecorators(SetMetadata(CONDITIONAL_GET_ACCOUNT_PARAM, accountParam), UseInterceptors(ConditionalGetInterceptor));
+
+// the stream format is part of the tag, the same version is sent as a JSON array or as NDJSON
+export function formatETag({ ledgerIndex, txHash }: IAccountVersion, format = StreamFormat.JSON_ARRAY): string {
+  return format === StreamFormat.NDJSON ? `W/"${ledgerIndex}-${txHash}-ndjson"` : `W/"${ledgerIndex}-${txHash}"`;
+}
+
+// weak comparison of If-None-Match against the current tag, as required for GET
+export function matchesETag(ifNoneMatch: string | undefined, etag: string): boolean {
+  if (!ifNoneMatch) {
+    return false;
+  }
+  const opaqueTag = etag.replace(/^W\//, '');
+  return ifNoneMatch.split(',').some((tag) => tag.trim() === '*' || tag.trim().replace(/^W\//, '') === opaqueTag);
+}
+
+/**
+ * Sets the ETag before the handler runs and answers a matching If-None-Match with 304 instead of running
+ * it, so polling an unchanged account costs no request to rippled. Tagged responses vary with Accept.
+ * Without a known version the request is served untagged.
+ */
+@Injectable()
+export class ConditionalGetInterceptor implements NestInterceptor {
+  constructor(
+    private readonly reflector: Reflector,
+    private readonly versions: AccountVersionTracker
+  ) {}
+
+  async intercept(context: ExecutionContext, next: CallHandler): Promise<Observable<any>> {
+    const http = context.switchToHttp();
+    const request = http.getRequest();
+    const account = request?.params?.[this.reflector.get<string>(CONDITIONAL_GET_ACCOUNT_PARAM, context.getHandler())];
+    const version = account && isValidAddress(account) ? await this.versions.getVersion(account) : null;
+    if (!version) {
+      return next.handle();
+    }
+    const etag = formatETag(version, getStreamFormat(request.headers?.accept));
+    const response = http.getResponse();
+    response.setHeader('ETag', etag);
+    response.setHeader('Vary', 'Accept');
+    if (matchesETag(request.headers?.['if-none-match'], etag)) {
+      throw new NotModifiedException();
+    }
+    return next.handle();
+  }
+}
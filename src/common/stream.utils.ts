@@ -0,0 +1,91 @@
+import { once } from 'node:events';
+import { ServerResponse } from 'node:http';
+
+export const NDJSON_CONTENT_TYPE = 'application/x-ndjson';
+
+export enum StreamFormat {
+  JSON_ARRAY,
+  NDJSON,
+}
+
+export function getStreamFormat(accept?: string): StreamFormat {
+  return accept?.includes(NDJSON_CONTENT_TYPE) ? StreamFormat.NDJSON : StreamFormat.JSON_ARRAY;
+}
+
+/**
+ * JSON.stringify remembering its output per object, for immutable items that are streamed again and again,
+ * such as the tokens held by the URIToken ownership index: each one is serialized once, not once per request.
+ */
+export function memoizeJson<T extends object>(): (item: T) => string {
+  const serialized = new WeakMap<T, string>();
+  return (item) => {
+    let json = serialized.get(item);
+    if (json === undefined) {
+      json = JSON.stringify(item);
+      serialized.set(item, json);
+    }
+    return json;
+  };
+}
+
+/**
+ * Writes items of an async iterable to the HTTP response as they are produced, either as NDJSON or as
+ * a chunked JSON array, waiting for the socket to drain so at most one upstream page is held in memory.
+ * The first item is awaited before any header is sent, so upstream failures still reach the exception filter.
+ * Resolves with the number of bytes written to the socket.
+ */
+export async function streamJson<T>(
+  res: ServerResponse,
+  items: AsyncIterable<T>,
+  format: StreamFormat,
+  serialize: (item: T) => string = JSON.stringify
+): Promise<number> {
+  const iterator = items[Symbol.asyncIterator]();
+  let next = await iterator.next();
+
+  res.statusCode = 200;
+  res.setHeader('Content-Type', format === StreamFormat.NDJSON ? NDJSON_CONTENT_TYPE : 'application/json');
+  const [open, separator, close] = format === StreamFormat.NDJSON ? ['', '\n', '\n'] : ['[', ',', ']'];
+
+  let bytesWritten = 0;
+  let itemsWritten = 0;
+  try {
+    let chunk = open;
+    while (!next.done) {
+      chunk += (itemsWritten === 0 ? '' : separator) + serialize(next.value);
+      itemsWritten++;
+      bytesWritten += Buffer.byteLength(chunk);
+      if (!res.write(chunk) && !(await waitForDrain(res))) {
+        await iterator.return?.();
+        return bytesWritten;
+      }
+      chunk = '';
+      next = await iterator.next();
+    }
+    chunk += itemsWritten === 0 && format === StreamFormat.NDJSON ? '' : close;
+    bytesWritten += Buffer.byteLength(chunk);
+    res.end(chunk);
+  } catch (err) {
+    await iterator.return?.();
+    res.destroy(err);
+  }
+  return bytesWritten;
+}
+
+async function waitForDrain(res: ServerResponse): Promise<boolean> {
+  const controller = new AbortController();
+  try {
+    return await Promise.race([
+      once(res, 'drain', { signal: controller.signal }).then(
+        () => true,
+        () => false
+      ),
+      once(res, 'close', { signal: controller.signal }).then(
+        () => false,
+        () => false
+      ),
+    ]);
+  } finally {
+    controller.abort();
+  }
+}
@@ -0,0 +1,50 @@
+import { TimerWheel } from './timer-wheel';
+
+describe('TimerWheel unit spec', () => {
+  test('should fire timers once their due time has passed', () => {
+    const wheel = new TimerWheel<string>(1000, 0);
+    wheel.schedule('a', 5000, 'a');
+    wheel.schedule('b', 2500, 'b');
+
+    expect(wheel.advance(2000)).toEqual([]);
+    expect(wheel.advance(3000)).toEqual(['b']);
+    expect(wheel.advance(10000)).toEqual(['a']);
+    expect(wheel.size).toEqual(0);
+  });
+
+  test('should not fire cancelled or rescheduled timers at their previous due time', () => {
+    const wheel = new TimerWheel<string>(1000, 0);
+    wheel.schedule('a', 5000, 'a');
+    wheel.schedule('b', 5000, 'b');
+    wheel.schedule('b', 9000, 'b');
+
+    expect(wheel.cancel('a')).toBe(true);
+    expect(wheel.advance(5000)).toEqual([]);
+    expect(wheel.advance(9000)).toEqual(['b']);
+    expect(wheel.cancel('a')).toBe(false);
+  });
+
+  test('should fire timers scheduled in the past on the next advance', () => {
+    const wheel = new TimerWheel<string>(1000, 10000);
+    wheel.schedule('late', 3000, 'late');
+
+    expect(wheel.advance(10000)).toEqual(['late']);
+  });
+
+  test('should fire every timer at its tick across cascades and overflow', () => {
+    const slots = 4;
+    const levels = 3;
+    const wheel = new TimerWheel<number>(1, 0, slots, levels);
+    const dueTicks = Array.from({ length: 500 }, (_, i) => (i * 7919) % 300);
+    dueTicks.forEach((dueTick, i) => wheel.schedule(`${i}`, dueTick, i));
+    const cancelled = new Set([3, 42, 137]);
+    cancelled.forEach((i) => wheel.cancel(`${i}`));
+
+    for (let tick = 0; tick <= 300; tick++) {
+      const fired = wheel.advance(tick);
+      const expected = dueTicks.map((dueTick, i) => (dueTick === tick && !cancelled.has(i) ? i : -1));
+      expect(fired.sort((a, b) => a - b)).toEqual(expected.filter((i) => i >= 0));
+    }
+    expect(wheel.size).toEqual(0);
+  });
+});
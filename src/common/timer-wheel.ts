@@ -0,0 +1,130 @@
+interface ITimerEntry<T> {
+  id: string;
+  dueTick: number;
+  payload: T;
+  bucket?: Map<string, ITimerEntry<T>>;
+}
+
+/**
+ * Hierarchical timing wheel: level L has `slotsPerLevel` slots of `slotsPerLevel^L` ticks each.
+ * Schedule and cancel are O(1); a timer is moved down one level at a time when the wheel below wraps,
+ * so every timer is touched at most `levels` times before it fires.
+ */
+export class TimerWheel<T> {
+  private readonly wheels: Array<Array<Map<string, ITimerEntry<T>>>>;
+  private readonly spans: number[];
+  private readonly entries = new Map<string, ITimerEntry<T>>();
+  private readonly expired = new Map<string, ITimerEntry<T>>();
+  private readonly overflow = new Map<string, ITimerEntry<T>>();
+  private currentTick: number;
+
+  constructor(
+    private readonly tickMs: number,
+    nowMs: number,
+    private readonly slotsPerLevel = 256,
+    levels = 4
+  ) {
+    this.currentTick = this.toTick(nowMs);
+    this.spans = Array.from({ length: levels + 1 }, (_, level) => slotsPerLevel ** level);
+    this.wheels = Array.from({ length: levels }, () => Array.from({ length: slotsPerLevel }, () => new Map()));
+  }
+
+  get size(): number {
+    return this.entries.size;
+  }
+
+  has(id: string): boolean {
+    return this.entries.has(id);
+  }
+
+  /**
+   * Schedules the payload to fire at `dueMs`, replacing any timer registered under the same id.
+   * Timers already due fire on the next advance.
+   */
+  schedule(id: string, dueMs: number, payload: T) {
+    this.cancel(id);
+    const entry: ITimerEntry<T> = { id, dueTick: Math.ceil(dueMs / this.tickMs), payload };
+    this.entries.set(id, entry);
+    if (entry.dueTick <= this.currentTick) {
+      this.addTo(this.expired, entry);
+    } else {
+      this.place(entry);
+    }
+  }
+
+  cancel(id: string): boolean {
+    const entry = this.entries.get(id);
+    if (!entry) {
+      return false;
+    }
+    entry.bucket.delete(id);
+    this.entries.delete(id);
+    return true;
+  }
+
+  /**
+   * Moves the wheel forward to `nowMs` and returns the payloads of all timers that became due.
+   */
+  advance(nowMs: number): T[] {
+    const due: T[] = this.drain(this.expired);
+    const targetTick = this.toTick(nowMs);
+    if (this.entries.size === 0) {
+      this.currentTick = Math.max(this.currentTick, targetTick);
+      return due;
+    }
+    while (this.currentTick < targetTick) {
+      this.currentTick++;
+      this.cascade();
+      due.push(...this.drain(this.wheels[0][this.currentTick % this.slotsPerLevel]));
+    }
+    return due;
+  }
+
+  private cascade() {
+    const levels = this.wheels.length;
+    if (this.currentTick % this.spans[levels] === 0) {
+      this.replace(this.overflow);
+    }
+    for (let level = levels - 1; level > 0; level--) {
+      if (this.currentTick % this.spans[level] === 0) {
+        this.replace(this.wheels[level][Math.floor(this.currentTick / this.spans[level]) % this.slotsPerLevel]);
+      }
+    }
+  }
+
+  private replace(bucket: Map<string, ITimerEntry<T>>) {
+    const entries = [...bucket.values()];
+    bucket.clear();
+    entries.forEach((entry) => this.place(entry));
+  }
+
+  private place(entry: ITimerEntry<T>) {
+    const delta = entry.dueTick - this.currentTick;
+    for (let level = 0; level < this.wheels.length; level++) {
+      if (delta < this.spans[level + 1]) {
+        const slot = Math.floor(entry.dueTick / this.spans[level]) % this.slotsPerLevel;
+        this.addTo(this.wheels[level][slot], entry);
+        return;
+      }
+    }
+    this.addTo(this.overflow, entry);
+  }
+
+  private addTo(bucket: Map<string, ITimerEntry<T>>, entry: ITimerEntry<T>) {
+    entry.bucket = bucket;
+    bucket.set(entry.id, entry);
+  }
+
+  private drain(bucket: Map<string, ITimerEntry<T>>): T[] {
+    const payloads = [...bucket.values()].map((entry) => {
+      this.entries.delete(entry.id);
+      return entry.payload;
+    });
+    bucket.clear();
+    return payloads;
+  }
+
+  private toTick(ms: number): number {
+    return Math.floor(ms / this.tickMs);
+  }
+}
@@ -9,6 +9,10 @@ export class AllExceptionsFilter implements ExceptionFilter {
     const context = host.switchToHttp();
 
     const httpStatus = exception instanceof HttpException ? exception.getStatus() : HttpStatus.INTERNAL_SERVER_ERROR;
+    if (httpStatus === HttpStatus.NOT_MODIFIED) {
+      httpAdapter.reply(context.getResponse(), undefined, httpStatus);
+      return;
+    }
 
     const body = {
       statusCode: httpStatus,
@@ -0,0 +1,8 @@
+import { HttpException, HttpStatus } from '@nestjs/common';
+
+// answers a conditional GET whose validator still matches, the response carries no body
+export class NotModifiedException extends HttpException {
+  constructor() {
+    super('Not Modified', HttpStatus.NOT_MODIFIED);
+  }
+}
@@ -0,0 +1,172 @@
+import { TestBed } from '@automock/jest';
+import { HookGrantManager } from './hook-grant.manager';
+import { HookService } from './hook.service';
+import {
+  QUEUED_SUBMIT_RESPONSE,
+  SUCCESS_SUBMIT_RESPONSE,
+  TEST_ADDRESS_ALICE,
+  TEST_ADDRESS_BOB,
+  TEST_HOOK_HASH,
+  TEST_HOOK_NS,
+  TEST_SECRET,
+  TEST_TX_HASH,
+} from '../test-utils/test-utils';
+import { HOOK_GRANT_FLUSH_INTERVAL_MS } from './hook.constants';
+import { TransactionValidationTracker } from '../transactions/transaction-validation.tracker';
+import { TransactionValidationStatus } from '../transactions/transaction.constants';
+
+const TEST_ADDRESS_CAROL = 'rHb9CJAWyB4rj91VRWn96DkukG4bwdtyTh';
+const ALICE_ACCOUNT = { address: TEST_ADDRESS_ALICE, secret: TEST_SECRET };
+
+describe('HookGrantManager unit spec', () => {
+  let underTest: HookGrantManager;
+  let hookService: jest.Mocked<HookService>;
+  let tracker: jest.Mocked<TransactionValidationTracker>;
+
+  beforeEach(() => {
+    jest.useFakeTimers();
+    const { unit, unitRef } = TestBed.create(HookGrantManager)
+      .mock(HookService)
+      .using({
+        getAccountRentalHook: jest.fn().mockResolvedValue({
+          Hook: { HookHash: TEST_HOOK_HASH, HookNamespace: TEST_HOOK_NS },
+        }),
+        updateHook: jest.fn().mockResolvedValue(SUCCESS_SUBMIT_RESPONSE),
+      })
+      .mock(TransactionValidationTracker)
+      .using({
+        waitForValidation: jest.fn().mockResolvedValue({
+          status: TransactionValidationStatus.VALIDATED,
+          validatedResult: 'tesSUCCESS',
+        }),
+      })
+      .compile();
+    underTest = unit;
+    hookService = unitRef.get(HookService);
+    tracker = unitRef.get(TransactionValidationTracker);
+  });
+
+  afterEach(() => {
+    jest.useRealTimers();
+  });
+
+  test('should coalesce grants requested within one interval into a single SetHook', async () => {
+    //when
+    const results = Promise.all([
+      underTest.grant(ALICE_ACCOUNT, TEST_ADDRESS_BOB),
+      underTest.grant(ALICE_ACCOUNT, TEST_ADDRESS_CAROL),
+    ]);
+    await jest.advanceTimersByTimeAsync(HOOK_GRANT_FLUSH_INTERVAL_MS);
+    //then
+    await expect(results).resolves.toEqual([SUCCESS_SUBMIT_RESPONSE, SUCCESS_SUBMIT_RESPONSE]);
+    expect(hookService.updateHook).toBeCalledTimes(1);
+    expect(hookService.updateHook).toBeCalledWith({
+      address: TEST_ADDRESS_ALICE,
+      secret: TEST_SECRET,
+      grants: [
+        { HookGrant: { HookHash: TEST_HOOK_HASH, Authorize: TEST_ADDRESS_BOB } },
+        { HookGrant: { HookHash: TEST_HOOK_HASH, Authorize: TEST_ADDRESS_CAROL } },
+      ],
+    });
+  });
+
+  test('should revoke only the grant of the given account and keep the others', async () => {
+    //given
+    (hookService.getAccountRentalHook as jest.Mock).mockResolvedValue({
+      Hook: {
+        HookHash: TEST_HOOK_HASH,
+        HookGrants: [
+          { HookGrant: { HookHash: TEST_HOOK_HASH, Authorize: TEST_ADDRESS_BOB } },
+          { HookGrant: { HookHash: TEST_HOOK_HASH, Authorize: TEST_ADDRESS_CAROL } },
+        ],
+      },
+    });
+    //when
+    const result = underTest.revoke(ALICE_ACCOUNT, TEST_ADDRESS_BOB);
+    await jest.advanceTimersByTimeAsync(HOOK_GRANT_FLUSH_INTERVAL_MS);
+    //then
+    await expect(result).resolves.toEqual(SUCCESS_SUBMIT_RESPONSE);
+    expect(hookService.updateHook).toBeCalledWith({
+      address: TEST_ADDRESS_ALICE,
+      secret: TEST_SECRET,
+      grants: [{ HookGrant: { HookHash: TEST_HOOK_HASH, Authorize: TEST_ADDRESS_CAROL } }],
+    });
+  });
+
+  test('should skip SetHook when grant and revoke of the same account cancel out', async () => {
+    //when
+    const results = Promise.all([
+      underTest.grant(ALICE_ACCOUNT, TEST_ADDRESS_BOB),
+      underTest.revoke(ALICE_ACCOUNT, TEST_ADDRESS_BOB),
+    ]);
+    await jest.advanceTimersByTimeAsync(HOOK_GRANT_FLUSH_INTERVAL_MS);
+    //then
+    await expect(results).resolves.toEqual([null, null]);
+    expect(hookService.updateHook).not.toBeCalled();
+  });
+
+  test('should reject grants when the account has no rental hook', async () => {
+    //given
+    (hookService.getAccountRentalHook as jest.Mock).mockResolvedValue(undefined);
+    //when
+    const result = underTest.grant(ALICE_ACCOUNT, TEST_ADDRESS_BOB);
+    const assertion = expect(result).rejects.toThrow('has no rental hook installed');
+    await jest.advanceTimersByTimeAsync(HOOK_GRANT_FLUSH_INTERVAL_MS);
+    //then
+    await assertion;
+    expect(hookService.updateHook).not.toBeCalled();
+  });
+
+  test('should know the new grants only once the SetHook validates', async () => {
+    //given
+    let validate: (tracked: unknown) => void;
+    (tracker.waitForValidation as jest.Mock).mockReturnValueOnce(new Promise((resolve) => (validate = resolve)));
+    //when
+    const result = underTest.grant(ALICE_ACCOUNT, TEST_ADDRESS_BOB);
+    await jest.advanceTimersByTimeAsync(HOOK_GRANT_FLUSH_INTERVAL_MS);
+    //then
+    await expect(result).resolves.toEqual(SUCCESS_SUBMIT_RESPONSE);
+    expect(tracker.waitForValidation).toBeCalledWith(TEST_TX_HASH);
+    expect(underTest.getKnownGrants(TEST_ADDRESS_ALICE)).toEqual([]);
+    validate({ status: TransactionValidationStatus.VALIDATED, validatedResult: 'tesSUCCESS' });
+    await jest.advanceTimersByTimeAsync(0);
+    expect(underTest.getKnownGrants(TEST_ADDRESS_ALICE)).toEqual([
+      { HookGrant: { HookHash: TEST_HOOK_HASH, Authorize: TEST_ADDRESS_BOB } },
+    ]);
+  });
+
+  test('should reload the grants from the ledger when the SetHook fails validation', async () => {
+    //given
+    (tracker.waitForValidation as jest.Mock).mockResolvedValueOnce({
+      status: TransactionValidationStatus.VALIDATED,
+      validatedResult: 'tecHOOK_REJECTED',
+    });
+    underTest.grant(ALICE_ACCOUNT, TEST_ADDRESS_BOB);
+    await jest.advanceTimersByTimeAsync(HOOK_GRANT_FLUSH_INTERVAL_MS);
+    expect(underTest.getKnownGrants(TEST_ADDRESS_ALICE)).toBeUndefined();
+    //when
+    underTest.grant(ALICE_ACCOUNT, TEST_ADDRESS_CAROL);
+    await jest.advanceTimersByTimeAsync(HOOK_GRANT_FLUSH_INTERVAL_MS);
+    //then
+    expect(hookService.getAccountRentalHook).toBeCalledTimes(2);
+    expect(hookService.updateHook).toHaveBeenLastCalledWith({
+      address: TEST_ADDRESS_ALICE,
+      secret: TEST_SECRET,
+      grants: [{ HookGrant: { HookHash: TEST_HOOK_HASH, Authorize: TEST_ADDRESS_CAROL } }],
+    });
+  });
+
+  test('should wait for the validation of a SetHook held for resubmission', async () => {
+    //given
+    (hookService.updateHook as jest.Mock).mockResolvedValueOnce(QUEUED_SUBMIT_RESPONSE);
+    //when
+    const result = underTest.grant(ALICE_ACCOUNT, TEST_ADDRESS_BOB);
+    await jest.advanceTimersByTimeAsync(HOOK_GRANT_FLUSH_INTERVAL_MS);
+    //then
+    await expect(result).resolves.toEqual(QUEUED_SUBMIT_RESPONSE);
+    expect(tracker.waitForValidation).toBeCalledWith(TEST_TX_HASH);
+    expect(underTest.getKnownGrants(TEST_ADDRESS_ALICE)).toEqual([
+      { HookGrant: { HookHash: TEST_HOOK_HASH, Authorize: TEST_ADDRESS_BOB } },
+    ]);
+  });
+});
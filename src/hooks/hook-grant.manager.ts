@@ -0,0 +1,183 @@
+import { ConflictException, Injectable, Logger, UnprocessableEntityException } from '@nestjs/common';
+import { SubmitResponse } from '@transia/xrpl';
+import { HookGrant } from '@transia/xrpl/dist/npm/models/common';
+import { HookService } from './hook.service';
+import { Account } from '../account/interfaces/account.interface';
+import { HOOK_GRANT_FLUSH_INTERVAL_MS, HookGrantChangeType, MAX_HOOK_GRANTS } from './hook.constants';
+import { XRPL_RESPONSE_CODE } from '../xrpl/client/interfaces/xrpl.interface';
+import { Traced } from '../tracing/tracer';
+import { TransactionValidationTracker } from '../transactions/transaction-validation.tracker';
+import { TransactionValidationStatus } from '../transactions/transaction.constants';
+import { isSubmissionPending } from '../xrpl/client/client.service';
+
+export interface IHookGrantChange {
+  type: HookGrantChangeType;
+  account: Account;
+  authorize: string;
+}
+
+interface IPendingGrantChange extends IHookGrantChange {
+  resolve: (result: SubmitResponse | null) => void;
+  reject: (err: Error) => void;
+}
+
+interface IAccountGrantState {
+  grants?: Map<string, HookGrant>;
+  hookHash?: string;
+  pending: IPendingGrantChange[];
+  timer?: NodeJS.Timeout;
+  inFlight?: Promise<void>;
+}
+
+/**
+ * Keeps the current HookGrants of every account the service signs for and coalesces all grant changes
+ * requested within one flush interval into a single SetHook carrying the resulting grant list.
+ * Resolves with the SetHook submit response, or null when the requested changes did not alter the grant list.
+ * The known grants only take the new list once the SetHook validates, later changes of the account wait for it.
+ */
+@Injectable()
+export class HookGrantManager {
+  private readonly accounts = new Map<string, IAccountGrantState>();
+
+  constructor(
+    private readonly hookService: HookService,
+    private readonly tracker: TransactionValidationTracker
+  ) {}
+
+  @Traced()
+  grant(account: Account, authorize: string): Promise<SubmitResponse | null> {
+    return this.schedule({ type: HookGrantChangeType.GRANT, account, authorize });
+  }
+
+  @Traced()
+  revoke(account: Account, authorize: string): Promise<SubmitResponse | null> {
+    return this.schedule({ type: HookGrantChangeType.REVOKE, account, authorize });
+  }
+
+  getKnownGrants(address: string): HookGrant[] | undefined {
+    const grants = this.accounts.get(address)?.grants;
+    return grants && [...grants.values()];
+  }
+
+  private schedule(change: IHookGrantChange): Promise<SubmitResponse | null> {
+    const state = this.getState(change.account.address);
+    const result = new Promise<SubmitResponse | null>((resolve, reject) =>
+      state.pending.push({ ...change, resolve, reject })
+    );
+    this.armTimer(change.account.address, state);
+    return result;
+  }
+
+  private getState(address: string): IAccountGrantState {
+    let state = this.accounts.get(address);
+    if (!state) {
+      state = { pending: [] };
+      this.accounts.set(address, state);
+    }
+    return state;
+  }
+
+  private armTimer(address: string, state: IAccountGrantState) {
+    if (state.timer || state.inFlight) {
+      return;
+    }
+    state.timer = setTimeout(() => {
+      state.timer = undefined;
+      state.inFlight = this.flush(address, state).finally(() => {
+        state.inFlight = undefined;
+        if (state.pending.length > 0) {
+          this.armTimer(address, state);
+        }
+      });
+    }, HOOK_GRANT_FLUSH_INTERVAL_MS);
+  }
+
+  private async flush(address: string, state: IAccountGrantState): Promise<void> {
+    const batch = state.pending.splice(0, state.pending.length);
+    try {
+      await this.loadGrantsIfUnknown(address, state);
+    } catch (err) {
+      batch.forEach((change) => change.reject(err));
+      return;
+    }
+
+    const next = new Map(state.grants);
+    const applied: IPendingGrantChange[] = [];
+    for (const change of batch) {
+      if (change.type === HookGrantChangeType.REVOKE) {
+        next.delete(change.authorize);
+        applied.push(change);
+      } else if (next.has(change.authorize) || next.size < MAX_HOOK_GRANTS) {
+        next.set(change.authorize, { HookGrant: { HookHash: state.hookHash, Authorize: change.authorize } });
+        applied.push(change);
+      } else {
+        change.reject(
+          new ConflictException(`Hook of account: ${address} cannot hold more than ${MAX_HOOK_GRANTS} grants`)
+        );
+      }
+    }
+
+    if (this.isSameGrantList(state.grants, next)) {
+      applied.forEach((change) => change.resolve(null));
+      return;
+    }
+
+    const signer = applied[applied.length - 1].account;
+    Logger.log(
+      `HookGrant update of: ${address} coalesces ${applied.length} change(s), grants: ${state.grants.size} -> ${next.size}`
+    );
+    try {
+      const result: any = await this.hookService.updateHook({
+        address,
+        secret: signer.secret,
+        grants: [...next.values()],
+      });
+      applied.forEach((change) => change.resolve(result));
+      if (isSubmissionPending(result)) {
+        await this.commitOnValidation(address, state, result.tx_id ?? result.response.tx_json?.hash, next);
+      } else {
+        state.grants = undefined;
+      }
+    } catch (err) {
+      state.grants = undefined;
+      applied.forEach((change) => change.reject(err));
+    }
+  }
+
+  // a preliminary tesSUCCESS or a held SetHook can still fail to validate, any other outcome reloads the grants
+  private async commitOnValidation(
+    address: string,
+    state: IAccountGrantState,
+    hash: string | undefined,
+    next: Map<string, HookGrant>
+  ): Promise<void> {
+    const outcome = hash && (await this.tracker.waitForValidation(hash));
+    if (
+      outcome?.status === TransactionValidationStatus.VALIDATED &&
+      outcome.validatedResult === XRPL_RESPONSE_CODE.SUCCESS.valueOf()
+    ) {
+      state.grants = next;
+      return;
+    }
+    Logger.warn(`HookGrant update of: ${address} ended as: ${outcome?.validatedResult ?? outcome?.status}, reloaded`);
+    state.grants = undefined;
+  }
+
+  private async loadGrantsIfUnknown(address: string, state: IAccountGrantState): Promise<void> {
+    if (state.grants) {
+      return;
+    }
+    const hook = await this.hookService.getAccountRentalHook(address);
+    if (!hook?.Hook?.HookHash) {
+      throw new UnprocessableEntityException(`Account: ${address} has no rental hook installed`);
+    }
+    state.hookHash = hook.Hook.HookHash;
+    state.grants = new Map(
+      (hook.Hook.HookGrants || []).map((grant) => [grant.HookGrant.Authorize, grant] as [string, HookGrant])
+    );
+  }
+
+  private isSameGrantList(current: Map<string, HookGrant>, next: Map<string, HookGrant>): boolean {
+    return current.size === next.size && [...next.keys()].every((authorize) => current.has(authorize));
+  }
+}
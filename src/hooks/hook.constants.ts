@@ -12,3 +12,17 @@ export enum SetHookType {
   RESET,
   DELETE,
 }
+
+// Xahau allows up to 8 HookGrant entries on a single Hook
+export const MAX_HOOK_GRANTS = 8;
+
+// Grant changes requested within this window are coalesced into a single SetHook (roughly one ledger close)
+export const HOOK_GRANT_FLUSH_INTERVAL_MS = parseInt(process.env.HOOK_GRANT_FLUSH_INTERVAL_MS || '4000');
+
+export enum HookGrantChangeType {
+  GRANT,
+  REVOKE,
+}
+
+// Upper bound of account_namespace reads running at once while aggregating the hook states of one account
+export const HOOK_STATE_READ_CONCURRENCY = parseInt(process.env.HOOK_STATE_READ_CONCURRENCY || '4');
@@ -1,13 +1,37 @@
-import { Body, Controller, Delete, Get, Param, Post, Put, UnprocessableEntityException } from '@nestjs/common';
+import {
+  Body,
+  Controller,
+  Delete,
+  Get,
+  Headers,
+  Param,
+  Post,
+  Put,
+  Res,
+  UnprocessableEntityException,
+} from '@nestjs/common';
+import { Response } from 'express';
 import { HookService } from './hook.service';
 import { HookInputDTO, HookInstallOutputDTO } from './dto/hook-input.dto';
-import { IAccountHookOutputDto } from './dto/hook-output.dto';
 import { isValidAddress } from '@transia/xrpl';
 import { mapXRPLBaseResponseToDto } from '../common/api.utils';
+import { getStreamFormat, streamJson } from '../common/stream.utils';
+import { ConditionalGet } from '../common/conditional-get.interceptor';
+import { Counter, MetricsRegistry } from '../metrics/metrics.registry';
 
 @Controller('hook')
 export class HookController {
-  constructor(private readonly service: HookService) {}
+  private readonly stateBytesStreamed: Counter;
+
+  constructor(
+    private readonly service: HookService,
+    metrics: MetricsRegistry
+  ) {
+    this.stateBytesStreamed = metrics.counter(
+      'hook_state_response_bytes_total',
+      'Bytes of account hook states streamed to clients'
+    );
+  }
 
   @Post()
   async deployHook(@Body() inputDTO: HookInputDTO): Promise<HookInstallOutputDTO> {
@@ -28,10 +52,16 @@ export class HookController {
   }
 
   @Get(':address')
-  async accountHooks(@Param('address') address: string): Promise<IAccountHookOutputDto[]> {
+  @ConditionalGet('address')
+  async accountHooks(
+    @Param('address') address: string,
+    @Headers('accept') accept: string | undefined,
+    @Res() res: Response
+  ): Promise<void> {
     if (!isValidAddress(address)) {
       throw new UnprocessableEntityException('Account address is invalid');
     }
-    return this.service.getAccountHooksStates(address);
+    const bytes = await streamJson(res, this.service.iterateAccountHooksStates(address), getStreamFormat(accept));
+    this.stateBytesStreamed.inc({}, bytes);
   }
 }
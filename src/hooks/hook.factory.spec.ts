@@ -24,7 +24,6 @@ describe('HookTransactionFactory', () => {
       const expectedTx: SetHook = {
         Account: TEST_ADDRESS_ALICE,
         TransactionType: 'SetHook',
-        NetworkID: 21338,
         Hooks: [
           {
             Hook: {
@@ -62,7 +61,6 @@ describe('HookTransactionFactory', () => {
       const expectedTx: SetHook = {
         Account: TEST_ADDRESS_ALICE,
         TransactionType: 'SetHook',
-        NetworkID: 21338,
         Hooks: [
           {
             Hook: {
@@ -94,7 +92,6 @@ describe('HookTransactionFactory', () => {
       const expectedTx: SetHook = {
         Account: TEST_ADDRESS_ALICE,
         TransactionType: 'SetHook',
-        NetworkID: 21338,
         Hooks: [
           {
             Hook: {
@@ -118,7 +115,6 @@ describe('HookTransactionFactory', () => {
       const expectedTx: SetHook = {
         Account: TEST_ADDRESS_ALICE,
         TransactionType: 'SetHook',
-        NetworkID: 21338,
         Hooks: [
           {
             Hook: {
@@ -1,5 +1,4 @@
 import { SetHook, SetHookFlags } from '@transia/xrpl';
-import * as process from 'process';
 import { Hook, HookGrant } from '@transia/xrpl/dist/npm/models/common';
 import { HOOK_ON, SetHookType } from './hook.constants';
 import { readFileSync } from 'fs';
@@ -16,7 +15,6 @@ export class HookTransactionFactory {
     const tx_basic: SetHook = {
       Account: input.account,
       TransactionType: 'SetHook',
-      NetworkID: parseInt(process.env.NETWORK_ID || '21338'),
       Hooks: [],
     };
 
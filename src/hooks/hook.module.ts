@@ -1,11 +1,14 @@
 import { Module } from '@nestjs/common';
 import { HookController } from './hook.controller';
 import { HookService } from './hook.service';
-import { XrplService } from '../xrpl/client/client.service';
 import { HookTransactionFactory } from './hook.factory';
+import { HookGrantManager } from './hook-grant.manager';
+import { TransactionModule } from '../transactions/transaction.module';
 
 @Module({
+  imports: [TransactionModule],
   controllers: [HookController],
-  providers: [HookService, XrplService, HookTransactionFactory],
+  providers: [HookService, HookTransactionFactory, HookGrantManager],
+  exports: [HookService, HookGrantManager],
 })
 export class HookModule {}
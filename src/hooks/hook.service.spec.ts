@@ -14,6 +14,7 @@ import HookDefintion from '@transia/xrpl/dist/npm/src/models/ledger/HookDefiniti
 import { Hook } from '@transia/xrpl/dist/npm/models/common';
 import { readFileSync } from 'fs';
 import { SetHook } from '@transia/xrpl';
+import { MetricsRegistry } from '../metrics/metrics.registry';
 
 const RANDOM_TEST_HOOK_NS = 'A773305BB47E7CFAC0AC01609164DD80451F553A71F0B88F6584AC4EA60658D5';
 jest.mock('node:crypto', () => {
@@ -31,10 +32,14 @@ const mockReadFileSync = readFileSync as jest.Mock;
 describe('HookService unit spec', () => {
   let underTest: HookService;
   let xrplService: jest.Mocked<XrplService>;
+  let registry: MetricsRegistry;
   beforeAll(() => {
+    registry = new MetricsRegistry();
     const { unit, unitRef } = TestBed.create(HookService)
       .mock(XrplService)
       .using({ submitTransaction: jest.fn().mockResolvedValue({}), submitRequest: jest.fn().mockResolvedValue({}) })
+      .mock(MetricsRegistry)
+      .using({ counter: registry.counter.bind(registry) })
       .compile();
 
     underTest = unit;
@@ -49,7 +54,6 @@ describe('HookService unit spec', () => {
     const installHookTx: SetHook = {
       Account: TEST_ADDRESS_ALICE,
       TransactionType: 'SetHook',
-      NetworkID: 21338,
       Hooks: [
         {
           Hook: {
@@ -80,7 +84,6 @@ describe('HookService unit spec', () => {
     const removeHookTx: SetHook = {
       Account: TEST_ADDRESS_ALICE,
       TransactionType: 'SetHook',
-      NetworkID: 21338,
       Hooks: [
         {
           Hook: {
@@ -108,7 +111,6 @@ describe('HookService unit spec', () => {
     const removeHookTx: SetHook = {
       Account: TEST_ADDRESS_ALICE,
       TransactionType: 'SetHook',
-      NetworkID: 21338,
       Hooks: [
         {
           Hook: {
@@ -152,7 +154,6 @@ describe('HookService unit spec', () => {
     const resetHookTx: SetHook = {
       Account: TEST_ADDRESS_ALICE,
       TransactionType: 'SetHook',
-      NetworkID: 21338,
       Hooks: [
         {
           Hook: {
@@ -276,4 +277,46 @@ describe('HookService unit spec', () => {
     //then
     expect(result).toEqual(xrplLedgerResponse.result.node['Hooks']);
   });
+
+  it('should read the Hooks entry once and follow account_namespace markers', async () => {
+    //given
+    const hookStateEntry = (key: string) => ({ index: `index-${key}`, HookStateKey: key, HookStateData: '00' });
+    (xrplService.submitRequest as jest.Mock).mockClear().mockResolvedValue({
+      result: {
+        node: {
+          Hooks: [
+            { Hook: { HookNamespace: TEST_HOOK_NS, HookHash: TEST_HOOK_HASH, Flags: 0 } },
+            { Hook: { HookNamespace: RANDOM_TEST_HOOK_NS, HookHash: TEST_HOOK_HASH, Flags: 0 } },
+          ],
+        },
+      },
+    });
+    (xrplService.iterateAccountNamespace as jest.Mock).mockImplementation(async function* (_account, namespace) {
+      yield { namespace_entries: [hookStateEntry(`${namespace}-1`)], marker: 'marker' };
+      yield { namespace_entries: [hookStateEntry(`${namespace}-2`)] };
+    });
+    //when
+    const result = await underTest.getAccountHooksStates(TEST_ADDRESS_ALICE);
+    //then
+    expect(xrplService.submitRequest).toBeCalledTimes(1);
+    expect(result.map(({ hookNamespace }) => hookNamespace)).toEqual([TEST_HOOK_NS, RANDOM_TEST_HOOK_NS]);
+    expect(result[0].hookState).toEqual([
+      { index: `index-${TEST_HOOK_NS}-1`, key: `${TEST_HOOK_NS}-1`, data: '00' },
+      { index: `index-${TEST_HOOK_NS}-2`, key: `${TEST_HOOK_NS}-2`, data: '00' },
+    ]);
+    expect(registry.render()).toContain('hook_state_hooks_total 2');
+    expect(registry.render()).toContain('hook_state_namespace_pages_total 4');
+    expect(registry.render()).toContain('hook_state_entries_total 4');
+  });
+
+  it('should not read namespaces of an account without hooks', async () => {
+    //given
+    (xrplService.submitRequest as jest.Mock).mockResolvedValue({ result: { node: {} } });
+    (xrplService.iterateAccountNamespace as jest.Mock).mockClear();
+    //when
+    const result = await underTest.getAccountHooksStates(TEST_ADDRESS_ALICE);
+    //then
+    expect(result).toEqual([]);
+    expect(xrplService.iterateAccountNamespace).not.toBeCalled();
+  });
 });
@@ -6,16 +6,39 @@ import { HookInputDTO } from './dto/hook-input.dto';
 import { Hook } from '@transia/xrpl/dist/npm/models/common';
 import { StateUtility } from '@transia/hooks-toolkit';
 import HookDefintion from '@transia/xrpl/dist/npm/models/ledger/HookDefinition';
-import { SetHookType } from './hook.constants';
+import { HOOK_STATE_READ_CONCURRENCY, SetHookType } from './hook.constants';
 import { HookTransactionFactory } from './hook.factory';
 import { HookState, IAccountHookOutputDto } from './dto/hook-output.dto';
 import { BaseResponse } from '@transia/xrpl/dist/npm/models/methods/baseMethod';
-import { URITokenInputDTO } from '../rentals/dto/rental.dto';
+import { hookStateKeylet } from '../xrpl/keylet/keylet.utils';
+import { INamespaceEntry } from '../xrpl/client/interfaces/namespace.interface';
+import { ACCOUNT_NAMESPACE_PAGE_SIZE } from '../xrpl/client/client.constant';
+import { mapWithConcurrency } from '../common/concurrency.utils';
+import { Traced } from '../tracing/tracer';
+import { Counter, MetricsRegistry } from '../metrics/metrics.registry';
 
 @Injectable()
 export class HookService {
-  constructor(private readonly xrpl: XrplService) {}
+  private readonly hooksRead: Counter;
+  private readonly namespacePagesRead: Counter;
+  private readonly stateEntriesRead: Counter;
 
+  constructor(
+    private readonly xrpl: XrplService,
+    metrics: MetricsRegistry
+  ) {
+    this.hooksRead = metrics.counter('hook_state_hooks_total', 'Hooks whose state was read for account hook states');
+    this.namespacePagesRead = metrics.counter(
+      'hook_state_namespace_pages_total',
+      'account_namespace pages read for account hook states'
+    );
+    this.stateEntriesRead = metrics.counter(
+      'hook_state_entries_total',
+      'HookState entries read for account hook states'
+    );
+  }
+
+  @Traced()
   async install(input: HookInputDTO): Promise<SubmitResponse> {
     const hookNamespace = await this.getNamespaceIfExistsOrDefault(input.address);
     const installHook_tx: SetHook = await HookTransactionFactory.prepareSetHookTx({
@@ -29,25 +52,33 @@ export class HookService {
     });
   }
 
-  async getNamespaceIfExistsOrDefault(address: string): Promise<string> {
+  /**
+   * Resolves the rental hook namespace of the account, reusing the Hooks entry when the caller already read it.
+   * The HookDefinition is only looked up for a hook installed without its own namespace.
+   */
+  @Traced()
+  async getNamespaceIfExistsOrDefault(address: string, hooks?: Hook[]): Promise<string> {
+    const hook = hooks ? hooks[0] : await this.getAccountRentalHook(address);
+    if (hook === undefined) {
+      return this.generateRandomNamespace();
+    }
+    if (hook.Hook.HookNamespace !== undefined) {
+      return hook.Hook.HookNamespace;
+    }
     let hookDefinition;
-    const hook = await this.getAccountRentalHook(address);
     try {
       const client = await this.xrpl.getClient();
-      hookDefinition = await StateUtility.getHookDefinition(client, hook?.Hook?.HookHash);
+      hookDefinition = await StateUtility.getHookDefinition(client, hook.Hook.HookHash);
     } catch (err) {
       Logger.warn(err?.message);
     }
-
-    if (hook === undefined) {
-      return this.generateRandomNamespace();
-    }
-    if (this.doesAccountHaveExistingHookWithEmptyNS(hook, hookDefinition) && hookDefinition) {
+    if (hookDefinition && this.doesAccountHaveExistingHookWithEmptyNS(hook, hookDefinition)) {
       return hookDefinition.HookNamespace;
     }
     return hook.Hook.HookNamespace;
   }
 
+  @Traced()
   async remove(input: HookInputDTO): Promise<BaseResponse> {
     const removeHook_tx: SetHook = await HookTransactionFactory.prepareSetHookTx({
       type: SetHookType.DELETE,
@@ -59,6 +90,7 @@ export class HookService {
     });
   }
 
+  @Traced()
   async resetHook(input: HookInputDTO) {
     const resetHook_tx: SetHook = await HookTransactionFactory.prepareSetHookTx({
       type: SetHookType.RESET,
@@ -71,43 +103,99 @@ export class HookService {
     });
   }
 
+  @Traced()
   async getAccountHooksStates(address: string): Promise<IAccountHookOutputDto[]> {
-    const namespace = await this.getNamespaceIfExistsOrDefault(address);
-    const response = await this.getListOfHooks(address);
-    return Promise.all(
-      response
-        ?.map((hookObj: Hook) => hookObj.Hook)
-        ?.map(async (hook) => {
+    const hooksStates: IAccountHookOutputDto[] = [];
+    for await (const hookStates of this.iterateAccountHooksStates(address)) {
+      hooksStates.push(hookStates);
+    }
+    return hooksStates;
+  }
+
+  /**
+   * Single read plan for the hook states of an account: the Hooks entry is read once and shared with the
+   * namespace resolution, then the namespaces are read with bounded concurrency and yielded in hook order.
+   */
+  async *iterateAccountHooksStates(address: string): AsyncGenerator<IAccountHookOutputDto, void, undefined> {
+    const hooks = (await this.getListOfHooks(address)) || [];
+    if (hooks.length === 0) {
+      return;
+    }
+    const namespace = await this.getNamespaceIfExistsOrDefault(address, hooks);
+    this.hooksRead.inc({}, hooks.length);
+    const hooksStates = mapWithConcurrency(hooks, HOOK_STATE_READ_CONCURRENCY, async ({ Hook: hook }) => {
+      const hookNamespace = hook.HookNamespace || namespace;
+      const hookState: HookState[] = [];
+      try {
+        for await (const page of this.iterateHookNSInternalState(address, hookNamespace)) {
+          this.namespacePagesRead.inc();
+          this.stateEntriesRead.inc({}, page.length);
+          hookState.push(...page);
+        }
+      } catch (err) {
+        Logger.warn(`Hook state of namespace: ${hookNamespace} could not be read: ${err?.message}`);
+      }
+      return {
+        flags: hook.Flags,
+        hookHash: hook.HookHash,
+        hookNamespace,
+        hookGrants: hook.HookGrants?.map(({ HookGrant }) => {
           return {
-            flags: hook.Flags,
-            hookHash: hook.HookHash,
-            hookNamespace: hook.HookNamespace || namespace,
-            hookGrants: hook.HookGrants?.map(({ HookGrant }) => {
-              return {
-                hookHash: HookGrant.HookHash,
-                authorize: HookGrant.Authorize,
-              };
-            }),
-            hookState: await this.getHookNSInternalState(address, hook.HookNamespace || namespace),
+            hookHash: HookGrant.HookHash,
+            authorize: HookGrant.Authorize,
           };
-        })
-    );
+        }),
+        hookState,
+      };
+    });
+    yield* hooksStates;
   }
 
+  @Traced()
   async getHookNSInternalState(address: string, namespace: string): Promise<HookState[]> {
+    const hookState: HookState[] = [];
     try {
-      return (await this.xrpl.getAccountNamespace(address, namespace)).result.namespace_entries.map((entry) => {
-        return {
-          index: entry['index'],
-          key: entry['HookStateKey'],
-          data: entry['HookStateData'],
-        } as HookState;
-      });
+      for await (const page of this.iterateHookNSInternalState(address, namespace)) {
+        hookState.push(...page);
+      }
+      return hookState;
     } catch (err) {
       return [];
     }
   }
 
+  async *iterateHookNSInternalState(address: string, namespace: string): AsyncGenerator<HookState[], void, undefined> {
+    for await (const page of this.xrpl.iterateAccountNamespace(address, namespace, ACCOUNT_NAMESPACE_PAGE_SIZE)) {
+      yield page.namespace_entries.map((entry) => {
+        return {
+          index: entry.index,
+          key: entry.HookStateKey,
+          data: entry.HookStateData,
+        };
+      });
+    }
+  }
+
+  @Traced()
+  async getHookStateEntry(address: string, namespace: string, key: string): Promise<HookState | null> {
+    const entry = await this.xrpl.getLedgerEntryByIndex<INamespaceEntry>(hookStateKeylet(address, key, namespace));
+    if (!entry) {
+      return null;
+    }
+    return {
+      index: entry.index,
+      key: entry.HookStateKey,
+      data: entry.HookStateData,
+    };
+  }
+
+  @Traced()
+  async isURITokenInRental(address: string, uriTokenID: string): Promise<boolean> {
+    const namespace = await this.getNamespaceIfExistsOrDefault(address);
+    return !!(await this.getHookStateEntry(address, namespace, uriTokenID));
+  }
+
+  @Traced()
   async getAccountRentalHook(accountNumber: string): Promise<Hook | undefined> {
     try {
       const hooks = await this.getListOfHooks(accountNumber);
@@ -117,6 +205,7 @@ export class HookService {
     }
   }
 
+  @Traced()
   async updateHook(input: HookInputDTO): Promise<BaseResponse> {
     const hookNamespace = await this.getNamespaceIfExistsOrDefault(input.address);
     const updateHook_tx: SetHook = await HookTransactionFactory.prepareSetHookTx({
@@ -125,13 +214,14 @@ export class HookService {
       hookNamespace,
       grants: input.grants,
     });
-    console.log(updateHook_tx);
+    Logger.debug({ msg: 'SetHook update prepared', tx: updateHook_tx });
     return await this.xrpl.submitTransaction(updateHook_tx, {
       address: input.address,
       secret: input.secret,
     });
   }
 
+  @Traced()
   async getListOfHooks(account: string): Promise<Hook[]> {
     try {
       const hookReq: LedgerEntryRequest = {
@@ -147,27 +237,6 @@ export class HookService {
     }
   }
 
-  async grantAccessToHook(input: URITokenInputDTO): Promise<BaseResponse> {
-    const hook = await this.getAccountRentalHook(input.account.address);
-    const hookNamespace = await this.getNamespaceIfExistsOrDefault(input.account.address);
-    const grantHookAccessInput: HookInputDTO = {
-      address: input.account.address,
-      secret: input.account.secret,
-      grants: [
-        {
-          HookGrant: {
-            HookHash: hook.Hook.HookHash,
-            Authorize: input.destinationAccount,
-          },
-        },
-      ],
-    };
-    Logger.log(
-      `HookGrant sent by: ${input.account.address} for account: ${input.destinationAccount} to access namespace: ${hookNamespace}`
-    );
-    return await this.updateHook(grantHookAccessInput);
-  }
-
   private generateRandomNamespace() {
     const randomBytesForNS = randomBytes(32);
     const hash = createHash('sha256');
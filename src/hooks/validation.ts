@@ -1,6 +1,5 @@
 import { ArgumentMetadata, Injectable, PipeTransform, UnprocessableEntityException } from '@nestjs/common';
-import { plainToClass } from 'class-transformer';
-import { validate } from 'class-validator';
+import { getCompiledValidator } from '../common/compiled-validator';
 
 @Injectable()
 export class ValidationPipe implements PipeTransform<any> {
@@ -9,9 +8,7 @@ export class ValidationPipe implements PipeTransform<any> {
       return value;
     }
 
-    const object = plainToClass(metatype, value);
-    const errors = await validate(object);
-    if (errors.length > 0) {
+    if (!(await getCompiledValidator(metatype)(value))) {
       throw new UnprocessableEntityException('Validation failed');
     }
     return value;
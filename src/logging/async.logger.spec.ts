@@ -0,0 +1,130 @@
+import { EventEmitter } from 'node:events';
+import { Worker } from 'node:worker_threads';
+import { AsyncLogger } from './async.logger';
+
+class FakeWorker extends EventEmitter {
+  readonly received: string[] = [];
+  postMessage(chunk: string) {
+    this.received.push(chunk);
+  }
+  unref() {}
+}
+
+class TestAsyncLogger extends AsyncLogger {
+  protected readonly sampleEvery: number;
+  protected readonly bufferSize = 3;
+  protected readonly maxPendingBatches = 1;
+  protected readonly exitDrainMs = 0;
+  protected readonly workerFile: string;
+  readonly fakeWorker = new FakeWorker();
+  readonly inlineChunks: string[] = [];
+
+  constructor(level: string, { sampleEvery = 1, withWorker = false } = {}) {
+    super(level);
+    this.sampleEvery = sampleEvery;
+    this.workerFile = withWorker ? __filename : 'missing.worker.js';
+  }
+
+  records(): any[] {
+    return [...this.inlineChunks, ...this.fakeWorker.received]
+      .join('')
+      .split('\n')
+      .filter((line) => line.length > 0)
+      .map((line) => JSON.parse(line));
+  }
+
+  protected createWorker(): Worker {
+    return this.fakeWorker as unknown as Worker;
+  }
+
+  protected writeInline(chunk: string) {
+    this.inlineChunks.push(chunk);
+  }
+}
+
+describe('AsyncLogger unit spec', () => {
+  afterEach(() => {
+    jest.useRealTimers();
+  });
+
+  test('should write buffered records as JSON lines once the flush interval passes', () => {
+    jest.useFakeTimers();
+    const underTest = new TestAsyncLogger('log');
+
+    underTest.log('Request to XRPL: account_info fired', 'XrplService');
+    underTest.log({ msg: 'SetHook update prepared', tx: { TransactionType: 'SetHook' } });
+    expect(underTest.inlineChunks).toHaveLength(0);
+
+    jest.runOnlyPendingTimers();
+    expect(underTest.inlineChunks).toHaveLength(1);
+    expect(underTest.records()).toEqual([
+      expect.objectContaining({ level: 'log', context: 'XrplService', msg: 'Request to XRPL: account_info fired' }),
+      expect.objectContaining({ level: 'log', msg: 'SetHook update prepared', tx: { TransactionType: 'SetHook' } }),
+    ]);
+  });
+
+  test('should flush as soon as the buffer is full', () => {
+    const underTest = new TestAsyncLogger('log');
+
+    underTest.log('first');
+    underTest.log('second');
+    underTest.warn('third');
+
+    expect(underTest.inlineChunks).toHaveLength(1);
+    expect(underTest.records().map(({ msg }) => msg)).toEqual(['first', 'second', 'third']);
+  });
+
+  test('should skip records below the configured level', () => {
+    const underTest = new TestAsyncLogger('warn');
+
+    underTest.debug('skipped');
+    underTest.log('skipped');
+    underTest.warn('written');
+    underTest.flush();
+
+    expect(underTest.records().map(({ msg }) => msg)).toEqual(['written']);
+  });
+
+  test('should sample records below warn and keep every warning and error', () => {
+    const underTest = new TestAsyncLogger('log', { sampleEvery: 2 });
+
+    ['a', 'b', 'c', 'd'].forEach((msg) => underTest.log(msg));
+    underTest.warn('warning');
+    underTest.error('error');
+    underTest.flush();
+
+    expect(underTest.records().map(({ msg }) => msg)).toEqual(['a', 'c', 'warning', 'error']);
+  });
+
+  test('should take the stack and context of errors the way Nest passes them', () => {
+    const underTest = new TestAsyncLogger('log');
+    const err = new Error('Request failed');
+
+    underTest.error('Request failed', err.stack, 'XrplService');
+    underTest.error(err);
+    underTest.error('Request failed', 'XrplService');
+    underTest.flush();
+
+    const [withStack, fromError, withContext] = underTest.records();
+    expect(withStack).toEqual(
+      expect.objectContaining({ msg: 'Request failed', stack: err.stack, context: 'XrplService' })
+    );
+    expect(fromError).toEqual(expect.objectContaining({ msg: 'Request failed', stack: err.stack }));
+    expect(withContext).toEqual(expect.objectContaining({ context: 'XrplService' }));
+    expect(withContext.stack).toBeUndefined();
+  });
+
+  test('should hand batches to the worker and drop records below warn while it is behind', () => {
+    const underTest = new TestAsyncLogger('log', { withWorker: true });
+
+    underTest.log('written');
+    underTest.flush();
+    underTest.log('dropped');
+    underTest.error('kept');
+    underTest.flush();
+
+    expect(underTest.inlineChunks).toHaveLength(0);
+    expect(underTest.fakeWorker.received).toHaveLength(2);
+    expect(underTest.records().map(({ msg }) => msg)).toEqual(['written', 'kept']);
+  });
+});
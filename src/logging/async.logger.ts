@@ -0,0 +1,204 @@
+import { LoggerService, LogLevel } from '@nestjs/common';
+import { existsSync } from 'node:fs';
+import { join } from 'node:path';
+import { Worker } from 'node:worker_threads';
+import { ILogWorkerData } from './logging.interface';
+import {
+  LOG_BUFFER_SIZE,
+  LOG_EXIT_DRAIN_MS,
+  LOG_FLUSH_INTERVAL_MS,
+  LOG_LEVEL,
+  LOG_MAX_PENDING_BATCHES,
+  LOG_SAMPLE_RATE,
+  LOG_WORKER_FILE,
+} from './logging.constants';
+
+const LOG_LEVEL_SEVERITY: Record<LogLevel, number> = {
+  verbose: 0,
+  debug: 1,
+  log: 2,
+  warn: 3,
+  error: 4,
+  fatal: 5,
+};
+const WARN_SEVERITY = LOG_LEVEL_SEVERITY.warn;
+// what Nest passes to error() as the stack, anything else is the context
+const STACK_PATTERN = /^(.)+\n\s+at .+:\d+:\d+/;
+
+/**
+ * Nest logger writing one JSON object per line. Records are formatted when logged, buffered, and handed to a
+ * worker thread in batches which does the writing, so no request waits on stdout. Records below warn can be
+ * sampled and are dropped while the worker is behind; warnings and errors are always written, and an exiting
+ * process waits for the worker to write out what it was handed.
+ */
+export class AsyncLogger implements LoggerService {
+  protected readonly sampleEvery: number = LOG_SAMPLE_RATE > 0 ? Math.max(1, Math.round(1 / LOG_SAMPLE_RATE)) : 0;
+  protected readonly bufferSize: number = LOG_BUFFER_SIZE;
+  protected readonly flushIntervalMs: number = LOG_FLUSH_INTERVAL_MS;
+  protected readonly maxPendingBatches: number = LOG_MAX_PENDING_BATCHES;
+  protected readonly exitDrainMs: number = LOG_EXIT_DRAIN_MS;
+  protected readonly workerFile: string = join(__dirname, LOG_WORKER_FILE);
+  private readonly minSeverity: number;
+  private readonly written = new Int32Array(new SharedArrayBuffer(4));
+  private lines: string[] = [];
+  private severities: number[] = [];
+  private timer?: NodeJS.Timeout;
+  private worker?: Worker;
+  private inline?: boolean;
+  private posted = 0;
+  private seen = 0;
+  private dropped = 0;
+
+  constructor(level: string = LOG_LEVEL) {
+    this.minSeverity = LOG_LEVEL_SEVERITY[level as LogLevel] ?? LOG_LEVEL_SEVERITY.log;
+  }
+
+  log(message: any, ...optionalParams: any[]) {
+    this.write('log', message, optionalParams);
+  }
+
+  error(message: any, ...optionalParams: any[]) {
+    this.write('error', message, optionalParams);
+  }
+
+  warn(message: any, ...optionalParams: any[]) {
+    this.write('warn', message, optionalParams);
+  }
+
+  debug(message: any, ...optionalParams: any[]) {
+    this.write('debug', message, optionalParams);
+  }
+
+  verbose(message: any, ...optionalParams: any[]) {
+    this.write('verbose', message, optionalParams);
+  }
+
+  fatal(message: any, ...optionalParams: any[]) {
+    this.write('fatal', message, optionalParams);
+  }
+
+  flush() {
+    clearTimeout(this.timer);
+    this.timer = undefined;
+    if (this.lines.length === 0) {
+      return;
+    }
+    let lines = this.lines;
+    const severities = this.severities;
+    this.lines = [];
+    this.severities = [];
+    if (this.isBehind()) {
+      const kept = lines.filter((_, i) => severities[i] >= WARN_SEVERITY);
+      this.dropped += lines.length - kept.length;
+      lines = kept;
+    } else if (this.dropped > 0) {
+      lines.unshift(this.format('warn', { msg: `${this.dropped} log records dropped, the log worker was behind` }));
+      this.dropped = 0;
+    }
+    if (lines.length > 0) {
+      this.send(lines.join('\n') + '\n');
+    }
+  }
+
+  // synchronous, it runs on process exit where nothing asynchronous gets to finish
+  drain() {
+    this.flush();
+    const deadline = Date.now() + this.exitDrainMs;
+    let written = Atomics.load(this.written, 0);
+    while (this.worker && written < this.posted && Date.now() < deadline) {
+      Atomics.wait(this.written, 0, written, deadline - Date.now());
+      written = Atomics.load(this.written, 0);
+    }
+  }
+
+  protected createWorker(): Worker {
+    const workerData: ILogWorkerData = { written: this.written.buffer as SharedArrayBuffer };
+    return new Worker(this.workerFile, { workerData });
+  }
+
+  protected writeInline(chunk: string) {
+    process.stdout.write(chunk);
+  }
+
+  private write(level: LogLevel, message: unknown, optionalParams: unknown[]) {
+    const severity = LOG_LEVEL_SEVERITY[level];
+    if (severity < this.minSeverity || (severity < WARN_SEVERITY && !this.isSampled())) {
+      return;
+    }
+    const params = [...optionalParams];
+    let stack: string | undefined;
+    if (severity > WARN_SEVERITY && typeof params[0] === 'string' && STACK_PATTERN.test(params[0])) {
+      stack = params.shift() as string;
+    }
+    const context = typeof params[params.length - 1] === 'string' ? (params.pop() as string) : undefined;
+    this.lines.push(this.format(level, this.toFields(message, stack), context));
+    this.severities.push(severity);
+    if (this.lines.length >= this.bufferSize) {
+      this.flush();
+    } else if (!this.timer) {
+      this.timer = setTimeout(() => this.flush(), this.flushIntervalMs);
+      this.timer.unref();
+    }
+  }
+
+  private isSampled(): boolean {
+    return this.sampleEvery > 0 && this.seen++ % this.sampleEvery === 0;
+  }
+
+  private toFields(message: unknown, stack?: string): object {
+    if (message instanceof Error) {
+      return { msg: message.message, stack: stack ?? message.stack };
+    }
+    if (typeof message === 'object' && message !== null) {
+      return stack ? { ...message, stack } : message;
+    }
+    return stack ? { msg: String(message), stack } : { msg: String(message) };
+  }
+
+  private format(level: LogLevel, fields: object, context?: string): string {
+    const record = { time: new Date().toISOString(), level, pid: process.pid, context };
+    try {
+      return JSON.stringify({ ...record, ...fields });
+    } catch (err) {
+      return JSON.stringify({ ...record, msg: `Unserializable log record: ${err?.message}` });
+    }
+  }
+
+  private isBehind(): boolean {
+    return !!this.worker && this.posted - Atomics.load(this.written, 0) >= this.maxPendingBatches;
+  }
+
+  private send(chunk: string) {
+    const worker = this.getWorker();
+    if (!worker) {
+      this.writeInline(chunk);
+      return;
+    }
+    this.posted++;
+    worker.postMessage(chunk);
+  }
+
+  // sources run through ts-node or jest have no compiled worker next to them
+  private getWorker(): Worker | undefined {
+    if (this.inline === undefined) {
+      this.inline = !existsSync(this.workerFile);
+      if (!this.inline) {
+        this.startWorker();
+      }
+    }
+    return this.worker;
+  }
+
+  private startWorker() {
+    const onExit = () => this.drain();
+    this.worker = this.createWorker();
+    this.worker.unref();
+    this.worker.on('error', (err) => {
+      this.worker = undefined;
+      this.inline = true;
+      process.off('exit', onExit);
+      this.writeInline(this.format('error', { msg: `Log worker failed, writing on the main thread: ${err?.message}` }));
+    });
+    process.on('exit', onExit);
+  }
+}
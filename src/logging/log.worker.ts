@@ -0,0 +1,32 @@
+import { writeSync } from 'node:fs';
+import { parentPort, workerData } from 'node:worker_threads';
+import { ILogWorkerData } from './logging.interface';
+
+const STDOUT_FD = 1;
+const written = new Int32Array((workerData as ILogWorkerData).written);
+const pause = new Int32Array(new SharedArrayBuffer(4));
+
+// stdout may be a non-blocking pipe, a full pipe is retried until the reader catches up
+function writeAll(chunk: string) {
+  const buffer = Buffer.from(chunk);
+  let offset = 0;
+  while (offset < buffer.length) {
+    try {
+      offset += writeSync(STDOUT_FD, buffer, offset);
+    } catch (err) {
+      if (err?.code !== 'EAGAIN') {
+        throw err;
+      }
+      Atomics.wait(pause, 0, 0, 1);
+    }
+  }
+}
+
+parentPort.on('message', (chunk: string) => {
+  try {
+    writeAll(chunk);
+  } finally {
+    Atomics.add(written, 0, 1);
+    Atomics.notify(written, 0);
+  }
+});
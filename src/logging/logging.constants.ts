@@ -0,0 +1,18 @@
+// lowest level written: 'verbose', 'debug', 'log', 'warn', 'error' or 'fatal'
+export const LOG_LEVEL = process.env.LOG_LEVEL || 'log';
+
+// share of records below warn that is written, 0.1 keeps every 10th; warnings and errors are never sampled
+export const LOG_SAMPLE_RATE = parseFloat(process.env.LOG_SAMPLE_RATE || '1');
+
+// records are handed to the log worker in batches, on this interval or once the buffer is full
+export const LOG_FLUSH_INTERVAL_MS = parseInt(process.env.LOG_FLUSH_INTERVAL_MS || '100');
+export const LOG_BUFFER_SIZE = parseInt(process.env.LOG_BUFFER_SIZE || '1024');
+
+// batches the worker may have outstanding before records below warn are dropped
+export const LOG_MAX_PENDING_BATCHES = parseInt(process.env.LOG_MAX_PENDING_BATCHES || '64');
+
+// how long an exiting process waits for the worker to write out the outstanding batches
+export const LOG_EXIT_DRAIN_MS = parseInt(process.env.LOG_EXIT_DRAIN_MS || '2000');
+
+// compiled next to this file by nest build
+export const LOG_WORKER_FILE = 'log.worker.js';
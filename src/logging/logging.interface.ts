@@ -0,0 +1,4 @@
+export interface ILogWorkerData {
+  // Int32Array counting the batches written, the main thread waits on it before exiting
+  written: SharedArrayBuffer;
+}
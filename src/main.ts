@@ -1,17 +1,35 @@
-import { HttpAdapterHost, NestFactory } from '@nestjs/core';
-import { AppModule } from './app.module';
-import { ValidationPipe } from './hooks/validation';
-import { AllExceptionsFilter } from './exceptions/AllExceptionsFilter';
 import { DocumentBuilder, SwaggerModule } from '@nestjs/swagger';
-import { INestApplication } from '@nestjs/common';
+import { INestApplication, Logger } from '@nestjs/common';
+import { createApp } from './app.factory';
+import { HTTP_PORT } from './app.constants';
+import { AsyncLogger } from './logging/async.logger';
+import { ClusterSupervisor } from './cluster/cluster.supervisor';
+import {
+  CLUSTER_WORKER_INDEX,
+  CLUSTER_WORKER_PORT_BASE,
+  CLUSTER_WORKERS,
+  WORKER_LISTENING_MESSAGE,
+} from './cluster/cluster.constants';
 
 async function bootstrap() {
-  const app = await NestFactory.create(AppModule);
-  app.useGlobalPipes(new ValidationPipe());
-  const httpAdapterHost = app.get(HttpAdapterHost);
-  app.useGlobalFilters(new AllExceptionsFilter(httpAdapterHost));
+  // the front process of the cluster mode only routes, it runs none of the application modules
+  if (CLUSTER_WORKERS > 0 && CLUSTER_WORKER_INDEX === undefined) {
+    Logger.overrideLogger(new AsyncLogger());
+    const supervisor = new ClusterSupervisor();
+    ['SIGINT', 'SIGTERM'].forEach((signal) =>
+      process.once(signal, () => supervisor.stop().then(() => process.exit(0)))
+    );
+    await supervisor.start(HTTP_PORT);
+    return;
+  }
+  const app = await createApp({ logger: new AsyncLogger() });
   configSwagger(app);
-  await app.listen(3000);
+  if (CLUSTER_WORKER_INDEX !== undefined) {
+    await app.listen(CLUSTER_WORKER_PORT_BASE + parseInt(CLUSTER_WORKER_INDEX), '127.0.0.1');
+    process.send?.(WORKER_LISTENING_MESSAGE);
+    return;
+  }
+  await app.listen(HTTP_PORT);
 }
 
 function configSwagger(app: INestApplication<any>) {
@@ -0,0 +1,36 @@
+import { CallHandler, ExecutionContext, HttpException, Injectable, NestInterceptor } from '@nestjs/common';
+import { Observable, tap } from 'rxjs';
+import { Histogram, MetricsRegistry } from './metrics.registry';
+import { UNMATCHED_ROUTE } from './metrics.constants';
+
+/**
+ * Records the latency of every HTTP request labelled by the route template rather than the concrete path,
+ * so addresses and hashes in the URL do not create a series each.
+ */
+@Injectable()
+export class HttpMetricsInterceptor implements NestInterceptor {
+  private readonly duration: Histogram;
+
+  constructor(registry: MetricsRegistry) {
+    this.duration = registry.histogram('http_request_duration_seconds', 'HTTP request latency by route', [
+      'method',
+      'route',
+      'status',
+    ]);
+  }
+
+  intercept(context: ExecutionContext, next: CallHandler): Observable<any> {
+    const http = context.switchToHttp();
+    const request = http.getRequest();
+    const stopTimer = this.duration.startTimer({
+      method: request?.method,
+      route: request?.route?.path ?? UNMATCHED_ROUTE,
+    });
+    return next.handle().pipe(
+      tap({
+        complete: () => stopTimer({ status: http.getResponse()?.statusCode }),
+        error: (err) => stopTimer({ status: err instanceof HttpException ? err.getStatus() : 500 }),
+      })
+    );
+  }
+}
@@ -0,0 +1,8 @@
+// histogram upper bounds in seconds, from a local read up to a transaction validated several ledgers later
+export const LATENCY_BUCKETS_SECONDS = [0.005, 0.01, 0.025, 0.05, 0.1, 0.25, 0.5, 1, 2.5, 5, 10, 30, 60];
+
+// Prometheus text exposition format
+export const METRICS_CONTENT_TYPE = 'text/plain; version=0.0.4; charset=utf-8';
+
+// route label of requests matching no controller, keeps probes of random paths from adding series
+export const UNMATCHED_ROUTE = 'unmatched';
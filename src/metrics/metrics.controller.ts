@@ -0,0 +1,14 @@
+import { Controller, Get, Header } from '@nestjs/common';
+import { MetricsRegistry } from './metrics.registry';
+import { METRICS_CONTENT_TYPE } from './metrics.constants';
+
+@Controller('metrics')
+export class MetricsController {
+  constructor(private readonly registry: MetricsRegistry) {}
+
+  @Get()
+  @Header('Content-Type', METRICS_CONTENT_TYPE)
+  metrics(): string {
+    return this.registry.render();
+  }
+}
@@ -0,0 +1,13 @@
+import { Global, Module } from '@nestjs/common';
+import { APP_INTERCEPTOR } from '@nestjs/core';
+import { MetricsController } from './metrics.controller';
+import { MetricsRegistry } from './metrics.registry';
+import { HttpMetricsInterceptor } from './http-metrics.interceptor';
+
+@Global()
+@Module({
+  controllers: [MetricsController],
+  providers: [MetricsRegistry, { provide: APP_INTERCEPTOR, useClass: HttpMetricsInterceptor }],
+  exports: [MetricsRegistry],
+})
+export class MetricsModule {}
@@ -0,0 +1,54 @@
+import { MetricsRegistry } from './metrics.registry';
+
+describe('MetricsRegistry unit spec', () => {
+  let underTest: MetricsRegistry;
+
+  beforeEach(() => {
+    underTest = new MetricsRegistry();
+  });
+
+  test('should render counters per label set with escaped label values', () => {
+    const counter = underTest.counter('xrpl_engine_results_total', 'Preliminary results', ['engine_result']);
+    counter.inc({ engine_result: 'tesSUCCESS' });
+    counter.inc({ engine_result: 'tesSUCCESS' });
+    counter.inc({ engine_result: 'a"b' });
+
+    expect(underTest.render()).toEqual(
+      [
+        '# HELP xrpl_engine_results_total Preliminary results',
+        '# TYPE xrpl_engine_results_total counter',
+        'xrpl_engine_results_total{engine_result="tesSUCCESS"} 2',
+        'xrpl_engine_results_total{engine_result="a\\"b"} 1',
+        '',
+      ].join('\n')
+    );
+  });
+
+  test('should render cumulative histogram buckets with sum and count', () => {
+    const histogram = underTest.histogram('xrpl_request_duration_seconds', 'Latency', ['command'], [0.1, 1]);
+    histogram.observe({ command: 'submit' }, 0.05);
+    histogram.observe({ command: 'submit' }, 0.5);
+    histogram.observe({ command: 'submit' }, 5);
+
+    const rendered = underTest.render();
+
+    expect(rendered).toContain('xrpl_request_duration_seconds_bucket{command="submit",le="0.1"} 1');
+    expect(rendered).toContain('xrpl_request_duration_seconds_bucket{command="submit",le="1"} 2');
+    expect(rendered).toContain('xrpl_request_duration_seconds_bucket{command="submit",le="+Inf"} 3');
+    expect(rendered).toContain('xrpl_request_duration_seconds_sum{command="submit"} 5.55');
+    expect(rendered).toContain('xrpl_request_duration_seconds_count{command="submit"} 3');
+  });
+
+  test('should sample gauges on render', () => {
+    let queued = 1;
+    underTest.gauge('xrpl_submission_queue', 'Queued', [], (gauge) => gauge.set({}, queued));
+
+    expect(underTest.render()).toContain('xrpl_submission_queue 1');
+    queued = 4;
+    expect(underTest.render()).toContain('xrpl_submission_queue 4');
+  });
+
+  test('should return the metric already registered under a name', () => {
+    expect(underTest.counter('requests_total', 'Requests')).toBe(underTest.counter('requests_total', 'Requests'));
+  });
+});
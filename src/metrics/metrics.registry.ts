@@ -0,0 +1,166 @@
+import { Injectable } from '@nestjs/common';
+import { LATENCY_BUCKETS_SECONDS } from './metrics.constants';
+
+type MetricType = 'counter' | 'gauge' | 'histogram';
+export type MetricLabels = Record<string, string | number>;
+
+abstract class Metric<S> {
+  protected readonly series = new Map<string, { labels: string[]; value: S }>();
+
+  constructor(
+    readonly name: string,
+    readonly help: string,
+    readonly type: MetricType,
+    protected readonly labelNames: string[]
+  ) {}
+
+  render(): string[] {
+    const lines = [`# HELP ${this.name} ${escapeHelp(this.help)}`, `# TYPE ${this.name} ${this.type}`];
+    this.series.forEach(({ labels, value }) => lines.push(...this.renderSeries(labels, value)));
+    return lines;
+  }
+
+  protected abstract initialValue(): S;
+
+  protected abstract renderSeries(labels: string[], value: S): string[];
+
+  protected getSeries(labels: MetricLabels): { labels: string[]; value: S } {
+    const values = this.labelNames.map((name) => String(labels[name] ?? ''));
+    const key = values.join('\u0000');
+    let entry = this.series.get(key);
+    if (!entry) {
+      entry = { labels: values, value: this.initialValue() };
+      this.series.set(key, entry);
+    }
+    return entry;
+  }
+
+  protected formatLabels(values: string[], extra: string[] = []): string {
+    const pairs = this.labelNames.map((name, i) => `${name}="${escapeLabelValue(values[i])}"`).concat(extra);
+    return pairs.length === 0 ? '' : `{${pairs.join(',')}}`;
+  }
+}
+
+export class Counter extends Metric<number> {
+  inc(labels: MetricLabels = {}, value = 1) {
+    this.getSeries(labels).value += value;
+  }
+
+  protected initialValue(): number {
+    return 0;
+  }
+
+  protected renderSeries(labels: string[], value: number): string[] {
+    return [`${this.name}${this.formatLabels(labels)} ${value}`];
+  }
+}
+
+export class Gauge extends Metric<number> {
+  constructor(name: string, help: string, labelNames: string[], private readonly collect?: (gauge: Gauge) => void) {
+    super(name, help, 'gauge', labelNames);
+  }
+
+  set(labels: MetricLabels, value: number) {
+    this.getSeries(labels).value = value;
+  }
+
+  render(): string[] {
+    this.collect?.(this);
+    return super.render();
+  }
+
+  protected initialValue(): number {
+    return 0;
+  }
+
+  protected renderSeries(labels: string[], value: number): string[] {
+    return [`${this.name}${this.formatLabels(labels)} ${value}`];
+  }
+}
+
+interface IHistogramValue {
+  buckets: number[];
+  sum: number;
+  count: number;
+}
+
+export class Histogram extends Metric<IHistogramValue> {
+  constructor(name: string, help: string, labelNames: string[], private readonly bounds: number[]) {
+    super(name, help, 'histogram', labelNames);
+  }
+
+  observe(labels: MetricLabels, value: number) {
+    const series = this.getSeries(labels).value;
+    const index = this.bounds.findIndex((bound) => value <= bound);
+    if (index !== -1) {
+      series.buckets[index]++;
+    }
+    series.sum += value;
+    series.count++;
+  }
+
+  // starts a timer, the returned function records the seconds elapsed
+  startTimer(labels: MetricLabels = {}): (extraLabels?: MetricLabels) => void {
+    const start = process.hrtime.bigint();
+    return (extraLabels = {}) =>
+      this.observe({ ...labels, ...extraLabels }, Number(process.hrtime.bigint() - start) / 1e9);
+  }
+
+  protected initialValue(): IHistogramValue {
+    return { buckets: this.bounds.map(() => 0), sum: 0, count: 0 };
+  }
+
+  protected renderSeries(labels: string[], value: IHistogramValue): string[] {
+    let cumulative = 0;
+    const lines = this.bounds.map((bound, i) => {
+      cumulative += value.buckets[i];
+      return `${this.name}_bucket${this.formatLabels(labels, [`le="${bound}"`])} ${cumulative}`;
+    });
+    lines.push(`${this.name}_bucket${this.formatLabels(labels, ['le="+Inf"'])} ${value.count}`);
+    lines.push(`${this.name}_sum${this.formatLabels(labels)} ${value.sum}`);
+    lines.push(`${this.name}_count${this.formatLabels(labels)} ${value.count}`);
+    return lines;
+  }
+}
+
+/**
+ * In-process registry rendered in the Prometheus text format. Registering a metric a second time under the
+ * same name returns the existing one, so providers can declare what they record in their constructors.
+ */
+@Injectable()
+export class MetricsRegistry {
+  private readonly metrics = new Map<string, Metric<unknown>>();
+
+  counter(name: string, help: string, labelNames: string[] = []): Counter {
+    return this.register(name, () => new Counter(name, help, 'counter', labelNames));
+  }
+
+  gauge(name: string, help: string, labelNames: string[] = [], collect?: (gauge: Gauge) => void): Gauge {
+    return this.register(name, () => new Gauge(name, help, labelNames, collect));
+  }
+
+  histogram(name: string, help: string, labelNames: string[] = [], buckets = LATENCY_BUCKETS_SECONDS): Histogram {
+    return this.register(name, () => new Histogram(name, help, labelNames, buckets));
+  }
+
+  render(): string {
+    const lines: string[] = [];
+    this.metrics.forEach((metric) => lines.push(...metric.render()));
+    return lines.join('\n') + '\n';
+  }
+
+  private register<M extends Metric<unknown>>(name: string, create: () => M): M {
+    if (!this.metrics.has(name)) {
+      this.metrics.set(name, create());
+    }
+    return this.metrics.get(name) as M;
+  }
+}
+
+function escapeHelp(help: string): string {
+  return help.replace(/\\/g, '\\\\').replace(/\n/g, '\\n');
+}
+
+function escapeLabelValue(value: string): string {
+  return value.replace(/\\/g, '\\\\').replace(/"/g, '\\"').replace(/\n/g, '\\n');
+}
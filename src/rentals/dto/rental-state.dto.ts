@@ -0,0 +1,14 @@
+import { URITokenCreateSellOffer } from '@transia/xrpl';
+
+export class RentalStateOutputDTO {
+  uriTokenID: string;
+  lender: string;
+  renter: string;
+  deadline: string;
+  amount?: string;
+}
+
+export class RentalReturnOutputDTO extends RentalStateOutputDTO {
+  // unsigned return sell offer, to be signed and submitted by the renter
+  tx: URITokenCreateSellOffer;
+}
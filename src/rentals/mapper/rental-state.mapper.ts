@@ -0,0 +1,21 @@
+import { RentalReturnOutputDTO, RentalStateOutputDTO } from '../dto/rental-state.dto';
+import { IRentalRecord } from '../rental-state.projector';
+import { IPreparedRentalReturn } from '../rental-expiry.scheduler';
+
+export const RentalStateMapper = {
+  mapRentalToDto: (rental: IRentalRecord): RentalStateOutputDTO => {
+    return {
+      uriTokenID: rental.uriTokenID,
+      lender: rental.lender,
+      renter: rental.renter,
+      deadline: new Date(rental.deadline * 1000).toISOString(),
+      amount: rental.amount,
+    };
+  },
+  mapPreparedReturnToDto: (preparedReturn: IPreparedRentalReturn): RentalReturnOutputDTO => {
+    return {
+      ...RentalStateMapper.mapRentalToDto(preparedReturn.rental),
+      tx: preparedReturn.tx,
+    };
+  },
+};
@@ -0,0 +1,90 @@
+import { TestBed } from '@automock/jest';
+import { Subject } from 'rxjs';
+import { RentalExpiryScheduler } from './rental-expiry.scheduler';
+import { IRentalChange, IRentalRecord, RentalStateProjector } from './rental-state.projector';
+import { RentalsTransactionFactory } from './rentals.transactionFactory';
+import { TEST_ADDRESS_ALICE, TEST_ADDRESS_BOB, TEST_URI_INDEX } from '../test-utils/test-utils';
+
+const NOW_MS = Date.now();
+const DEADLINE = Math.floor(NOW_MS / 1000) + 60;
+
+describe('RentalExpiryScheduler unit spec', () => {
+  let underTest: RentalExpiryScheduler;
+  let transactionFactory: jest.Mocked<RentalsTransactionFactory>;
+  const rentals = new Map<string, IRentalRecord>();
+  const changes$ = new Subject<IRentalChange>();
+  const rental: IRentalRecord = {
+    uriTokenID: TEST_URI_INDEX,
+    lender: TEST_ADDRESS_ALICE,
+    renter: TEST_ADDRESS_BOB,
+    deadline: DEADLINE,
+    amount: '600000000',
+  };
+  const upsert = (record: IRentalRecord) => {
+    rentals.set(record.uriTokenID, record);
+    changes$.next({ type: 'upsert', rental: record });
+  };
+
+  beforeEach(() => {
+    rentals.clear();
+    const { unit, unitRef } = TestBed.create(RentalExpiryScheduler)
+      .mock(RentalStateProjector)
+      .using({
+        changes$: changes$.asObservable(),
+        getAll: jest.fn(() => [...rentals.values()]),
+        getRental: jest.fn((uriTokenID: string) => rentals.get(uriTokenID)),
+      })
+      .mock(RentalsTransactionFactory)
+      .using({
+        prepareSellOfferTxForFinish: jest.fn().mockResolvedValue({ TransactionType: 'URITokenCreateSellOffer' }),
+      })
+      .compile();
+    underTest = unit;
+    transactionFactory = unitRef.get(RentalsTransactionFactory);
+    underTest.onModuleInit();
+  });
+
+  afterEach(() => {
+    underTest.onModuleDestroy();
+  });
+
+  test('should prepare the return offer from renter to lender once the deadline has passed', async () => {
+    upsert(rental);
+
+    await underTest.tick(NOW_MS);
+    expect(transactionFactory.prepareSellOfferTxForFinish).not.toBeCalled();
+
+    await underTest.tick(DEADLINE * 1000);
+    expect(transactionFactory.prepareSellOfferTxForFinish).toBeCalledWith(
+      expect.objectContaining({
+        account: { address: TEST_ADDRESS_BOB, secret: undefined },
+        destinationAccount: TEST_ADDRESS_ALICE,
+        uri: TEST_URI_INDEX,
+        totalAmount: 0,
+      })
+    );
+    expect(underTest.getPreparedReturns()).toEqual([{ rental, tx: { TransactionType: 'URITokenCreateSellOffer' } }]);
+    expect(underTest.getPendingCount()).toEqual(0);
+  });
+
+  test('should not prepare the return of a rental finished before its deadline', async () => {
+    upsert(rental);
+    rentals.delete(rental.uriTokenID);
+    changes$.next({ type: 'remove', rental });
+
+    await underTest.tick(DEADLINE * 1000);
+
+    expect(transactionFactory.prepareSellOfferTxForFinish).not.toBeCalled();
+    expect(underTest.getPendingCount()).toEqual(0);
+  });
+
+  test('should schedule rentals already present in the rental state view on startup', async () => {
+    rentals.set(rental.uriTokenID, rental);
+    underTest.onModuleDestroy();
+    underTest.onModuleInit();
+
+    await underTest.tick(DEADLINE * 1000);
+
+    expect(transactionFactory.prepareSellOfferTxForFinish).toBeCalledTimes(1);
+  });
+});
@@ -0,0 +1,103 @@
+import { Injectable, Logger, OnModuleDestroy, OnModuleInit } from '@nestjs/common';
+import { URITokenCreateSellOffer } from '@transia/xrpl';
+import { Subscription } from 'rxjs';
+import { TimerWheel } from '../common/timer-wheel';
+import { RentalType } from '../uriToken/uri-token.constant';
+import { IRentalChange, IRentalRecord, RentalStateProjector } from './rental-state.projector';
+import { RentalsTransactionFactory } from './rentals.transactionFactory';
+import { RENTAL_EXPIRY_TICK_MS } from './retnals.constants';
+
+export interface IPreparedRentalReturn {
+  rental: IRentalRecord;
+  tx: URITokenCreateSellOffer;
+}
+
+/**
+ * Keeps every active rental deadline in a timer wheel fed by the rental state view, so it is rebuilt from
+ * hook state on restart, and prepares the return sell offer of a rental once its deadline has passed.
+ * The service holds no renter secrets: prepared offers are kept until the return buy removes the rental.
+ */
+@Injectable()
+export class RentalExpiryScheduler implements OnModuleInit, OnModuleDestroy {
+  private readonly wheel = new TimerWheel<string>(RENTAL_EXPIRY_TICK_MS, Date.now());
+  private readonly preparedReturns = new Map<string, IPreparedRentalReturn>();
+  private subscription?: Subscription;
+  private timer?: NodeJS.Timeout;
+  private isTicking = false;
+
+  constructor(
+    private readonly projector: RentalStateProjector,
+    private readonly transactionFactory: RentalsTransactionFactory
+  ) {}
+
+  onModuleInit() {
+    this.projector.getAll().forEach((rental) => this.schedule(rental));
+    this.subscription = this.projector.changes$.subscribe((change) => this.applyChange(change));
+    this.timer = setInterval(() => this.tick(Date.now()), RENTAL_EXPIRY_TICK_MS);
+    this.timer.unref();
+  }
+
+  onModuleDestroy() {
+    this.subscription?.unsubscribe();
+    clearInterval(this.timer);
+  }
+
+  getPendingCount(): number {
+    return this.wheel.size;
+  }
+
+  getPreparedReturns(): IPreparedRentalReturn[] {
+    return [...this.preparedReturns.values()];
+  }
+
+  async tick(nowMs: number): Promise<void> {
+    // a slow tick is not overlapped, the next one advances the wheel over every tick it missed
+    if (this.isTicking) {
+      return;
+    }
+    this.isTicking = true;
+    try {
+      for (const uriTokenID of this.wheel.advance(nowMs)) {
+        await this.prepareReturn(uriTokenID, nowMs);
+      }
+    } finally {
+      this.isTicking = false;
+    }
+  }
+
+  private applyChange(change: IRentalChange) {
+    if (change.type === 'upsert') {
+      this.schedule(change.rental);
+      return;
+    }
+    this.wheel.cancel(change.rental.uriTokenID);
+    this.preparedReturns.delete(change.rental.uriTokenID);
+  }
+
+  private schedule(rental: IRentalRecord) {
+    this.preparedReturns.delete(rental.uriTokenID);
+    this.wheel.schedule(rental.uriTokenID, rental.deadline * 1000, rental.uriTokenID);
+  }
+
+  private async prepareReturn(uriTokenID: string, nowMs: number) {
+    // the view may have been rebuilt since the timer was scheduled
+    const rental = this.projector.getRental(uriTokenID);
+    if (!rental || rental.deadline * 1000 > nowMs || !rental.lender) {
+      return;
+    }
+    try {
+      const tx = await this.transactionFactory.prepareSellOfferTxForFinish({
+        account: { address: rental.renter, secret: undefined },
+        destinationAccount: rental.lender,
+        uri: uriTokenID,
+        deadline: new Date(rental.deadline * 1000).toISOString(),
+        totalAmount: 0,
+        rentalType: RentalType.COLLATERAL_FREE,
+      });
+      this.preparedReturns.set(uriTokenID, { rental, tx });
+      Logger.log(`Rental of URIToken: ${uriTokenID} expired, return offer to: ${rental.lender} prepared`);
+    } catch (err) {
+      Logger.error(`Return offer preparation of URIToken: ${uriTokenID} failed: ${err?.message}`);
+    }
+  }
+}
@@ -0,0 +1,47 @@
+import { Controller, Get, Param, Query, UnprocessableEntityException } from '@nestjs/common';
+import { isValidAddress } from '@transia/xrpl';
+import { RentalStateProjector } from './rental-state.projector';
+import { RentalReturnOutputDTO, RentalStateOutputDTO } from './dto/rental-state.dto';
+import { RentalStateMapper } from './mapper/rental-state.mapper';
+import { RentalExpiryScheduler } from './rental-expiry.scheduler';
+
+@Controller('rentals')
+export class RentalStateController {
+  constructor(
+    private readonly projector: RentalStateProjector,
+    private readonly expiryScheduler: RentalExpiryScheduler
+  ) {}
+
+  @Get('lender/:address')
+  async rentalsByLender(@Param('address') address: string): Promise<RentalStateOutputDTO[]> {
+    this.validateAddress(address);
+    return (await this.projector.getByLender(address)).map(RentalStateMapper.mapRentalToDto);
+  }
+
+  @Get('renter/:address')
+  async rentalsByRenter(@Param('address') address: string): Promise<RentalStateOutputDTO[]> {
+    this.validateAddress(address);
+    return (await this.projector.getByRenter(address)).map(RentalStateMapper.mapRentalToDto);
+  }
+
+  @Get('expiring')
+  rentalsExpiring(@Query('from') from?: string, @Query('to') to?: string): RentalStateOutputDTO[] {
+    const fromTs = from ? Date.parse(from) / 1000 : 0;
+    const toTs = to ? Date.parse(to) / 1000 : Number.MAX_SAFE_INTEGER;
+    if (Number.isNaN(fromTs) || Number.isNaN(toTs)) {
+      throw new UnprocessableEntityException('Expiry window bounds must be ISO dates');
+    }
+    return this.projector.getExpiringBetween(fromTs, toTs).map(RentalStateMapper.mapRentalToDto);
+  }
+
+  @Get('returns')
+  preparedReturns(): RentalReturnOutputDTO[] {
+    return this.expiryScheduler.getPreparedReturns().map(RentalStateMapper.mapPreparedReturnToDto);
+  }
+
+  private validateAddress(address: string) {
+    if (!isValidAddress(address)) {
+      throw new UnprocessableEntityException('Account address is invalid');
+    }
+  }
+}
@@ -0,0 +1,176 @@
+import { TestBed } from '@automock/jest';
+import { TransactionStream } from '@transia/xrpl';
+import { firstValueFrom, Subject } from 'rxjs';
+import { floatToLEXfl } from '@transia/hooks-toolkit';
+import { IRentalChange, RentalStateProjector } from './rental-state.projector';
+import { XrplService } from '../xrpl/client/client.service';
+import { HookService } from '../hooks/hook.service';
+import { LedgerStreamService } from '../xrpl/client/ledger-stream.service';
+import { hookStateKeylet } from '../xrpl/keylet/keylet.utils';
+import { leXflToNumber } from './rental.utils';
+import { TEST_ADDRESS_ALICE, TEST_ADDRESS_BOB, TEST_HOOK_NS, TEST_URI_INDEX } from '../test-utils/test-utils';
+
+const DEADLINE = 1893456000;
+const BOB_NS = 'A773305BB47E7CFAC0AC01609164DD80451F553A71F0B88F6584AC4EA60658D5';
+
+const rentalTransaction = (hookStateNodeKind: 'CreatedNode' | 'DeletedNode'): TransactionStream => {
+  const hookStateFields = { HookStateKey: TEST_URI_INDEX, HookStateData: floatToLEXfl(DEADLINE.toString()) };
+  return {
+    validated: true,
+    ledger_index: 12,
+    transaction: { TransactionType: 'URITokenBuy', Account: TEST_ADDRESS_BOB, Amount: '600000000' },
+    meta: {
+      TransactionResult: 'tesSUCCESS',
+      AffectedNodes: [
+        {
+          ModifiedNode: {
+            LedgerEntryType: 'URIToken',
+            LedgerIndex: TEST_URI_INDEX,
+            FinalFields: { Owner: TEST_ADDRESS_BOB },
+            PreviousFields: { Owner: TEST_ADDRESS_ALICE },
+          },
+        },
+        {
+          ModifiedNode: {
+            LedgerEntryType: 'AccountRoot',
+            FinalFields: { Account: TEST_ADDRESS_ALICE, HookNamespaces: [TEST_HOOK_NS] },
+          },
+        },
+        {
+          ModifiedNode: {
+            LedgerEntryType: 'AccountRoot',
+            FinalFields: { Account: TEST_ADDRESS_BOB, HookNamespaces: [BOB_NS] },
+          },
+        },
+        {
+          [hookStateNodeKind]: {
+            LedgerEntryType: 'HookState',
+            LedgerIndex: hookStateKeylet(TEST_ADDRESS_ALICE, TEST_URI_INDEX, TEST_HOOK_NS),
+            [hookStateNodeKind === 'CreatedNode' ? 'NewFields' : 'FinalFields']: hookStateFields,
+          },
+        },
+      ],
+    },
+  } as any;
+};
+
+describe('RentalStateProjector unit spec', () => {
+  let underTest: RentalStateProjector;
+  let hookService: jest.Mocked<HookService>;
+  let xrplService: jest.Mocked<XrplService>;
+  let reset$: Subject<void>;
+
+  beforeEach(() => {
+    reset$ = new Subject<void>();
+    const { unit, unitRef } = TestBed.create(RentalStateProjector)
+      .mock(LedgerStreamService)
+      .using({ transactions$: new Subject<TransactionStream>(), reset$ })
+      .mock(HookService)
+      .using({
+        getNamespaceIfExistsOrDefault: jest.fn().mockResolvedValue(TEST_HOOK_NS),
+        getHookNSInternalState: jest.fn().mockResolvedValue([]),
+      })
+      .compile();
+    underTest = unit;
+    hookService = unitRef.get(HookService);
+    xrplService = unitRef.get(XrplService);
+  });
+
+  afterEach(() => {
+    underTest.onModuleDestroy();
+  });
+
+  const mockLenderNamespace = (entries: Array<{ index: string; key: string; data: string }>) => {
+    (hookService.getHookNSInternalState as jest.Mock).mockResolvedValue(entries);
+    (xrplService.getLedgerEntryByIndex as jest.Mock).mockResolvedValue({
+      Owner: TEST_ADDRESS_BOB,
+      PreviousTxnID: 'hash',
+    });
+    (xrplService.submitRequest as jest.Mock).mockResolvedValue({
+      result: { TransactionType: 'URITokenBuy', Amount: '600000000', meta: { AffectedNodes: [] } },
+    });
+  };
+  const rentalEntry = { index: 'index', key: TEST_URI_INDEX, data: floatToLEXfl(DEADLINE.toString()) };
+
+  test('should decode the deadline stored by the rental hook', () => {
+    expect(leXflToNumber(floatToLEXfl(DEADLINE.toString()))).toEqual(DEADLINE);
+  });
+
+  test('should project rental start from HookState created in the lender namespace', async () => {
+    underTest.applyTransaction(rentalTransaction('CreatedNode'));
+
+    const expected = {
+      uriTokenID: TEST_URI_INDEX,
+      lender: TEST_ADDRESS_ALICE,
+      renter: TEST_ADDRESS_BOB,
+      deadline: DEADLINE,
+      amount: '600000000',
+    };
+    await expect(underTest.getByLender(TEST_ADDRESS_ALICE)).resolves.toEqual([expected]);
+    await expect(underTest.getByRenter(TEST_ADDRESS_BOB)).resolves.toEqual([expected]);
+    expect(underTest.getExpiringBetween(DEADLINE - 1, DEADLINE + 1)).toEqual([expected]);
+    expect(underTest.getExpiringBetween(0, DEADLINE - 1)).toEqual([]);
+  });
+
+  test('should drop the rental when its HookState is deleted', async () => {
+    underTest.applyTransaction(rentalTransaction('CreatedNode'));
+    underTest.applyTransaction(rentalTransaction('DeletedNode'));
+
+    await expect(underTest.getByLender(TEST_ADDRESS_ALICE)).resolves.toEqual([]);
+    expect(underTest.getAll()).toEqual([]);
+  });
+
+  test('should ignore HookState nodes that do not belong to a namespace of the touched accounts', async () => {
+    const tx: any = rentalTransaction('CreatedNode');
+    tx.meta.AffectedNodes[3].CreatedNode.LedgerIndex = hookStateKeylet(TEST_ADDRESS_ALICE, TEST_URI_INDEX, BOB_NS);
+
+    underTest.applyTransaction(tx);
+
+    expect(underTest.getAll()).toEqual([]);
+  });
+
+  test('should backfill lender rentals from its hook namespace', async () => {
+    mockLenderNamespace([rentalEntry, { index: 'count', key: '0'.repeat(56) + '70000000', data: '01000000' }]);
+
+    await expect(underTest.getByLender(TEST_ADDRESS_ALICE)).resolves.toEqual([
+      {
+        uriTokenID: TEST_URI_INDEX,
+        lender: TEST_ADDRESS_ALICE,
+        renter: TEST_ADDRESS_BOB,
+        deadline: DEADLINE,
+        amount: '600000000',
+      },
+    ]);
+    expect(hookService.getHookNSInternalState).toBeCalledWith(TEST_ADDRESS_ALICE, TEST_HOOK_NS);
+  });
+
+  test('should announce the removal of a rental the backfill after a stream reset does not restore', async () => {
+    underTest.onModuleInit();
+    mockLenderNamespace([rentalEntry]);
+    await underTest.getByLender(TEST_ADDRESS_ALICE);
+    mockLenderNamespace([]);
+    const removed = firstValueFrom(underTest.changes$);
+
+    reset$.next();
+
+    await expect(removed).resolves.toEqual({
+      type: 'remove',
+      rental: expect.objectContaining({ uriTokenID: TEST_URI_INDEX }),
+    });
+    expect(underTest.getAll()).toEqual([]);
+  });
+
+  test('should not announce the removal of a rental the backfill after a stream reset restores', async () => {
+    underTest.onModuleInit();
+    mockLenderNamespace([rentalEntry]);
+    await underTest.getByLender(TEST_ADDRESS_ALICE);
+    const changes: IRentalChange[] = [];
+    underTest.changes$.subscribe((change) => changes.push(change));
+
+    reset$.next();
+    await expect(underTest.getByLender(TEST_ADDRESS_ALICE)).resolves.toHaveLength(1);
+    await new Promise(setImmediate);
+
+    expect(changes.map(({ type }) => type)).toEqual(['upsert']);
+  });
+});
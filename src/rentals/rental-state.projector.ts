@@ -0,0 +1,291 @@
+import { Injectable, Logger, OnModuleDestroy, OnModuleInit } from '@nestjs/common';
+import { TransactionStream, TxRequest, TxResponse } from '@transia/xrpl';
+import { URIToken } from '@transia/xrpl/dist/npm/models/ledger';
+import { Observable, Subject, Subscription } from 'rxjs';
+import { XrplService } from '../xrpl/client/client.service';
+import { LedgerStreamService } from '../xrpl/client/ledger-stream.service';
+import { HookService } from '../hooks/hook.service';
+import { hookStateKeylet } from '../xrpl/keylet/keylet.utils';
+import { leXflToNumber } from './rental.utils';
+import {
+  RENTAL_PROJECTION_ACCOUNTS,
+  RENTAL_STATE_DATA_HEX_LENGTH,
+  RENTAL_STATE_KEY_HEX_LENGTH,
+} from './retnals.constants';
+
+export interface IRentalRecord {
+  uriTokenID: string;
+  lender: string;
+  renter: string;
+  // unix timestamp in seconds, as stored by the rental hook
+  deadline: number;
+  amount?: string;
+}
+
+export interface IRentalChange {
+  type: 'upsert' | 'remove';
+  rental: IRentalRecord;
+}
+
+interface IAccountNamespaces {
+  account: string;
+  namespaces: string[];
+}
+
+/**
+ * Materialized view of ongoing rentals: URITokenID -> (lender, renter, deadline, amount).
+ * Kept live from HookState nodes of validated transaction metadata whose key is the URIToken touched by
+ * the same transaction; the owning account and namespace are recovered by matching the HookState keylet.
+ * Accounts are backfilled from their rental hook namespace on startup and on first query.
+ */
+@Injectable()
+export class RentalStateProjector implements OnModuleInit, OnModuleDestroy {
+  private readonly rentals = new Map<string, IRentalRecord>();
+  private readonly byLender = new Map<string, Set<string>>();
+  private readonly byRenter = new Map<string, Set<string>>();
+  private readonly backfilledAccounts = new Map<string, Promise<void>>();
+  private readonly changeSubject = new Subject<IRentalChange>();
+  private readonly subscriptions: Subscription[] = [];
+  // kept sorted by deadline for expiry window queries
+  private expiries: Array<{ deadline: number; uriTokenID: string }> = [];
+
+  readonly changes$: Observable<IRentalChange> = this.changeSubject.asObservable();
+
+  constructor(
+    private readonly xrpl: XrplService,
+    private readonly stream: LedgerStreamService,
+    private readonly hookService: HookService
+  ) {}
+
+  onModuleInit() {
+    this.subscriptions.push(
+      this.stream.transactions$.subscribe((tx) => this.applyTransaction(tx)),
+      this.stream.reset$.subscribe(() => void this.rebuild())
+    );
+    RENTAL_PROJECTION_ACCOUNTS.forEach((account) =>
+      this.ensureAccount(account).catch((err) => Logger.error(`Rental state backfill failed: ${err?.message}`))
+    );
+  }
+
+  onModuleDestroy() {
+    this.subscriptions.forEach((subscription) => subscription.unsubscribe());
+  }
+
+  async getByLender(lender: string): Promise<IRentalRecord[]> {
+    await this.ensureAccount(lender);
+    return [...(this.byLender.get(lender) || [])].map((uriTokenID) => this.rentals.get(uriTokenID));
+  }
+
+  async getByRenter(renter: string): Promise<IRentalRecord[]> {
+    await this.ensureAccount(renter);
+    return [...(this.byRenter.get(renter) || [])].map((uriTokenID) => this.rentals.get(uriTokenID));
+  }
+
+  getExpiringBetween(from: number, to: number): IRentalRecord[] {
+    const result: IRentalRecord[] = [];
+    for (let i = this.lowerBound(from); i < this.expiries.length && this.expiries[i].deadline <= to; i++) {
+      result.push(this.rentals.get(this.expiries[i].uriTokenID));
+    }
+    return result;
+  }
+
+  getRental(uriTokenID: string): IRentalRecord | undefined {
+    return this.rentals.get(uriTokenID);
+  }
+
+  getAll(): IRentalRecord[] {
+    return [...this.rentals.values()];
+  }
+
+  ensureAccount(account: string): Promise<void> {
+    let backfill = this.backfilledAccounts.get(account);
+    if (!backfill) {
+      backfill = this.backfillAccount(account).catch((err) => {
+        this.backfilledAccounts.delete(account);
+        throw err;
+      });
+      this.backfilledAccounts.set(account, backfill);
+    }
+    return backfill;
+  }
+
+  applyTransaction(tx: TransactionStream) {
+    const meta: any = tx.meta;
+    if (!tx.validated || meta?.TransactionResult !== 'tesSUCCESS') {
+      return;
+    }
+    const nodes = (meta.AffectedNodes || []).map((affected) => ({
+      kind: Object.keys(affected)[0],
+      node: Object.values<any>(affected)[0],
+    }));
+    const uriTokens = new Map<string, any>(
+      nodes.filter(({ node }) => node.LedgerEntryType === 'URIToken').map(({ node }) => [node.LedgerIndex, node])
+    );
+    if (uriTokens.size === 0) {
+      return;
+    }
+    const accounts: IAccountNamespaces[] = nodes
+      .filter(({ node }) => node.LedgerEntryType === 'AccountRoot')
+      .map(({ node }) => node.FinalFields || node.NewFields)
+      .map((fields) => ({ account: fields.Account, namespaces: fields.HookNamespaces || [] }));
+
+    nodes
+      .filter(({ node }) => node.LedgerEntryType === 'HookState')
+      .forEach(({ kind, node }) => {
+        const fields = node.NewFields || node.FinalFields;
+        const uriTokenNode = uriTokens.get(fields.HookStateKey);
+        if (!uriTokenNode || !this.isOwnedByKnownNamespace(node.LedgerIndex, fields.HookStateKey, accounts)) {
+          return;
+        }
+        if (kind === 'DeletedNode') {
+          this.remove(fields.HookStateKey);
+          return;
+        }
+        const uriTokenFields = uriTokenNode.FinalFields || uriTokenNode.NewFields;
+        this.upsert({
+          uriTokenID: fields.HookStateKey,
+          renter: uriTokenFields.Owner,
+          lender: uriTokenNode.PreviousFields?.Owner,
+          deadline: leXflToNumber(fields.HookStateData),
+          amount: typeof tx.transaction['Amount'] === 'string' ? tx.transaction['Amount'] : undefined,
+        });
+      });
+  }
+
+  private isOwnedByKnownNamespace(ledgerIndex: string, key: string, accounts: IAccountNamespaces[]): boolean {
+    return accounts.some(({ account, namespaces }) =>
+      namespaces.some((namespace) => hookStateKeylet(account, key, namespace) === ledgerIndex)
+    );
+  }
+
+  private async backfillAccount(account: string): Promise<void> {
+    const namespace = await this.hookService.getNamespaceIfExistsOrDefault(account);
+    const entries = await this.hookService.getHookNSInternalState(account, namespace);
+    for (const entry of entries) {
+      if (entry.key.length !== RENTAL_STATE_KEY_HEX_LENGTH || entry.data.length !== RENTAL_STATE_DATA_HEX_LENGTH) {
+        continue;
+      }
+      const uriToken = await this.xrpl.getLedgerEntryByIndex<URIToken & { PreviousTxnID: string }>(entry.key);
+      if (!uriToken) {
+        continue;
+      }
+      const origin = await this.getRentalOrigin(uriToken.PreviousTxnID);
+      const isRenter = uriToken.Owner === account;
+      this.upsert({
+        uriTokenID: entry.key,
+        lender: isRenter ? origin.lender : account,
+        renter: isRenter ? account : uriToken.Owner,
+        deadline: leXflToNumber(entry.data),
+        amount: origin.amount,
+      });
+    }
+    Logger.log(`Rental state of account: ${account} backfilled from namespace: ${namespace}`);
+  }
+
+  // the last transaction touching a rented token is either the rental start buy or the renter's return offer
+  private async getRentalOrigin(txHash: string): Promise<{ lender?: string; amount?: string }> {
+    const response = await this.xrpl.submitRequest<TxRequest, TxResponse>({ command: 'tx', transaction: txHash });
+    const tx: any = response?.result;
+    if (tx?.TransactionType === 'URITokenCreateSellOffer') {
+      return { lender: tx.Destination };
+    }
+    const uriTokenNode = (tx?.meta?.AffectedNodes || [])
+      .map((affected) => affected.ModifiedNode)
+      .find((node) => node?.LedgerEntryType === 'URIToken');
+    return {
+      lender: uriTokenNode?.PreviousFields?.Owner,
+      amount: typeof tx?.Amount === 'string' ? tx.Amount : undefined,
+    };
+  }
+
+  private upsert(rental: IRentalRecord) {
+    const previous = this.rentals.get(rental.uriTokenID);
+    if (previous) {
+      this.unindex(previous);
+    }
+    const merged: IRentalRecord = {
+      ...rental,
+      lender: rental.lender ?? previous?.lender,
+      amount: rental.amount ?? previous?.amount,
+    };
+    this.rentals.set(rental.uriTokenID, merged);
+    this.index(merged);
+    this.changeSubject.next({ type: 'upsert', rental: merged });
+  }
+
+  private remove(uriTokenID: string) {
+    const rental = this.rentals.get(uriTokenID);
+    if (!rental) {
+      return;
+    }
+    this.unindex(rental);
+    this.rentals.delete(uriTokenID);
+    this.changeSubject.next({ type: 'remove', rental });
+  }
+
+  private index(rental: IRentalRecord) {
+    this.addTo(this.byLender, rental.lender, rental.uriTokenID);
+    this.addTo(this.byRenter, rental.renter, rental.uriTokenID);
+    this.expiries.splice(this.lowerBound(rental.deadline), 0, {
+      deadline: rental.deadline,
+      uriTokenID: rental.uriTokenID,
+    });
+  }
+
+  private unindex(rental: IRentalRecord) {
+    this.byLender.get(rental.lender)?.delete(rental.uriTokenID);
+    this.byRenter.get(rental.renter)?.delete(rental.uriTokenID);
+    for (let i = this.lowerBound(rental.deadline); i < this.expiries.length; i++) {
+      if (this.expiries[i].uriTokenID === rental.uriTokenID) {
+        this.expiries.splice(i, 1);
+        break;
+      }
+    }
+  }
+
+  private addTo(index: Map<string, Set<string>>, account: string | undefined, uriTokenID: string) {
+    if (!account) {
+      return;
+    }
+    if (!index.has(account)) {
+      index.set(account, new Set());
+    }
+    index.get(account).add(uriTokenID);
+  }
+
+  private lowerBound(deadline: number): number {
+    let low = 0;
+    let high = this.expiries.length;
+    while (low < high) {
+      const mid = (low + high) >>> 1;
+      if (this.expiries[mid].deadline < deadline) {
+        low = mid + 1;
+      } else {
+        high = mid;
+      }
+    }
+    return low;
+  }
+
+  /**
+   * Backfills every known account again. Rentals the backfill does not restore, such as those finished while
+   * the stream was down, are announced as removed once every backfill has settled.
+   */
+  private async rebuild() {
+    const accounts = [...this.backfilledAccounts.keys()];
+    const dropped = [...this.rentals.values()];
+    this.rentals.clear();
+    this.byLender.clear();
+    this.byRenter.clear();
+    this.expiries = [];
+    this.backfilledAccounts.clear();
+    await Promise.all(
+      accounts.map((account) =>
+        this.ensureAccount(account).catch((err) => Logger.error(`Rental state backfill failed: ${err?.message}`))
+      )
+    );
+    dropped
+      .filter(({ uriTokenID }) => !this.rentals.has(uriTokenID))
+      .forEach((rental) => this.changeSubject.next({ type: 'remove', rental }));
+  }
+}
@@ -1,21 +1,16 @@
 import { Module } from '@nestjs/common';
 import { RentalsController } from './rentals.controller';
 import { RentalService } from './rental.service';
-import { HookService } from '../hooks/hook.service';
 import { RentalsTransactionFactory } from './rentals.transactionFactory';
-import { HookTransactionFactory } from '../hooks/hook.factory';
-import { XrplService } from '../xrpl/client/client.service';
-import { URITokenService } from '../uriToken/uri-token.service';
+import { HookModule } from '../hooks/hook.module';
+import { UriTokenModule } from '../uriToken/uri-token.module';
+import { RentalStateProjector } from './rental-state.projector';
+import { RentalStateController } from './rental-state.controller';
+import { RentalExpiryScheduler } from './rental-expiry.scheduler';
 
 @Module({
-  controllers: [RentalsController],
-  providers: [
-    XrplService,
-    RentalService,
-    HookService,
-    RentalsTransactionFactory,
-    HookTransactionFactory,
-    URITokenService,
-  ],
+  imports: [HookModule, UriTokenModule],
+  controllers: [RentalsController, RentalStateController],
+  providers: [RentalService, RentalsTransactionFactory, RentalStateProjector, RentalExpiryScheduler],
 })
 export class RentalModule {}
@@ -2,38 +2,44 @@ import { XrplService } from '../xrpl/client/client.service';
 import { TestBed } from '@automock/jest';
 import { RentalService } from './rental.service';
 import { RentalsTransactionFactory } from './rentals.transactionFactory';
+import { HookGrantManager } from '../hooks/hook-grant.manager';
 import { HookService } from '../hooks/hook.service';
 import { xrpToDrops } from '@transia/xrpl';
 import {
   FAILURE_SUBMIT_RESPONSE,
+  QUEUED_SUBMIT_RESPONSE,
   getAcceptRentalOfferInputDTO,
   getCreateRentalOfferInputDTO,
   SUCCESS_SUBMIT_RESPONSE,
   TEST_ADDRESS_ALICE,
   TEST_ADDRESS_BOB,
-  TEST_HOOK_HASH,
   TEST_HOOK_NS,
   TEST_SECRET,
   TEST_TOKEN_URI,
   TEST_URI_INDEX,
 } from '../test-utils/test-utils';
-import { Hook } from '@transia/xrpl/dist/npm/models/common';
 import { getForeignAccountTxParams, getRentalContextHookParams } from './rental.utils';
 import { OfferType } from './retnals.constants';
 import { URITokenService } from '../uriToken/uri-token.service';
-import { InternalServerErrorException, UnprocessableEntityException } from '@nestjs/common';
+import { SubmissionPriority } from '../xrpl/client/client.constant';
+import { ConflictException, InternalServerErrorException, UnprocessableEntityException } from '@nestjs/common';
 
 describe('RentalService unit spec', () => {
   let underTest: RentalService;
   let xrplService: jest.Mocked<XrplService>;
   let transactionFactory: jest.Mocked<RentalsTransactionFactory>;
   let hookService: jest.Mocked<HookService>;
+  let grantManager: jest.Mocked<HookGrantManager>;
   let uriTokenService: jest.Mocked<URITokenService>;
 
   beforeAll(() => {
     const { unit, unitRef } = TestBed.create(RentalService)
       .mock(XrplService)
-      .using({ submitTransaction: jest.fn().mockResolvedValue({}), submitRequest: jest.fn().mockResolvedValue({}) })
+      .using({
+        submitTransaction: jest.fn().mockResolvedValue({}),
+        submitRequest: jest.fn().mockResolvedValue({}),
+        getLedgerEntryByIndex: jest.fn().mockResolvedValue(null),
+      })
       .mock(RentalsTransactionFactory)
       .using({
         prepareSellOfferTxForStart: jest.fn().mockResolvedValue({}),
@@ -41,11 +47,11 @@ describe('RentalService unit spec', () => {
         prepareURITokenCancelOffer: jest.fn().mockResolvedValue({}),
       })
       .mock(HookService)
+      .using({ isURITokenInRental: jest.fn().mockResolvedValue(false) })
+      .mock(HookGrantManager)
       .using({
-        getNamespaceIfExistsOrDefault: jest.fn().mockResolvedValue({}),
-        grantAccessToHook: jest.fn().mockResolvedValue({}),
-        getAccountRentalHook: jest.fn().mockResolvedValue({}),
-        updateHook: jest.fn().mockResolvedValue({}),
+        grant: jest.fn().mockResolvedValue({}),
+        revoke: jest.fn().mockResolvedValue({}),
       })
       .mock(URITokenService)
       .using({ findToken: jest.fn().mockResolvedValue({}) })
@@ -55,6 +61,7 @@ describe('RentalService unit spec', () => {
     xrplService = unitRef.get(XrplService);
     transactionFactory = unitRef.get(RentalsTransactionFactory);
     hookService = unitRef.get(HookService);
+    grantManager = unitRef.get(HookGrantManager);
     uriTokenService = unitRef.get(URITokenService);
   });
 
@@ -69,7 +76,6 @@ describe('RentalService unit spec', () => {
     );
     const uriTokenCreateSellOfferTx = {
       Account: TEST_ADDRESS_ALICE,
-      NetworkID: 21338,
       TransactionType: 'URITokenCreateSellOffer',
       URITokenID: TEST_URI_INDEX,
       Amount: xrpToDrops(600),
@@ -83,19 +89,12 @@ describe('RentalService unit spec', () => {
       ],
     };
     (transactionFactory.prepareSellOfferTxForStart as jest.Mock).mockResolvedValue(uriTokenCreateSellOfferTx);
-    (hookService.getAccountRentalHook as jest.Mock).mockResolvedValue({
-      Hook: {
-        Flags: 16,
-        HookHash: TEST_HOOK_HASH,
-        HookNamespace: TEST_HOOK_NS,
-      },
-    } as Hook);
-    (hookService.grantAccessToHook as jest.Mock).mockResolvedValue(SUCCESS_SUBMIT_RESPONSE);
+    (grantManager.grant as jest.Mock).mockResolvedValue(SUCCESS_SUBMIT_RESPONSE);
     (xrplService.submitTransaction as jest.Mock).mockResolvedValue(SUCCESS_SUBMIT_RESPONSE);
     //when
     await underTest.createOffer(OfferType.START, input);
     //then
-    expect(hookService.grantAccessToHook).toBeCalledWith(input);
+    expect(grantManager.grant).toBeCalledWith(input.account, TEST_ADDRESS_BOB);
     expect(xrplService.submitTransaction).toBeCalledWith(uriTokenCreateSellOfferTx, {
       address: TEST_ADDRESS_ALICE,
       secret: TEST_SECRET,
@@ -137,7 +136,6 @@ describe('RentalService unit spec', () => {
     );
     const uriTokenCreateSellOfferTx = {
       Account: TEST_ADDRESS_ALICE,
-      NetworkID: 21338,
       TransactionType: 'URITokenCreateSellOffer',
       URITokenID: TEST_URI_INDEX,
       Amount: xrpToDrops(600),
@@ -151,7 +149,7 @@ describe('RentalService unit spec', () => {
       ],
     };
     (transactionFactory.prepareSellOfferTxForStart as jest.Mock).mockResolvedValue(uriTokenCreateSellOfferTx);
-    (hookService.grantAccessToHook as jest.Mock).mockResolvedValue(FAILURE_SUBMIT_RESPONSE);
+    (grantManager.grant as jest.Mock).mockResolvedValue(FAILURE_SUBMIT_RESPONSE);
     (xrplService.submitTransaction as jest.Mock).mockResolvedValue(SUCCESS_SUBMIT_RESPONSE);
     (uriTokenService.findToken as jest.Mock).mockResolvedValue({
       amount: undefined,
@@ -166,8 +164,22 @@ describe('RentalService unit spec', () => {
     //when
     await expect(underTest.createOffer(OfferType.START, input)).rejects.toThrow(InternalServerErrorException);
   });
+
+  test('should submit the START offer when the Hook Grant SetHook is queued', async () => {
+    //given
+    const input = getCreateRentalOfferInputDTO({ address: TEST_ADDRESS_ALICE, secret: TEST_SECRET }, TEST_ADDRESS_BOB);
+    const uriTokenCreateSellOfferTx = { Account: TEST_ADDRESS_ALICE, TransactionType: 'URITokenCreateSellOffer' };
+    (transactionFactory.prepareSellOfferTxForStart as jest.Mock).mockResolvedValue(uriTokenCreateSellOfferTx);
+    (grantManager.grant as jest.Mock).mockResolvedValue(QUEUED_SUBMIT_RESPONSE);
+    (xrplService.submitTransaction as jest.Mock).mockResolvedValue(SUCCESS_SUBMIT_RESPONSE);
+    //when
+    await expect(underTest.createOffer(OfferType.START, input)).resolves.toEqual(SUCCESS_SUBMIT_RESPONSE);
+    //then
+    expect(xrplService.submitTransaction).toBeCalledWith(uriTokenCreateSellOfferTx, input.account);
+  });
   test('should submit URITokenCreateSellOffer transaction as FINISH offer', async () => {
     //given
+    (grantManager.revoke as jest.Mock).mockClear();
     const input = getCreateRentalOfferInputDTO(
       {
         address: TEST_ADDRESS_ALICE,
@@ -177,7 +189,6 @@ describe('RentalService unit spec', () => {
     );
     const uriTokenCreateSellOfferTx = {
       Account: TEST_ADDRESS_ALICE,
-      NetworkID: 21338,
       TransactionType: 'URITokenCreateSellOffer',
       URITokenID: TEST_URI_INDEX,
       Amount: xrpToDrops(0),
@@ -193,19 +204,45 @@ describe('RentalService unit spec', () => {
     (transactionFactory.prepareSellOfferTxForFinish as jest.Mock).mockResolvedValue(uriTokenCreateSellOfferTx);
     (xrplService.submitTransaction as jest.Mock).mockResolvedValue(SUCCESS_SUBMIT_RESPONSE);
     (uriTokenService.findToken as jest.Mock).mockResolvedValue({ flags: 0 });
-    (hookService.updateHook as jest.Mock).mockResolvedValue(SUCCESS_SUBMIT_RESPONSE);
     //when
     await underTest.createOffer(OfferType.FINISH, input);
     //then
-    expect(xrplService.submitTransaction).toBeCalledWith(uriTokenCreateSellOfferTx, {
-      address: TEST_ADDRESS_ALICE,
-      secret: TEST_SECRET,
-    });
+    expect(grantManager.revoke).not.toBeCalled();
+    expect(xrplService.submitTransaction).toBeCalledWith(
+      uriTokenCreateSellOfferTx,
+      {
+        address: TEST_ADDRESS_ALICE,
+        secret: TEST_SECRET,
+      },
+      SubmissionPriority.RETURN
+    );
   });
 
-  test.each(['acceptRentalOffer', 'acceptReturnOffer'])(
+  test('should throw ConflictException without any submission when URIToken is already rented', async () => {
+    //given
+    const input = getCreateRentalOfferInputDTO(
+      {
+        address: TEST_ADDRESS_ALICE,
+        secret: TEST_SECRET,
+      },
+      TEST_ADDRESS_BOB
+    );
+    (uriTokenService.findToken as jest.Mock).mockResolvedValue({ flags: 0 });
+    (hookService.isURITokenInRental as jest.Mock).mockResolvedValueOnce(true);
+    (grantManager.grant as jest.Mock).mockClear();
+    //when
+    await expect(underTest.createOffer(OfferType.START, input)).rejects.toThrow(ConflictException);
+    //then
+    expect(hookService.isURITokenInRental).toBeCalledWith(TEST_ADDRESS_ALICE, TEST_URI_INDEX);
+    expect(grantManager.grant).not.toBeCalled();
+  });
+
+  test.each<[string, SubmissionPriority[]]>([
+    ['acceptRentalOffer', []],
+    ['acceptReturnOffer', [SubmissionPriority.RETURN]],
+  ])(
     'should submit URITokenBuy transaction as ACCEPT offer when execute: %s',
-    async (methodName: string) => {
+    async (methodName: string, priority: SubmissionPriority[]) => {
       //given
       const input = getAcceptRentalOfferInputDTO({
         address: TEST_ADDRESS_ALICE,
@@ -213,7 +250,6 @@ describe('RentalService unit spec', () => {
       });
       const uriTokenBuyTx = {
         Account: TEST_ADDRESS_ALICE,
-        NetworkID: 21338,
         TransactionType: 'URITokenBuy',
         URITokenID: TEST_URI_INDEX,
         Amount: '0',
@@ -229,10 +265,43 @@ describe('RentalService unit spec', () => {
       //when
       await underTest[methodName](OfferType.FINISH, input);
       //then
-      expect(xrplService.submitTransaction).toBeCalledWith(uriTokenBuyTx, {
-        address: TEST_ADDRESS_ALICE,
-        secret: TEST_SECRET,
-      });
+      expect(xrplService.submitTransaction).toBeCalledWith(
+        uriTokenBuyTx,
+        {
+          address: TEST_ADDRESS_ALICE,
+          secret: TEST_SECRET,
+        },
+        ...priority
+      );
     }
   );
+
+  test('should revoke the renter grant on the lender hook when the lender accepts the return', async () => {
+    //given
+    const lender = { address: TEST_ADDRESS_ALICE, secret: TEST_SECRET };
+    const renter = TEST_ADDRESS_BOB;
+    const input = getAcceptRentalOfferInputDTO(lender);
+    (grantManager.revoke as jest.Mock).mockClear().mockResolvedValue(SUCCESS_SUBMIT_RESPONSE);
+    (xrplService.getLedgerEntryByIndex as jest.Mock).mockResolvedValueOnce({ Owner: renter });
+    (xrplService.submitTransaction as jest.Mock).mockResolvedValue(SUCCESS_SUBMIT_RESPONSE);
+    //when
+    await underTest.acceptReturnOffer(TEST_URI_INDEX, input);
+    //then
+    expect(xrplService.getLedgerEntryByIndex).toBeCalledWith(TEST_URI_INDEX);
+    expect(grantManager.revoke).toBeCalledTimes(1);
+    // the SetHook is signed by the lender on their own hook, the renter is the revoked grantee
+    expect(grantManager.revoke).toBeCalledWith(lender, renter);
+  });
+
+  test('should not fail the return when the grant cannot be revoked', async () => {
+    //given
+    const input = getAcceptRentalOfferInputDTO({ address: TEST_ADDRESS_ALICE, secret: TEST_SECRET });
+    (grantManager.revoke as jest.Mock).mockRejectedValueOnce(new Error('SetHook failed'));
+    (xrplService.getLedgerEntryByIndex as jest.Mock).mockResolvedValueOnce({ Owner: TEST_ADDRESS_BOB });
+    (xrplService.submitTransaction as jest.Mock).mockResolvedValue(SUCCESS_SUBMIT_RESPONSE);
+    //when
+    const result = await underTest.acceptReturnOffer(TEST_URI_INDEX, input);
+    //then
+    expect(result).toEqual(SUCCESS_SUBMIT_RESPONSE);
+  });
 });
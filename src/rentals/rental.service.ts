@@ -1,12 +1,22 @@
-import { Injectable, InternalServerErrorException, UnprocessableEntityException } from '@nestjs/common';
-import { XrplService } from '../xrpl/client/client.service';
+import {
+  ConflictException,
+  Injectable,
+  InternalServerErrorException,
+  Logger,
+  UnprocessableEntityException,
+} from '@nestjs/common';
+import { isSubmissionPending, XrplService } from '../xrpl/client/client.service';
 import { SubmitResponse, URITokenBuy, URITokenCancelSellOffer, URITokenCreateSellOffer } from '@transia/xrpl';
+import { URIToken } from '@transia/xrpl/dist/npm/models/ledger';
 import { OfferType } from './retnals.constants';
-import { HookService } from '../hooks/hook.service';
 import { AcceptRentalOffer, CancelRentalOfferDTO, ReturnURITokenInputDTO, URITokenInputDTO } from './dto/rental.dto';
 import { RentalsTransactionFactory } from './rentals.transactionFactory';
 import { URITokenService } from '../uriToken/uri-token.service';
-import { XRPL_RESPONSE_CODE } from '../xrpl/client/interfaces/xrpl.interface';
+import { SubmissionPriority } from '../xrpl/client/client.constant';
+import { HookGrantManager } from '../hooks/hook-grant.manager';
+import { HookService } from '../hooks/hook.service';
+import { Traced } from '../tracing/tracer';
+import { Account } from '../account/interfaces/account.interface';
 
 @Injectable()
 export class RentalService {
@@ -14,9 +24,11 @@ export class RentalService {
     private readonly xrpl: XrplService,
     private readonly hookService: HookService,
     private readonly transactionFactory: RentalsTransactionFactory,
-    private readonly tokenService: URITokenService
+    private readonly tokenService: URITokenService,
+    private readonly grantManager: HookGrantManager
   ) {}
 
+  @Traced()
   async createOffer(type: OfferType, input: URITokenInputDTO): Promise<SubmitResponse> {
     const token = await this.tokenService.findToken(input.account.address, input.uri);
     if (token && token.flags === 1) {
@@ -28,40 +40,63 @@ export class RentalService {
     return await this.finishRental(input);
   }
 
+  @Traced()
   private async lendURIToken(input: URITokenInputDTO): Promise<SubmitResponse> {
+    if (await this.hookService.isURITokenInRental(input.account.address, input.uri)) {
+      throw new ConflictException('URIToken is already in ongoing rental process');
+    }
     const tx: URITokenCreateSellOffer = await this.transactionFactory.prepareSellOfferTxForStart(input);
-    const grantAccessResult: any = await this.hookService.grantAccessToHook(input);
-    if (grantAccessResult.response.engine_result !== XRPL_RESPONSE_CODE.SUCCESS.valueOf()) {
+    const grantAccessResult: any = await this.grantManager.grant(input.account, input.destinationAccount);
+    // a queued SetHook is applied by the resubmitter, the offer does not wait for it
+    if (grantAccessResult && !isSubmissionPending(grantAccessResult)) {
       throw new InternalServerErrorException('Hook Grant access failed');
     }
     return this.xrpl.submitTransaction(tx, input.account);
   }
 
+  @Traced()
   async cancelRentalOffer(index: string, input: CancelRentalOfferDTO): Promise<SubmitResponse> {
     const tx: URITokenCancelSellOffer = await this.transactionFactory.prepareURITokenCancelOffer(index, input);
     return this.xrpl.submitTransaction(tx, input.account);
   }
 
+  @Traced()
   async acceptRentalOffer(index: string, input: AcceptRentalOffer): Promise<SubmitResponse> {
     const tx: URITokenBuy = await this.transactionFactory.prepareURITokenBuy(index, input);
     return this.xrpl.submitTransaction(tx, input.renterAccount);
   }
 
+  /**
+   * The lender buys the URIToken back, and only the lender can sign the SetHook revoking the grant their hook
+   * gave the renter when lending it. The renter is the owner of the URIToken until the URITokenBuy applies.
+   */
+  @Traced()
   async acceptReturnOffer(index: string, input: AcceptRentalOffer): Promise<SubmitResponse> {
     const tx: URITokenBuy = await this.transactionFactory.prepareURITokenBuy(index, input);
-    return this.xrpl.submitTransaction(tx, input.renterAccount);
+    const uriToken = await this.xrpl.getLedgerEntryByIndex<URIToken>(index);
+    const result = await this.xrpl.submitTransaction(tx, input.renterAccount, SubmissionPriority.RETURN);
+    if (uriToken?.Owner && uriToken.Owner !== input.renterAccount.address) {
+      await this.revokeRenterGrant(input.renterAccount, uriToken.Owner);
+    }
+    return result;
   }
 
+  @Traced()
   private async finishRental(input: ReturnURITokenInputDTO): Promise<SubmitResponse> {
+    // the grant lives on the hook of the lender, it is revoked once the lender accepts the return
     const tx = await this.transactionFactory.prepareSellOfferTxForFinish(input);
-    const removeGrantAccessResult: any = await this.hookService.updateHook({
-      address: input.account.address,
-      secret: input.account.secret,
-      grants: [],
-    });
-    if (removeGrantAccessResult.response.engine_result !== XRPL_RESPONSE_CODE.SUCCESS.valueOf()) {
-      throw new InternalServerErrorException('Delete of Hook Grant has failed');
+    return this.xrpl.submitTransaction(tx, input.account, SubmissionPriority.RETURN);
+  }
+
+  // the URIToken is already on its way back, a failed revoke is logged rather than failing the return
+  private async revokeRenterGrant(lender: Account, renter: string) {
+    try {
+      const revokeResult: any = await this.grantManager.revoke(lender, renter);
+      if (revokeResult && !isSubmissionPending(revokeResult)) {
+        Logger.error(`Delete of Hook Grant of: ${renter} on hook of: ${lender.address} has failed`);
+      }
+    } catch (err) {
+      Logger.error(`Delete of Hook Grant of: ${renter} on hook of: ${lender.address} has failed: ${err?.message}`);
     }
-    return this.xrpl.submitTransaction(tx, input.account);
   }
 }
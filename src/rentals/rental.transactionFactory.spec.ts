@@ -44,7 +44,6 @@ describe('RentalsTransactionFactory unit spec', () => {
     });
     expect(tx).toEqual({
       Account: TEST_ADDRESS_ALICE,
-      NetworkID: 21338,
       TransactionType: 'URITokenCreateSellOffer',
       URITokenID: TEST_URI_INDEX,
       Amount: xrpToDrops(600),
@@ -75,7 +74,6 @@ describe('RentalsTransactionFactory unit spec', () => {
     });
     expect(tx).toEqual({
       Account: TEST_ADDRESS_ALICE,
-      NetworkID: 21338,
       TransactionType: 'URITokenCreateSellOffer',
       URITokenID: TEST_URI_INDEX,
       Amount: xrpToDrops(0),
@@ -102,7 +100,6 @@ describe('RentalsTransactionFactory unit spec', () => {
     });
     expect(tx).toEqual({
       Account: TEST_ADDRESS_ALICE,
-      NetworkID: 21338,
       TransactionType: 'URITokenBuy',
       URITokenID: TEST_URI_INDEX,
       Amount: xrpToDrops(600),
@@ -125,7 +122,6 @@ describe('RentalsTransactionFactory unit spec', () => {
     });
     expect(tx).toEqual({
       Account: TEST_ADDRESS_ALICE,
-      NetworkID: 21338,
       TransactionType: 'URITokenCancelSellOffer',
       URITokenID: TEST_URI_INDEX,
     });
@@ -31,3 +31,20 @@ export function getForeignAccountTxParams(destination: string, hookNamespace: st
     new iHookParamEntry(new iHookParamName('FOREIGNNS'), new iHookParamValue(hookNamespace, true)).toXrpl(),
   ];
 }
+
+// decodes a little-endian XFL (as written by floatToLEXfl and stored by the rental hook) into a number
+export function leXflToNumber(leXflHex: string): number {
+  const xfl = BigInt('0x' + Buffer.from(leXflHex, 'hex').reverse().toString('hex'));
+  if (xfl === 0n) {
+    return 0;
+  }
+  const isPositive = (xfl >> 62n) & 1n;
+  const exponent = (xfl >> 54n) & 0xffn;
+  const mantissa = xfl & ((1n << 54n) - 1n);
+  const sign = isPositive ? 1 : -1;
+  if (exponent >= 97n) {
+    return sign * Number(mantissa * 10n ** (exponent - 97n));
+  }
+  const divisor = 10n ** (97n - exponent);
+  return sign * (Number(mantissa / divisor) + Number(mantissa % divisor) / Number(divisor));
+}
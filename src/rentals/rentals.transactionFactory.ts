@@ -1,7 +1,6 @@
 import { Injectable } from '@nestjs/common';
 import { AcceptRentalOffer, CancelRentalOfferDTO, ReturnURITokenInputDTO, URITokenInputDTO } from './dto/rental.dto';
 import { URITokenBuy, URITokenCancelSellOffer, URITokenCreateSellOffer, xrpToDrops } from '@transia/xrpl';
-import * as process from 'process';
 import { HookService } from '../hooks/hook.service';
 import { getForeignAccountTxParams, getRentalContextHookParams } from './rental.utils';
 
@@ -14,7 +13,6 @@ export class RentalsTransactionFactory {
 
     return {
       Account: input.account.address,
-      NetworkID: parseInt(process.env.NETWORK_ID),
       TransactionType: 'URITokenCreateSellOffer',
       URITokenID: input.uri,
       Amount: xrpToDrops(input.totalAmount),
@@ -34,7 +32,6 @@ export class RentalsTransactionFactory {
 
     return {
       Account: input.account.address,
-      NetworkID: parseInt(process.env.NETWORK_ID),
       TransactionType: 'URITokenCreateSellOffer',
       URITokenID: input.uri,
       Amount: '0',
@@ -52,7 +49,6 @@ export class RentalsTransactionFactory {
   async prepareURITokenBuy(index: string, input: AcceptRentalOffer): Promise<URITokenBuy> {
     return {
       Account: input.renterAccount.address,
-      NetworkID: parseInt(process.env.NETWORK_ID),
       TransactionType: 'URITokenBuy',
       URITokenID: index,
       Amount: xrpToDrops(input.totalAmount),
@@ -68,7 +64,6 @@ export class RentalsTransactionFactory {
   async prepareURITokenCancelOffer(index: string, input: CancelRentalOfferDTO): Promise<URITokenCancelSellOffer> {
     return {
       Account: input.account.address,
-      NetworkID: parseInt(process.env.NETWORK_ID),
       TransactionType: 'URITokenCancelSellOffer',
       URITokenID: index,
     };
@@ -2,3 +2,16 @@ export enum OfferType {
   START = 'START',
   FINISH = 'FINISH',
 }
+
+// lender accounts whose rentals are backfilled into the rental state view on startup, comma separated
+export const RENTAL_PROJECTION_ACCOUNTS = (process.env.RENTAL_PROJECTION_ACCOUNTS || '')
+  .split(',')
+  .map((account) => account.trim())
+  .filter(Boolean);
+
+// hook state entries of the rental hook: URITokenID (32 bytes) -> deadline as LE XFL (8 bytes)
+export const RENTAL_STATE_KEY_HEX_LENGTH = 64;
+export const RENTAL_STATE_DATA_HEX_LENGTH = 16;
+
+// resolution of the rental expiry timer wheel, deadlines are stored with one second precision by the hook
+export const RENTAL_EXPIRY_TICK_MS = parseInt(process.env.RENTAL_EXPIRY_TICK_MS || '1000');
@@ -24,6 +24,17 @@ export const SUCCESS_SUBMIT_RESPONSE = {
   },
 };
 
+// held for resubmission by the TransactionResubmitter
+export const QUEUED_SUBMIT_RESPONSE = {
+  response: {
+    tx_json: {
+      hash: TEST_TX_HASH,
+      LastLedgerSequence: 20,
+    },
+    engine_result: 'terQUEUED',
+  },
+};
+
 export const FAILURE_SUBMIT_RESPONSE = {
   response: {
     engine_result: 'tefEXCEPTION',
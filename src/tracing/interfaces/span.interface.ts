@@ -0,0 +1,23 @@
+export type SpanAttributes = Record<string, string | number | boolean | undefined>;
+
+// values of the OTLP status code
+export enum SpanStatusCode {
+  UNSET = 0,
+  OK = 1,
+  ERROR = 2,
+}
+
+export interface ISpanData {
+  traceId: string;
+  spanId: string;
+  parentSpanId?: string;
+  name: string;
+  startTimeUnixNano: bigint;
+  endTimeUnixNano?: bigint;
+  attributes: SpanAttributes;
+  status: { code: SpanStatusCode; message?: string };
+}
+
+export interface ISpanExporter {
+  export(spans: ISpanData[]): Promise<void>;
+}
@@ -0,0 +1,134 @@
+import { Logger } from '@nestjs/common';
+import { appendFile } from 'node:fs/promises';
+import { request as httpRequest } from 'node:http';
+import { request as httpsRequest } from 'node:https';
+import { ISpanData, ISpanExporter, SpanAttributes } from './interfaces/span.interface';
+
+const OTLP_SCOPE_NAME = 'xrpl-nestjs-service/tracing';
+// OTLP SpanKind: server for HTTP request spans, internal for everything below them
+const SPAN_KIND_INTERNAL = 1;
+const SPAN_KIND_SERVER = 2;
+
+function toOtlpAttributes(attributes: SpanAttributes) {
+  return Object.entries(attributes)
+    .filter(([, value]) => value !== undefined)
+    .map(([key, value]) => {
+      if (typeof value === 'boolean') {
+        return { key, value: { boolValue: value } };
+      }
+      if (typeof value === 'number') {
+        return { key, value: Number.isInteger(value) ? { intValue: value } : { doubleValue: value } };
+      }
+      return { key, value: { stringValue: value } };
+    });
+}
+
+/**
+ * Encodes spans as an OTLP/JSON ExportTraceServiceRequest, the format accepted by OTLP/HTTP collectors.
+ */
+export function toOtlpJson(spans: ISpanData[], serviceName: string) {
+  return {
+    resourceSpans: [
+      {
+        resource: { attributes: toOtlpAttributes({ 'service.name': serviceName }) },
+        scopeSpans: [
+          {
+            scope: { name: OTLP_SCOPE_NAME },
+            spans: spans.map((span) => ({
+              traceId: span.traceId,
+              spanId: span.spanId,
+              ...(span.parentSpanId && { parentSpanId: span.parentSpanId }),
+              name: span.name,
+              kind: span.parentSpanId ? SPAN_KIND_INTERNAL : SPAN_KIND_SERVER,
+              startTimeUnixNano: span.startTimeUnixNano.toString(),
+              endTimeUnixNano: span.endTimeUnixNano?.toString(),
+              attributes: toOtlpAttributes(span.attributes),
+              status: span.status,
+            })),
+          },
+        ],
+      },
+    ],
+  };
+}
+
+export class FileSpanExporter implements ISpanExporter {
+  constructor(
+    private readonly path: string,
+    private readonly serviceName: string
+  ) {}
+
+  async export(spans: ISpanData[]): Promise<void> {
+    await appendFile(this.path, JSON.stringify(toOtlpJson(spans, this.serviceName)) + '\n');
+  }
+}
+
+export class OtlpHttpSpanExporter implements ISpanExporter {
+  constructor(
+    private readonly endpoint: string,
+    private readonly serviceName: string
+  ) {}
+
+  export(spans: ISpanData[]): Promise<void> {
+    const body = JSON.stringify(toOtlpJson(spans, this.serviceName));
+    const url = new URL(this.endpoint);
+    const request = url.protocol === 'https:' ? httpsRequest : httpRequest;
+    return new Promise((resolve, reject) => {
+      const req = request(
+        url,
+        { method: 'POST', headers: { 'Content-Type': 'application/json', 'Content-Length': Buffer.byteLength(body) } },
+        (res) => {
+          res.resume();
+          res.on('end', () =>
+            res.statusCode < 300 ? resolve() : reject(new Error(`OTLP collector responded: ${res.statusCode}`))
+          );
+        }
+      );
+      req.on('error', reject);
+      req.end(body);
+    });
+  }
+}
+
+/**
+ * Buffers finished spans and hands them to the exporter in batches. A failed export drops its batch,
+ * tracing must never hold memory or requests back because the collector is down.
+ */
+export class BatchSpanProcessor {
+  private buffer: ISpanData[] = [];
+  private readonly timer: NodeJS.Timeout;
+
+  constructor(
+    private readonly exporter: ISpanExporter,
+    private readonly maxBufferedSpans: number,
+    flushIntervalMs: number
+  ) {
+    this.timer = setInterval(() => this.flush(), flushIntervalMs);
+    this.timer.unref();
+  }
+
+  onEnd(span: ISpanData) {
+    this.buffer.push(span);
+    if (this.buffer.length >= this.maxBufferedSpans) {
+      this.flush();
+    }
+  }
+
+  async flush(): Promise<void> {
+    if (this.buffer.length === 0) {
+      return;
+    }
+    const batch = this.buffer;
+    this.buffer = [];
+    try {
+      await this.exporter.export(batch);
+    } catch (err) {
+      Logger.warn(`Export of ${batch.length} spans failed: ${err?.message}`);
+    }
+  }
+
+  async shutdown(): Promise<void> {
+    clearInterval(this.timer);
+    await this.flush();
+  }
+}
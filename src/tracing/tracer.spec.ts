@@ -0,0 +1,93 @@
+import 'reflect-metadata';
+import { AsyncResource } from 'node:async_hooks';
+import { Traced, Tracer, tracer } from './tracer';
+import { toOtlpJson } from './span.exporter';
+import { ISpanData, SpanStatusCode } from './interfaces/span.interface';
+
+class TracedService {
+  @Traced()
+  async lookup(value: string): Promise<string> {
+    return tracer.trace('xrpl ledger_entry', async () => value);
+  }
+
+  @Traced('TracedService.failing')
+  async fail(): Promise<void> {
+    throw new Error('rejected');
+  }
+}
+
+describe('Tracer unit spec', () => {
+  let finished: ISpanData[];
+
+  beforeEach(() => {
+    finished = [];
+    tracer.setSpanProcessor((span) => finished.push(span));
+  });
+
+  afterAll(() => {
+    tracer.setSpanProcessor(undefined);
+  });
+
+  test('should make spans started down the async call chain children of the active span', async () => {
+    const service = new TracedService();
+
+    await expect(service.lookup('entry')).resolves.toEqual('entry');
+
+    const [child, parent] = finished;
+    expect(parent.name).toEqual('TracedService.lookup');
+    expect(child.name).toEqual('xrpl ledger_entry');
+    expect(child.traceId).toEqual(parent.traceId);
+    expect(child.parentSpanId).toEqual(parent.spanId);
+    expect(parent.parentSpanId).toBeUndefined();
+  });
+
+  test('should end the span of a rejected call with an error status', async () => {
+    await expect(new TracedService().fail()).rejects.toThrow('rejected');
+
+    expect(finished[0]).toEqual(
+      expect.objectContaining({
+        name: 'TracedService.failing',
+        status: { code: SpanStatusCode.ERROR, message: 'rejected' },
+      })
+    );
+  });
+
+  test('should keep the trace of a callback bound before it is run from another context', async () => {
+    const root = tracer.startSpan('POST /rentals/offers');
+    const bound = tracer.withSpan(root, () => AsyncResource.bind(() => tracer.trace('xrpl submit', () => 'sent')));
+
+    bound();
+
+    expect(finished[0].parentSpanId).toEqual(root.data.spanId);
+  });
+
+  test('should call traced functions directly without a span processor', () => {
+    const disabled = new Tracer();
+
+    expect(disabled.trace('xrpl submit', () => disabled.activeSpan())).toBeUndefined();
+  });
+
+  test('should encode spans as OTLP JSON', () => {
+    const span = tracer.startSpan('xrpl submit', { 'xrpl.command': 'submit', retries: 1 });
+    span.end();
+
+    const otlp = toOtlpJson(finished, 'rental-service');
+
+    expect(otlp.resourceSpans[0].resource.attributes).toEqual([
+      { key: 'service.name', value: { stringValue: 'rental-service' } },
+    ]);
+    expect(otlp.resourceSpans[0].scopeSpans[0].spans[0]).toEqual(
+      expect.objectContaining({
+        traceId: span.data.traceId,
+        spanId: span.data.spanId,
+        name: 'xrpl submit',
+        startTimeUnixNano: span.data.startTimeUnixNano.toString(),
+        attributes: [
+          { key: 'xrpl.command', value: { stringValue: 'submit' } },
+          { key: 'retries', value: { intValue: 1 } },
+        ],
+        status: { code: SpanStatusCode.OK },
+      })
+    );
+  });
+});
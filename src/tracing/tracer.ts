@@ -0,0 +1,126 @@
+import { AsyncLocalStorage } from 'node:async_hooks';
+import { randomBytes } from 'node:crypto';
+import { ISpanData, SpanAttributes, SpanStatusCode } from './interfaces/span.interface';
+
+// hrtime is monotonic but not anchored to the epoch, span timestamps are shifted by this offset
+const EPOCH_OFFSET_NS = BigInt(Date.now()) * 1_000_000n - process.hrtime.bigint();
+
+const nowUnixNano = (): bigint => EPOCH_OFFSET_NS + process.hrtime.bigint();
+
+export class Span {
+  readonly data: ISpanData;
+
+  constructor(
+    name: string,
+    parent: Span | undefined,
+    attributes: SpanAttributes,
+    private readonly onEnd: (data: ISpanData) => void
+  ) {
+    this.data = {
+      traceId: parent?.data.traceId ?? randomBytes(16).toString('hex'),
+      spanId: randomBytes(8).toString('hex'),
+      parentSpanId: parent?.data.spanId,
+      name,
+      startTimeUnixNano: nowUnixNano(),
+      attributes: { ...attributes },
+      status: { code: SpanStatusCode.UNSET },
+    };
+  }
+
+  setAttribute(key: string, value: string | number | boolean | undefined) {
+    this.data.attributes[key] = value;
+  }
+
+  end(err?: unknown) {
+    if (this.data.endTimeUnixNano !== undefined) {
+      return;
+    }
+    this.data.endTimeUnixNano = nowUnixNano();
+    this.data.status =
+      err === undefined
+        ? { code: SpanStatusCode.OK }
+        : { code: SpanStatusCode.ERROR, message: (err as Error)?.message ?? String(err) };
+    this.onEnd(this.data);
+  }
+}
+
+/**
+ * Keeps the active span in AsyncLocalStorage, so spans started anywhere down an async call chain become
+ * children of the span of the request that caused them. Without a span processor, nothing is recorded
+ * and traced functions are called directly.
+ */
+export class Tracer {
+  private readonly context = new AsyncLocalStorage<Span>();
+  private processor?: (data: ISpanData) => void;
+
+  setSpanProcessor(processor?: (data: ISpanData) => void) {
+    this.processor = processor;
+  }
+
+  isEnabled(): boolean {
+    return this.processor !== undefined;
+  }
+
+  activeSpan(): Span | undefined {
+    return this.context.getStore();
+  }
+
+  // the span is not made active, see withSpan
+  startSpan(name: string, attributes: SpanAttributes = {}): Span {
+    return new Span(name, this.activeSpan(), attributes, (data) => this.processor?.(data));
+  }
+
+  withSpan<T>(span: Span, fn: () => T): T {
+    return this.context.run(span, fn);
+  }
+
+  /**
+   * Runs the function in a new child span, ended when the returned promise settles or right away for
+   * synchronous results.
+   */
+  trace<T>(name: string, fn: () => T, attributes?: SpanAttributes): T {
+    if (!this.isEnabled()) {
+      return fn();
+    }
+    const span = this.startSpan(name, attributes);
+    let result: T;
+    try {
+      result = this.withSpan(span, fn);
+    } catch (err) {
+      span.end(err);
+      throw err;
+    }
+    if (result instanceof Promise) {
+      result.then(
+        () => span.end(),
+        (err) => span.end(err)
+      );
+    } else {
+      span.end();
+    }
+    return result;
+  }
+}
+
+// shared by the decorator and the providers, configured once by the TracingModule
+export const tracer = new Tracer();
+
+/**
+ * Traces every call of the decorated method as a span named `Class.method` unless a name is given.
+ */
+export function Traced(name?: string): MethodDecorator {
+  return (target: object, propertyKey: string | symbol, descriptor: PropertyDescriptor) => {
+    const original = descriptor.value;
+    const spanName = name ?? `${target.constructor.name}.${String(propertyKey)}`;
+    const traced = function (...args: unknown[]) {
+      return tracer.trace(spanName, () => original.apply(this, args));
+    };
+    // metadata defined by decorators applied before this one stays reachable on the wrapper
+    Reflect.getMetadataKeys(original).forEach((key) =>
+      Reflect.defineMetadata(key, Reflect.getMetadata(key, original), traced)
+    );
+    Object.defineProperty(traced, 'name', { value: original.name });
+    descriptor.value = traced;
+    return descriptor;
+  };
+}
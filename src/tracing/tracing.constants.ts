@@ -0,0 +1,17 @@
+export enum TraceExporterType {
+  NONE = 'none',
+  // one OTLP JSON document per line, appended to TRACE_FILE
+  FILE = 'file',
+  // OTLP/HTTP JSON posted to TRACE_OTLP_ENDPOINT
+  OTLP = 'otlp',
+}
+
+// spans are only created when an exporter is configured
+export const TRACE_EXPORTER = (process.env.TRACE_EXPORTER || TraceExporterType.NONE) as TraceExporterType;
+export const TRACE_FILE = process.env.TRACE_FILE || 'traces.ndjson';
+export const TRACE_OTLP_ENDPOINT = process.env.TRACE_OTLP_ENDPOINT || 'http://localhost:4318/v1/traces';
+export const TRACE_SERVICE_NAME = process.env.TRACE_SERVICE_NAME || 'xrpl-nestjs-service';
+
+// finished spans are exported in batches, on this interval or once the buffer is full
+export const TRACE_FLUSH_INTERVAL_MS = parseInt(process.env.TRACE_FLUSH_INTERVAL_MS || '5000');
+export const TRACE_MAX_BUFFERED_SPANS = parseInt(process.env.TRACE_MAX_BUFFERED_SPANS || '2048');
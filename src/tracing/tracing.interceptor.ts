@@ -0,0 +1,43 @@
+import { CallHandler, ExecutionContext, HttpException, Injectable, NestInterceptor } from '@nestjs/common';
+import { Observable, tap } from 'rxjs';
+import { tracer } from './tracer';
+
+/**
+ * Opens the root span of an HTTP request. The handler is subscribed inside the span context, so every
+ * span started while serving the request, down to single XRPL requests, belongs to its trace.
+ */
+@Injectable()
+export class TracingInterceptor implements NestInterceptor {
+  intercept(context: ExecutionContext, next: CallHandler): Observable<any> {
+    if (!tracer.isEnabled()) {
+      return next.handle();
+    }
+    const http = context.switchToHttp();
+    const request = http.getRequest();
+    const route = request?.route?.path ?? request?.url;
+    const span = tracer.startSpan(`${request?.method} ${route}`, {
+      'http.method': request?.method,
+      'http.route': route,
+      'http.target': request?.url,
+    });
+    return new Observable((subscriber) =>
+      tracer.withSpan(span, () =>
+        next
+          .handle()
+          .pipe(
+            tap({
+              complete: () => {
+                span.setAttribute('http.status_code', http.getResponse()?.statusCode);
+                span.end();
+              },
+              error: (err) => {
+                span.setAttribute('http.status_code', err instanceof HttpException ? err.getStatus() : 500);
+                span.end(err);
+              },
+            })
+          )
+          .subscribe(subscriber)
+      )
+    );
+  }
+}
@@ -0,0 +1,41 @@
+import { Logger, Module, OnApplicationShutdown, OnModuleInit } from '@nestjs/common';
+import { APP_INTERCEPTOR } from '@nestjs/core';
+import { TracingInterceptor } from './tracing.interceptor';
+import { tracer } from './tracer';
+import { BatchSpanProcessor, FileSpanExporter, OtlpHttpSpanExporter } from './span.exporter';
+import {
+  TRACE_EXPORTER,
+  TRACE_FILE,
+  TRACE_FLUSH_INTERVAL_MS,
+  TRACE_MAX_BUFFERED_SPANS,
+  TRACE_OTLP_ENDPOINT,
+  TRACE_SERVICE_NAME,
+  TraceExporterType,
+} from './tracing.constants';
+
+@Module({
+  providers: [{ provide: APP_INTERCEPTOR, useClass: TracingInterceptor }],
+})
+export class TracingModule implements OnModuleInit, OnApplicationShutdown {
+  private processor?: BatchSpanProcessor;
+
+  onModuleInit() {
+    const exporter =
+      TRACE_EXPORTER === TraceExporterType.FILE
+        ? new FileSpanExporter(TRACE_FILE, TRACE_SERVICE_NAME)
+        : TRACE_EXPORTER === TraceExporterType.OTLP
+        ? new OtlpHttpSpanExporter(TRACE_OTLP_ENDPOINT, TRACE_SERVICE_NAME)
+        : undefined;
+    if (!exporter) {
+      return;
+    }
+    this.processor = new BatchSpanProcessor(exporter, TRACE_MAX_BUFFERED_SPANS, TRACE_FLUSH_INTERVAL_MS);
+    tracer.setSpanProcessor((span) => this.processor.onEnd(span));
+    Logger.log(`Tracing enabled, spans are exported to: ${TRACE_EXPORTER}`);
+  }
+
+  async onApplicationShutdown() {
+    tracer.setSpanProcessor(undefined);
+    await this.processor?.shutdown();
+  }
+}
@@ -0,0 +1,14 @@
+import { TransactionValidationStatus } from '../transaction.constants';
+
+export class TransactionStatusOutputDTO {
+  tx_hash: string;
+  transaction_type: string;
+  account: string;
+  status: TransactionValidationStatus;
+  // preliminary result returned by the submit command
+  engine_result?: string;
+  // final result recorded in the validated ledger
+  validated_result?: string;
+  ledger_index?: number;
+  last_ledger_sequence?: number;
+}
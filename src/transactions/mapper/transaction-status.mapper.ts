@@ -0,0 +1,17 @@
+import { TransactionStatusOutputDTO } from '../dto/transaction-status.dto';
+import { ITrackedTransaction } from '../transaction-validation.tracker';
+
+export const TransactionStatusMapper = {
+  mapTrackedTransactionToDto: (tracked: ITrackedTransaction): TransactionStatusOutputDTO => {
+    return {
+      tx_hash: tracked.hash,
+      transaction_type: tracked.transactionType,
+      account: tracked.account,
+      status: tracked.status,
+      engine_result: tracked.engineResult,
+      validated_result: tracked.validatedResult,
+      ledger_index: tracked.ledgerIndex,
+      last_ledger_sequence: tracked.lastLedgerSequence,
+    };
+  },
+};
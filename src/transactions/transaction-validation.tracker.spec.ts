@@ -0,0 +1,129 @@
+import { TestBed } from '@automock/jest';
+import { NotFoundException } from '@nestjs/common';
+import { Subject } from 'rxjs';
+import { LedgerStream, TransactionStream } from '@transia/xrpl';
+import { TransactionValidationTracker } from './transaction-validation.tracker';
+import { XrplService } from '../xrpl/client/client.service';
+import { LedgerStreamService } from '../xrpl/client/ledger-stream.service';
+import { ISubmissionEvent } from '../xrpl/client/interfaces/xrpl.interface';
+import { TransactionValidationStatus } from './transaction.constants';
+import { TEST_ADDRESS_ALICE } from '../test-utils/test-utils';
+import { MetricsRegistry } from '../metrics/metrics.registry';
+
+const TX_HASH = 'C53ECF838647FA5A4C780377025FEC7999AB4182590510CA461444B207AB74A9';
+const SUBMISSION: ISubmissionEvent = {
+  hash: TX_HASH,
+  transactionType: 'URITokenBuy',
+  account: TEST_ADDRESS_ALICE,
+  lastLedgerSequence: 20,
+};
+
+describe('TransactionValidationTracker unit spec', () => {
+  let underTest: TransactionValidationTracker;
+  let xrplService: jest.Mocked<XrplService>;
+  const submissions$ = new Subject<ISubmissionEvent>();
+  const transactions$ = new Subject<TransactionStream>();
+  const ledgerClosed$ = new Subject<LedgerStream>();
+  let registry: MetricsRegistry;
+
+  beforeEach(() => {
+    registry = new MetricsRegistry();
+    const { unit, unitRef } = TestBed.create(TransactionValidationTracker)
+      .mock(XrplService)
+      .using({ submissions$: submissions$.asObservable() })
+      .mock(LedgerStreamService)
+      .using({
+        transactions$: transactions$.asObservable(),
+        ledgerClosed$: ledgerClosed$.asObservable(),
+        getLastLedgerIndex: jest.fn().mockReturnValue(10),
+      })
+      .mock(MetricsRegistry)
+      .using({
+        counter: registry.counter.bind(registry),
+        gauge: registry.gauge.bind(registry),
+        histogram: registry.histogram.bind(registry),
+      })
+      .compile();
+    underTest = unit;
+    xrplService = unitRef.get(XrplService);
+    underTest.onModuleInit();
+  });
+
+  afterEach(() => {
+    underTest.onModuleDestroy();
+  });
+
+  test('should resolve waiters from the validated transaction stream', async () => {
+    submissions$.next(SUBMISSION);
+    submissions$.next({ ...SUBMISSION, engineResult: 'tesSUCCESS' });
+    const validation = underTest.waitForValidation(TX_HASH);
+
+    transactions$.next({
+      validated: true,
+      ledger_index: 12,
+      transaction: { hash: TX_HASH },
+      meta: { TransactionResult: 'tecHOOK_REJECTED' },
+    } as any);
+
+    await expect(validation).resolves.toEqual(
+      expect.objectContaining({
+        status: TransactionValidationStatus.VALIDATED,
+        engineResult: 'tesSUCCESS',
+        validatedResult: 'tecHOOK_REJECTED',
+        ledgerIndex: 12,
+      })
+    );
+    expect(underTest.getStatus(TX_HASH).status).toEqual(TransactionValidationStatus.VALIDATED);
+  });
+
+  test('should count hook rejections by the return code of the rejecting hook', () => {
+    submissions$.next(SUBMISSION);
+
+    transactions$.next({
+      validated: true,
+      ledger_index: 12,
+      transaction: { hash: TX_HASH, TransactionType: 'URITokenBuy' },
+      meta: {
+        TransactionResult: 'tecHOOK_REJECTED',
+        HookExecutions: [
+          { HookExecution: { HookResult: 3, HookReturnCode: '0' } },
+          { HookExecution: { HookResult: 2, HookReturnCode: '8000000000000001' } },
+        ],
+      },
+    } as any);
+
+    const rendered = registry.render();
+    expect(rendered).toContain(
+      'xrpl_hook_rejections_total{transaction_type="URITokenBuy",return_code="8000000000000001"} 1'
+    );
+    expect(rendered).toContain('xrpl_tx_validation_seconds_count{transaction_type="URITokenBuy",status="VALIDATED"} 1');
+  });
+
+  test('should reject transactions whose preliminary result can never be applied', () => {
+    submissions$.next(SUBMISSION);
+    submissions$.next({ ...SUBMISSION, engineResult: 'temMALFORMED' });
+
+    expect(underTest.getStatus(TX_HASH).status).toEqual(TransactionValidationStatus.REJECTED);
+  });
+
+  test('should expire a transaction not validated by its LastLedgerSequence after one tx lookup', async () => {
+    (xrplService.submitRequest as jest.Mock).mockRejectedValue(new NotFoundException());
+    submissions$.next(SUBMISSION);
+    const validation = underTest.waitForValidation(TX_HASH);
+
+    ledgerClosed$.next({ ledger_index: 20 } as LedgerStream);
+    expect(xrplService.submitRequest).not.toBeCalled();
+    ledgerClosed$.next({ ledger_index: 21 } as LedgerStream);
+
+    await expect(validation).resolves.toEqual(expect.objectContaining({ status: TransactionValidationStatus.EXPIRED }));
+    expect(xrplService.submitRequest).toBeCalledTimes(1);
+  });
+
+  test('should report the pending state when waiting times out', async () => {
+    submissions$.next(SUBMISSION);
+
+    await expect(underTest.waitForValidation(TX_HASH, 1)).resolves.toEqual(
+      expect.objectContaining({ status: TransactionValidationStatus.PENDING })
+    );
+  });
+});
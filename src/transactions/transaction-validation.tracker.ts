@@ -0,0 +1,257 @@
+import { Injectable, Logger, NotFoundException, OnModuleDestroy, OnModuleInit } from '@nestjs/common';
+import { TransactionStream, TxRequest, TxResponse } from '@transia/xrpl';
+import { Subscription } from 'rxjs';
+import { isHeldForResubmission, XrplService } from '../xrpl/client/client.service';
+import { LedgerStreamService } from '../xrpl/client/ledger-stream.service';
+import { ISubmissionEvent, XRPL_RESPONSE_CODE, XRPL_RESULT_PREFIX } from '../xrpl/client/interfaces/xrpl.interface';
+import { Counter, Histogram, MetricsRegistry } from '../metrics/metrics.registry';
+import {
+  HOOK_RESULT_ACCEPT,
+  TransactionValidationStatus,
+  TX_VALIDATION_DEFAULT_LEDGER_WINDOW,
+  TX_VALIDATION_MAX_FINISHED,
+  TX_VALIDATION_WAIT_TIMEOUT_MS,
+} from './transaction.constants';
+
+export interface ITrackedTransaction {
+  hash: string;
+  transactionType: string;
+  account: string;
+  status: TransactionValidationStatus;
+  lastLedgerSequence?: number;
+  engineResult?: string;
+  validatedResult?: string;
+  ledgerIndex?: number;
+}
+
+interface IPendingTransaction {
+  tracked: ITrackedTransaction;
+  submittedAt: number;
+  waiters: Array<(tracked: ITrackedTransaction) => void>;
+  expiresAfterLedger?: number;
+}
+
+const NEVER_APPLIED_PREFIXES: string[] = [
+  XRPL_RESULT_PREFIX.MALFORMED,
+  XRPL_RESULT_PREFIX.FAILURE,
+  XRPL_RESULT_PREFIX.LOCAL_ERROR,
+];
+
+/**
+ * Follows submitted transactions to their final outcome without polling: hashes are registered when signed,
+ * resolved from the validated transaction stream and expired once a ledger past their LastLedgerSequence
+ * closes, after a single tx lookup covering events missed while the stream was down.
+ */
+@Injectable()
+export class TransactionValidationTracker implements OnModuleInit, OnModuleDestroy {
+  private readonly pending = new Map<string, IPendingTransaction>();
+  private readonly byExpiryLedger = new Map<number, Set<string>>();
+  // registered before any ledger was seen, their expiry is set on the next ledger close
+  private readonly unscheduled = new Set<string>();
+  private readonly finished = new Map<string, ITrackedTransaction>();
+  private readonly subscriptions: Subscription[] = [];
+  private readonly validationDuration: Histogram;
+  private readonly hookRejections: Counter;
+
+  constructor(
+    private readonly xrpl: XrplService,
+    private readonly stream: LedgerStreamService,
+    metrics: MetricsRegistry
+  ) {
+    this.validationDuration = metrics.histogram(
+      'xrpl_tx_validation_seconds',
+      'Time from signing a transaction to its final outcome',
+      ['transaction_type', 'status']
+    );
+    this.hookRejections = metrics.counter(
+      'xrpl_hook_rejections_total',
+      'Validated transactions rejected by a hook by hook return code',
+      ['transaction_type', 'return_code']
+    );
+    metrics.gauge('xrpl_tracked_transactions', 'Submitted transactions waiting for their final outcome', [], (gauge) =>
+      gauge.set({}, this.pending.size)
+    );
+  }
+
+  onModuleInit() {
+    this.subscriptions.push(
+      this.xrpl.submissions$.subscribe((submission) => this.applySubmission(submission)),
+      this.stream.transactions$.subscribe((tx) => this.applyTransaction(tx)),
+      this.stream.ledgerClosed$.subscribe((ledger) => this.expireBefore(ledger.ledger_index))
+    );
+  }
+
+  onModuleDestroy() {
+    this.subscriptions.forEach((subscription) => subscription.unsubscribe());
+  }
+
+  getStatus(hash: string): ITrackedTransaction | undefined {
+    return this.pending.get(hash)?.tracked ?? this.finished.get(hash);
+  }
+
+  /**
+   * Resolves with the final outcome of the transaction, or with its pending state once the timeout elapses.
+   */
+  waitForValidation(
+    hash: string,
+    timeoutMs = TX_VALIDATION_WAIT_TIMEOUT_MS
+  ): Promise<ITrackedTransaction | undefined> {
+    const entry = this.pending.get(hash);
+    if (!entry) {
+      return Promise.resolve(this.finished.get(hash));
+    }
+    return new Promise((resolve) => {
+      const waiter = (tracked: ITrackedTransaction) => {
+        clearTimeout(timer);
+        resolve(tracked);
+      };
+      const timer = setTimeout(() => {
+        entry.waiters = entry.waiters.filter((registered) => registered !== waiter);
+        resolve(entry.tracked);
+      }, timeoutMs);
+      entry.waiters.push(waiter);
+    });
+  }
+
+  applySubmission(submission: ISubmissionEvent) {
+    if (submission.engineResult === undefined) {
+      this.register(submission);
+      return;
+    }
+    const entry = this.pending.get(submission.hash);
+    if (!entry) {
+      return;
+    }
+    entry.tracked.engineResult = submission.engineResult;
+    if (
+      NEVER_APPLIED_PREFIXES.includes(submission.engineResult.slice(0, 3)) &&
+      !isHeldForResubmission(submission.engineResult, submission.lastLedgerSequence)
+    ) {
+      this.finish(submission.hash, { status: TransactionValidationStatus.REJECTED });
+    }
+  }
+
+  applyTransaction(tx: TransactionStream) {
+    const hash = tx.transaction?.hash;
+    if (!tx.validated || !hash || !this.pending.has(hash)) {
+      return;
+    }
+    const validatedResult = (tx.meta as any)?.TransactionResult;
+    if (validatedResult === XRPL_RESPONSE_CODE.HOOK_REJECTED) {
+      this.countHookRejection(tx);
+    }
+    this.finish(hash, {
+      status: TransactionValidationStatus.VALIDATED,
+      validatedResult,
+      ledgerIndex: tx.ledger_index,
+    });
+  }
+
+  expireBefore(ledgerIndex: number) {
+    this.unscheduled.forEach((hash) => this.scheduleExpiry(hash, ledgerIndex + TX_VALIDATION_DEFAULT_LEDGER_WINDOW));
+    this.unscheduled.clear();
+    for (const [expiresAfterLedger, hashes] of this.byExpiryLedger) {
+      if (expiresAfterLedger >= ledgerIndex) {
+        continue;
+      }
+      this.byExpiryLedger.delete(expiresAfterLedger);
+      hashes.forEach((hash) =>
+        this.confirmExpiry(hash).catch((err) => {
+          Logger.error(`Expiry check of tx: ${hash} failed, retried on next ledger: ${err?.message}`);
+          this.scheduleExpiry(hash, ledgerIndex);
+        })
+      );
+    }
+  }
+
+  private register(submission: ISubmissionEvent) {
+    if (this.pending.has(submission.hash)) {
+      return;
+    }
+    this.finished.delete(submission.hash);
+    this.pending.set(submission.hash, {
+      tracked: {
+        hash: submission.hash,
+        transactionType: submission.transactionType,
+        account: submission.account,
+        lastLedgerSequence: submission.lastLedgerSequence,
+        status: TransactionValidationStatus.PENDING,
+      },
+      submittedAt: Date.now(),
+      waiters: [],
+    });
+    const lastLedgerIndex = this.stream.getLastLedgerIndex();
+    if (submission.lastLedgerSequence !== undefined) {
+      this.scheduleExpiry(submission.hash, submission.lastLedgerSequence);
+    } else if (lastLedgerIndex !== undefined) {
+      this.scheduleExpiry(submission.hash, lastLedgerIndex + TX_VALIDATION_DEFAULT_LEDGER_WINDOW);
+    } else {
+      this.unscheduled.add(submission.hash);
+    }
+  }
+
+  private scheduleExpiry(hash: string, expiresAfterLedger: number) {
+    const entry = this.pending.get(hash);
+    if (!entry) {
+      return;
+    }
+    entry.expiresAfterLedger = expiresAfterLedger;
+    if (!this.byExpiryLedger.has(expiresAfterLedger)) {
+      this.byExpiryLedger.set(expiresAfterLedger, new Set());
+    }
+    this.byExpiryLedger.get(expiresAfterLedger).add(hash);
+  }
+
+  private async confirmExpiry(hash: string) {
+    let response: TxResponse;
+    try {
+      response = await this.xrpl.submitRequest<TxRequest, TxResponse>({ command: 'tx', transaction: hash });
+    } catch (err) {
+      if (!(err instanceof NotFoundException)) {
+        throw err;
+      }
+    }
+    if (!this.pending.has(hash)) {
+      return;
+    }
+    if (response?.result?.validated) {
+      this.finish(hash, {
+        status: TransactionValidationStatus.VALIDATED,
+        validatedResult: (response.result.meta as any)?.TransactionResult,
+        ledgerIndex: response.result.ledger_index,
+      });
+      return;
+    }
+    this.finish(hash, { status: TransactionValidationStatus.EXPIRED });
+  }
+
+  private finish(hash: string, outcome: Partial<ITrackedTransaction>) {
+    const entry = this.pending.get(hash);
+    this.pending.delete(hash);
+    this.unscheduled.delete(hash);
+    this.byExpiryLedger.get(entry.expiresAfterLedger)?.delete(hash);
+    const tracked = { ...entry.tracked, ...outcome };
+    this.finished.set(hash, tracked);
+    if (this.finished.size > TX_VALIDATION_MAX_FINISHED) {
+      this.finished.delete(this.finished.keys().next().value);
+    }
+    this.validationDuration.observe(
+      { transaction_type: tracked.transactionType, status: tracked.status },
+      (Date.now() - entry.submittedAt) / 1000
+    );
+    Logger.log(`Transaction: ${tracked.transactionType} ${hash} finished as ${tracked.status}`);
+    entry.waiters.forEach((waiter) => waiter(tracked));
+  }
+
+  // the rejecting hook is the one whose execution did not accept, the others in the chain did
+  private countHookRejection(tx: TransactionStream) {
+    const executions: any[] = (tx.meta as any)?.HookExecutions ?? [];
+    const rejecting = executions
+      .map(({ HookExecution }) => HookExecution)
+      .find((execution) => execution?.HookResult !== HOOK_RESULT_ACCEPT);
+    this.hookRejections.inc({
+      transaction_type: tx.transaction?.TransactionType,
+      return_code: rejecting?.HookReturnCode ?? 'unknown',
+    });
+  }
+}
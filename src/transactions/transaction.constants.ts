@@ -0,0 +1,22 @@
+export enum TransactionValidationStatus {
+  PENDING = 'PENDING',
+  VALIDATED = 'VALIDATED',
+  // rejected by the submit command with a result that can never reach a ledger (tem, tef, tel)
+  REJECTED = 'REJECTED',
+  // not found in a validated ledger once its LastLedgerSequence has passed
+  EXPIRED = 'EXPIRED',
+}
+
+export const WAIT_FOR_VALIDATION_QUERY_VALUE = 'validated';
+
+// upper bound of a request held open by ?wait=validated, the transaction is reported as pending afterwards
+export const TX_VALIDATION_WAIT_TIMEOUT_MS = parseInt(process.env.TX_VALIDATION_WAIT_TIMEOUT_MS || '30000');
+
+// ledgers after which a transaction submitted without LastLedgerSequence is checked one last time
+export const TX_VALIDATION_DEFAULT_LEDGER_WINDOW = 20;
+
+// finished transactions kept for the status endpoint
+export const TX_VALIDATION_MAX_FINISHED = parseInt(process.env.TX_VALIDATION_MAX_FINISHED || '10000');
+
+// HookResult of a hook execution that accepted the transaction, rollbacks and wasm errors reject it
+export const HOOK_RESULT_ACCEPT = 3;
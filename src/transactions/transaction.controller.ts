@@ -0,0 +1,18 @@
+import { Controller, Get, NotFoundException, Param } from '@nestjs/common';
+import { TransactionValidationTracker } from './transaction-validation.tracker';
+import { TransactionStatusOutputDTO } from './dto/transaction-status.dto';
+import { TransactionStatusMapper } from './mapper/transaction-status.mapper';
+
+@Controller('transactions')
+export class TransactionController {
+  constructor(private readonly tracker: TransactionValidationTracker) {}
+
+  @Get(':hash')
+  transactionStatus(@Param('hash') hash: string): TransactionStatusOutputDTO {
+    const tracked = this.tracker.getStatus(hash.toUpperCase());
+    if (!tracked) {
+      throw new NotFoundException(`Transaction: ${hash} is not tracked`);
+    }
+    return TransactionStatusMapper.mapTrackedTransactionToDto(tracked);
+  }
+}
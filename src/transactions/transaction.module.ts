@@ -0,0 +1,12 @@
+import { Module } from '@nestjs/common';
+import { APP_INTERCEPTOR } from '@nestjs/core';
+import { TransactionController } from './transaction.controller';
+import { TransactionValidationTracker } from './transaction-validation.tracker';
+import { ValidationWaitInterceptor } from './validation-wait.interceptor';
+
+@Module({
+  controllers: [TransactionController],
+  providers: [TransactionValidationTracker, { provide: APP_INTERCEPTOR, useClass: ValidationWaitInterceptor }],
+  exports: [TransactionValidationTracker],
+})
+export class TransactionModule {}
@@ -0,0 +1,30 @@
+import { CallHandler, ExecutionContext, Injectable, NestInterceptor } from '@nestjs/common';
+import { mergeMap, Observable } from 'rxjs';
+import { TransactionValidationTracker } from './transaction-validation.tracker';
+import { TransactionStatusMapper } from './mapper/transaction-status.mapper';
+import { WAIT_FOR_VALIDATION_QUERY_VALUE } from './transaction.constants';
+
+/**
+ * With `?wait=validated`, holds a transaction submitting response until the tracker knows its final outcome
+ * and attaches it as `validation`; responses without `tx_hash` pass through untouched.
+ */
+@Injectable()
+export class ValidationWaitInterceptor implements NestInterceptor {
+  constructor(private readonly tracker: TransactionValidationTracker) {}
+
+  intercept(context: ExecutionContext, next: CallHandler): Observable<any> {
+    const request = context.switchToHttp().getRequest();
+    if (request?.query?.wait !== WAIT_FOR_VALIDATION_QUERY_VALUE) {
+      return next.handle();
+    }
+    return next.handle().pipe(
+      mergeMap(async (body) => {
+        if (!body?.tx_hash) {
+          return body;
+        }
+        const tracked = await this.tracker.waitForValidation(body.tx_hash);
+        return tracked ? { ...body, validation: TransactionStatusMapper.mapTrackedTransactionToDto(tracked) } : body;
+      })
+    );
+  }
+}
@@ -1,6 +1,14 @@
+import { TransactionStatusOutputDTO } from '../../transactions/dto/transaction-status.dto';
+
 export class XRPLBaseResponseDTO {
   result: string;
   tx_hash: string;
+  // outcome in a validated ledger, only present when the request asked for ?wait=validated
+  validation?: TransactionStatusOutputDTO;
+}
+
+export class MintURITokenOutputDTO extends XRPLBaseResponseDTO {
+  uri_token_id: string;
 }
 
 export class URITokenOutputDTO {
@@ -8,3 +8,17 @@ export enum RentalMemoType {
   DEADLINE_TIME = 'deadline_time',
   TOTAL_AMOUNT = 'total_amount',
 }
+
+// account_objects page size used when the client does not ask for one, rippled caps it at 400
+export const URI_TOKEN_DEFAULT_PAGE_SIZE = 200;
+export const URI_TOKEN_MAX_PAGE_SIZE = 400;
+
+// bounds of the in-memory URIToken ownership index, accounts above the token limit are always read from the ledger
+export const URI_TOKEN_INDEX_MAX_ACCOUNTS = parseInt(process.env.URI_TOKEN_INDEX_MAX_ACCOUNTS || '10000');
+export const URI_TOKEN_INDEX_MAX_ACCOUNT_TOKENS = parseInt(process.env.URI_TOKEN_INDEX_MAX_ACCOUNT_TOKENS || '5000');
+
+export enum URITokenIndexStatus {
+  LOADING,
+  READY,
+  OVERSIZED,
+}
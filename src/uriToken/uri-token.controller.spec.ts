@@ -1,7 +1,10 @@
 import { Test, TestingModule } from '@nestjs/testing';
+import * as request from 'supertest';
 import { UriTokenController } from './uri-token.controller';
 import { URITokenService } from './uri-token.service';
-import { XrplService } from '../xrpl/client/client.service';
+import { BadRequestException, INestApplication } from '@nestjs/common';
+import { URI_TOKEN_DEFAULT_PAGE_SIZE } from './uri-token.constant';
+import { AccountVersionTracker } from '../xrpl/client/account-version.tracker';
 import {
   SUCCESS_SUBMIT_RESPONSE,
   TEST_ADDRESS_ALICE,
@@ -13,12 +16,14 @@ import {
 
 describe('UriToken controller', () => {
   let uriTokenController: UriTokenController;
+  let module: TestingModule;
 
   const mockedUriTokenService = {
     mintURIToken: jest.fn().mockResolvedValue(SUCCESS_SUBMIT_RESPONSE),
+    getURITokenID: jest.fn().mockReturnValue(TEST_URI_INDEX),
     removeURIToken: jest.fn().mockResolvedValue(SUCCESS_SUBMIT_RESPONSE),
-    getAccountTokens: jest.fn().mockResolvedValue([
-      {
+    iterateAccountTokens: jest.fn().mockImplementation(async function* () {
+      yield {
         amount: undefined,
         destination: undefined,
         digest: undefined,
@@ -26,14 +31,17 @@ describe('UriToken controller', () => {
         issuer: TEST_ADDRESS_ALICE,
         owner: TEST_ADDRESS_ALICE,
         uri: TEST_TOKEN_URI,
-      },
-    ]),
+      };
+    }),
   };
 
   beforeEach(async () => {
-    const module: TestingModule = await Test.createTestingModule({
+    module = await Test.createTestingModule({
       controllers: [UriTokenController],
-      providers: [URITokenService, XrplService],
+      providers: [
+        URITokenService,
+        { provide: AccountVersionTracker, useValue: { getVersion: jest.fn().mockResolvedValue(null) } },
+      ],
     })
       .overrideProvider(URITokenService)
       .useValue(mockedUriTokenService)
@@ -55,16 +63,17 @@ describe('UriToken controller', () => {
       ).toEqual({
         tx_hash: TEST_TX_HASH,
         result: 'tesSUCCESS',
+        uri_token_id: TEST_URI_INDEX,
       });
     });
 
-    it('should return array of URITokens', async () => {
-      const response = await uriTokenController.getURITokens(TEST_ADDRESS_ALICE);
-      expect(response).toEqual([
+    it('should stream URITokens as a JSON array', async () => {
+      const res = getMockedResponse();
+      await uriTokenController.getURITokens(TEST_ADDRESS_ALICE, 50, undefined, res as any);
+      expect(mockedUriTokenService.iterateAccountTokens).toBeCalledWith(TEST_ADDRESS_ALICE, 50);
+      expect(res.setHeader).toBeCalledWith('Content-Type', 'application/json');
+      expect(JSON.parse(res.body())).toEqual([
         {
-          amount: undefined,
-          destination: undefined,
-          digest: undefined,
           index: TEST_URI_INDEX,
           issuer: TEST_ADDRESS_ALICE,
           owner: TEST_ADDRESS_ALICE,
@@ -73,6 +82,31 @@ describe('UriToken controller', () => {
       ]);
     });
 
+    it('should stream URITokens as NDJSON when requested', async () => {
+      const res = getMockedResponse();
+      await uriTokenController.getURITokens(
+        TEST_ADDRESS_ALICE,
+        URI_TOKEN_DEFAULT_PAGE_SIZE,
+        'application/x-ndjson',
+        res as any
+      );
+      expect(res.setHeader).toBeCalledWith('Content-Type', 'application/x-ndjson');
+      const token = {
+        index: TEST_URI_INDEX,
+        issuer: TEST_ADDRESS_ALICE,
+        owner: TEST_ADDRESS_ALICE,
+        uri: TEST_TOKEN_URI,
+      };
+      expect(res.body()).toEqual(JSON.stringify(token) + '\n');
+    });
+
+
+    it.each([1000, 0, -5])('should reject page size: %s outside of the account_objects limit', async (pageSize) => {
+      await expect(
+        uriTokenController.getURITokens(TEST_ADDRESS_ALICE, pageSize, undefined, getMockedResponse() as any)
+      ).rejects.toThrow(BadRequestException);
+    });
+
     it('should return success response on URIToken removal', async () => {
       expect(
         await uriTokenController.removeURIToken(TEST_URI_INDEX, {
@@ -85,4 +119,39 @@ describe('UriToken controller', () => {
       });
     });
   });
+
+  describe('limit query parameter', () => {
+    let app: INestApplication;
+
+    beforeEach(async () => {
+      app = module.createNestApplication();
+      await app.init();
+    });
+
+    afterEach(async () => {
+      await app.close();
+    });
+
+    it.each(['10abc', '-5', '1.5', '1000'])('should answer 400 to limit: %s', async (limit) => {
+      await request(app.getHttpServer()).get(`/uri-tokens/${TEST_ADDRESS_ALICE}?limit=${limit}`).expect(400);
+    });
+
+    it('should default the page size when no limit is given', async () => {
+      await request(app.getHttpServer()).get(`/uri-tokens/${TEST_ADDRESS_ALICE}`).expect(200);
+      expect(mockedUriTokenService.iterateAccountTokens).toHaveBeenLastCalledWith(
+        TEST_ADDRESS_ALICE,
+        URI_TOKEN_DEFAULT_PAGE_SIZE
+      );
+    });
+  });
 });
+
+function getMockedResponse() {
+  const chunks: string[] = [];
+  return {
+    setHeader: jest.fn(),
+    write: jest.fn((chunk: string) => chunks.push(chunk) > 0),
+    end: jest.fn((chunk: string) => chunks.push(chunk)),
+    body: () => chunks.join(''),
+  };
+}
@@ -1,26 +1,61 @@
-import { Body, Controller, Delete, Get, Param, Post } from '@nestjs/common';
+import {
+  BadRequestException,
+  Body,
+  Controller,
+  DefaultValuePipe,
+  Delete,
+  Get,
+  Headers,
+  Param,
+  ParseIntPipe,
+  Post,
+  Query,
+  Res,
+} from '@nestjs/common';
+import { Response } from 'express';
 import { URITokenService } from './uri-token.service';
 import { MintURITokenInputDTO } from './dto/uri-token-input.dto';
-import { URITokenOutputDTO, XRPLBaseResponseDTO } from './dto/uri-token-output.dto';
+import { MintURITokenOutputDTO, URITokenOutputDTO, XRPLBaseResponseDTO } from './dto/uri-token-output.dto';
 import { Account } from '../account/interfaces/account.interface';
+import { getStreamFormat, memoizeJson, streamJson } from '../common/stream.utils';
+import { URI_TOKEN_DEFAULT_PAGE_SIZE, URI_TOKEN_MAX_PAGE_SIZE } from './uri-token.constant';
+import { ConditionalGet } from '../common/conditional-get.interceptor';
 
 @Controller('uri-tokens')
 export class UriTokenController {
+  // tokens served from the ownership index are shared between requests and replaced rather than mutated
+  private readonly serializeToken = memoizeJson<URITokenOutputDTO>();
+
   constructor(private readonly service: URITokenService) {}
 
   @Post()
-  async mintURIToken(@Body() input: MintURITokenInputDTO): Promise<XRPLBaseResponseDTO> {
+  async mintURIToken(@Body() input: MintURITokenInputDTO): Promise<MintURITokenOutputDTO> {
     const result: any = await this.service.mintURIToken(input);
     return {
       tx_hash: result.response.tx_json.hash,
       result: result.response.engine_result,
+      uri_token_id: this.service.getURITokenID(input.account.address, input.uri),
     };
   }
 
   @Get(':address')
-  async getURITokens(@Param('address') address: string): Promise<URITokenOutputDTO[]> {
-    const response = await this.service.getAccountTokens(address);
-    return response;
+  @ConditionalGet('address')
+  async getURITokens(
+    @Param('address') address: string,
+    @Query('limit', new DefaultValuePipe(URI_TOKEN_DEFAULT_PAGE_SIZE), ParseIntPipe) pageSize: number,
+    @Headers('accept') accept: string | undefined,
+    @Res() res: Response
+  ): Promise<void> {
+    // ParseIntPipe answers 400 to anything but an integer, the range is checked here
+    if (pageSize < 1 || pageSize > URI_TOKEN_MAX_PAGE_SIZE) {
+      throw new BadRequestException(`Page size must be between 1 and ${URI_TOKEN_MAX_PAGE_SIZE}`);
+    }
+    await streamJson(
+      res,
+      this.service.iterateAccountTokens(address, pageSize),
+      getStreamFormat(accept),
+      this.serializeToken
+    );
   }
 
   @Delete(':index')
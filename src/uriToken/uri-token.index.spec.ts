@@ -0,0 +1,107 @@
+import { TestBed } from '@automock/jest';
+import { Subject } from 'rxjs';
+import { TransactionStream } from '@transia/xrpl';
+import { URITokenOwnershipIndex, IURITokenPage } from './uri-token.index';
+import { LedgerStreamService } from '../xrpl/client/ledger-stream.service';
+import { TEST_ADDRESS_ALICE, TEST_ADDRESS_BOB, TEST_TOKEN_URI, TEST_URI_INDEX } from '../test-utils/test-utils';
+
+const ALICE_TOKEN = {
+  index: TEST_URI_INDEX,
+  uri: TEST_TOKEN_URI,
+  owner: TEST_ADDRESS_ALICE,
+  issuer: TEST_ADDRESS_ALICE,
+  flags: 0,
+} as any;
+
+const buyTransaction = (ledgerIndex: number): TransactionStream =>
+  ({
+    validated: true,
+    ledger_index: ledgerIndex,
+    meta: {
+      TransactionResult: 'tesSUCCESS',
+      AffectedNodes: [
+        {
+          ModifiedNode: {
+            LedgerEntryType: 'URIToken',
+            LedgerIndex: TEST_URI_INDEX,
+            FinalFields: { Owner: TEST_ADDRESS_BOB, Issuer: TEST_ADDRESS_ALICE, URI: TEST_TOKEN_URI, Flags: 0 },
+            PreviousFields: { Owner: TEST_ADDRESS_ALICE },
+          },
+        },
+      ],
+    },
+  } as any);
+
+async function* pages(...content: IURITokenPage[]) {
+  yield* content;
+}
+
+describe('URITokenOwnershipIndex unit spec', () => {
+  let underTest: URITokenOwnershipIndex;
+  const transactions$ = new Subject<TransactionStream>();
+
+  beforeEach(() => {
+    const { unit } = TestBed.create(URITokenOwnershipIndex)
+      .mock(LedgerStreamService)
+      .using({
+        transactions$: transactions$.asObservable(),
+        reset$: new Subject<void>().asObservable(),
+        isSubscribed: jest.fn().mockReturnValue(true),
+      })
+      .compile();
+    underTest = unit;
+    underTest.onModuleInit();
+  });
+
+  afterEach(() => {
+    underTest.onModuleDestroy();
+  });
+
+  test('should backfill account once and serve later reads from memory', async () => {
+    const loader = jest.fn(() => pages({ ledgerIndex: 10, tokens: [ALICE_TOKEN] }));
+
+    await expect(underTest.getAccountTokens(TEST_ADDRESS_ALICE, loader)).resolves.toEqual([ALICE_TOKEN]);
+    await expect(underTest.getAccountTokens(TEST_ADDRESS_ALICE, loader)).resolves.toEqual([ALICE_TOKEN]);
+
+    expect(loader).toBeCalledTimes(1);
+    expect(underTest.findToken(TEST_ADDRESS_ALICE, TEST_URI_INDEX)).toEqual(ALICE_TOKEN);
+  });
+
+  test('should move token between owners on validated URITokenBuy', async () => {
+    await underTest.getAccountTokens(TEST_ADDRESS_ALICE, () => pages({ ledgerIndex: 10, tokens: [ALICE_TOKEN] }));
+    await underTest.getAccountTokens(TEST_ADDRESS_BOB, () => pages({ ledgerIndex: 10, tokens: [] }));
+
+    transactions$.next(buyTransaction(11));
+
+    expect(underTest.findToken(TEST_ADDRESS_ALICE, TEST_URI_INDEX)).toBeNull();
+    expect(underTest.findToken(TEST_ADDRESS_BOB, TEST_URI_INDEX)).toEqual(
+      expect.objectContaining({ index: TEST_URI_INDEX, owner: TEST_ADDRESS_BOB })
+    );
+  });
+
+  test('should replay only events newer than the backfilled ledger', async () => {
+    let releasePage: () => void;
+    const pageReleased = new Promise<void>((resolve) => (releasePage = resolve));
+    const loader = async function* () {
+      await pageReleased;
+      yield { ledgerIndex: 11, tokens: [ALICE_TOKEN] };
+    };
+
+    const result = underTest.getAccountTokens(TEST_ADDRESS_ALICE, loader);
+    transactions$.next(buyTransaction(11));
+    releasePage();
+
+    await expect(result).resolves.toEqual([ALICE_TOKEN]);
+  });
+
+  test('should not serve accounts from memory when the stream is not subscribed', async () => {
+    const { unit } = TestBed.create(URITokenOwnershipIndex)
+      .mock(LedgerStreamService)
+      .using({ isSubscribed: jest.fn().mockReturnValue(false) })
+      .compile();
+    const loader = jest.fn();
+
+    await expect(unit.getAccountTokens(TEST_ADDRESS_ALICE, loader)).resolves.toBeNull();
+    expect(loader).not.toBeCalled();
+  });
+});
@@ -0,0 +1,175 @@
+import { Injectable, OnModuleDestroy, OnModuleInit } from '@nestjs/common';
+import { TransactionStream } from '@transia/xrpl';
+import { Subscription } from 'rxjs';
+import { LedgerStreamService } from '../xrpl/client/ledger-stream.service';
+import { URITokenOutputDTO } from './dto/uri-token-output.dto';
+import { UriTokenMapper } from './mapper/uri-token.mapper';
+import {
+  URI_TOKEN_INDEX_MAX_ACCOUNT_TOKENS,
+  URI_TOKEN_INDEX_MAX_ACCOUNTS,
+  URITokenIndexStatus,
+} from './uri-token.constant';
+
+export interface IURITokenPage {
+  ledgerIndex: number;
+  tokens: URITokenOutputDTO[];
+}
+
+interface IURITokenChange {
+  index: string;
+  previousOwner?: string;
+  token?: URITokenOutputDTO;
+}
+
+interface IAccountTokens {
+  status: URITokenIndexStatus;
+  tokens: Map<string, URITokenOutputDTO>;
+  buffered: Array<{ ledgerIndex: number; change: IURITokenChange }>;
+  loading?: Promise<void>;
+}
+
+/**
+ * In-memory URIToken ownership index kept current from URIToken nodes of validated transaction metadata
+ * (mint, buy, burn and sell offer create/cancel). Each account is backfilled once from account_objects;
+ * stream events received during the backfill are buffered and replayed on top of the backfilled ledger.
+ */
+@Injectable()
+export class URITokenOwnershipIndex implements OnModuleInit, OnModuleDestroy {
+  private readonly accounts = new Map<string, IAccountTokens>();
+  private readonly subscriptions: Subscription[] = [];
+
+  constructor(private readonly stream: LedgerStreamService) {}
+
+  onModuleInit() {
+    this.subscriptions.push(
+      this.stream.transactions$.subscribe((tx) => this.applyTransaction(tx)),
+      this.stream.reset$.subscribe(() => this.accounts.clear())
+    );
+  }
+
+  onModuleDestroy() {
+    this.subscriptions.forEach((subscription) => subscription.unsubscribe());
+  }
+
+  isReady(account: string): boolean {
+    return this.accounts.get(account)?.status === URITokenIndexStatus.READY;
+  }
+
+  /**
+   * Returns the tokens owned by the account, backfilling it on first use,
+   * or null when the account cannot be served from memory.
+   */
+  async getAccountTokens(
+    account: string,
+    loadPages: () => AsyncIterable<IURITokenPage>
+  ): Promise<URITokenOutputDTO[] | null> {
+    if (!this.stream.isSubscribed()) {
+      return null;
+    }
+    let state = this.accounts.get(account);
+    if (!state) {
+      state = this.track(account, loadPages);
+    }
+    await state.loading;
+    if (state.status !== URITokenIndexStatus.READY) {
+      return null;
+    }
+    this.touch(account, state);
+    return [...state.tokens.values()];
+  }
+
+  findToken(account: string, index: string): URITokenOutputDTO | null {
+    const state = this.accounts.get(account);
+    return state?.status === URITokenIndexStatus.READY ? state.tokens.get(index) || null : null;
+  }
+
+  applyTransaction(tx: TransactionStream) {
+    const changes = this.extractChanges(tx);
+    for (const change of changes) {
+      const owners = new Set([change.previousOwner, change.token?.owner].filter(Boolean));
+      owners.forEach((owner) => {
+        const state = this.accounts.get(owner);
+        if (state?.status === URITokenIndexStatus.LOADING) {
+          state.buffered.push({ ledgerIndex: tx.ledger_index, change });
+        } else if (state?.status === URITokenIndexStatus.READY) {
+          this.applyChange(owner, state, change);
+        }
+      });
+    }
+  }
+
+  private track(account: string, loadPages: () => AsyncIterable<IURITokenPage>): IAccountTokens {
+    const state: IAccountTokens = { status: URITokenIndexStatus.LOADING, tokens: new Map(), buffered: [] };
+    this.accounts.set(account, state);
+    this.evictIfFull();
+    state.loading = this.backfill(account, state, loadPages).catch((err) => {
+      this.accounts.delete(account);
+      throw err;
+    });
+    return state;
+  }
+
+  private async backfill(account: string, state: IAccountTokens, loadPages: () => AsyncIterable<IURITokenPage>) {
+    let backfilledLedger: number;
+    for await (const page of loadPages()) {
+      backfilledLedger = backfilledLedger ?? page.ledgerIndex;
+      page.tokens.forEach((token) => state.tokens.set(token.index, token));
+      if (state.tokens.size > URI_TOKEN_INDEX_MAX_ACCOUNT_TOKENS) {
+        state.status = URITokenIndexStatus.OVERSIZED;
+        state.tokens.clear();
+        state.buffered = [];
+        return;
+      }
+    }
+    state.buffered
+      .filter(({ ledgerIndex }) => backfilledLedger === undefined || ledgerIndex > backfilledLedger)
+      .forEach(({ change }) => this.applyChange(account, state, change));
+    state.buffered = [];
+    state.status = URITokenIndexStatus.READY;
+  }
+
+  private applyChange(account: string, state: IAccountTokens, change: IURITokenChange) {
+    if (change.token?.owner === account) {
+      state.tokens.set(change.index, change.token);
+    } else {
+      state.tokens.delete(change.index);
+    }
+  }
+
+  private extractChanges(tx: TransactionStream): IURITokenChange[] {
+    const meta: any = tx.meta;
+    if (!tx.validated || meta?.TransactionResult !== 'tesSUCCESS') {
+      return [];
+    }
+    return (meta.AffectedNodes || [])
+      .filter((affected) => Object.values<any>(affected)[0]?.LedgerEntryType === 'URIToken')
+      .map((affected): IURITokenChange => {
+        if (affected.DeletedNode) {
+          return { index: affected.DeletedNode.LedgerIndex, previousOwner: affected.DeletedNode.FinalFields?.Owner };
+        }
+        const node = affected.CreatedNode || affected.ModifiedNode;
+        const fields = node.NewFields || node.FinalFields;
+        return {
+          index: node.LedgerIndex,
+          previousOwner: node.PreviousFields?.Owner ?? fields.Owner,
+          token: UriTokenMapper.mapUriTokenToDto({ ...fields, index: node.LedgerIndex }),
+        };
+      });
+  }
+
+  private touch(account: string, state: IAccountTokens) {
+    this.accounts.delete(account);
+    this.accounts.set(account, state);
+  }
+
+  private evictIfFull() {
+    for (const [account, state] of this.accounts) {
+      if (this.accounts.size <= URI_TOKEN_INDEX_MAX_ACCOUNTS) {
+        return;
+      }
+      if (state.status !== URITokenIndexStatus.LOADING) {
+        this.accounts.delete(account);
+      }
+    }
+  }
+}
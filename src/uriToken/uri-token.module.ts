@@ -1,10 +1,11 @@
 import { Module } from '@nestjs/common';
-import { XrplService } from '../xrpl/client/client.service';
 import { UriTokenController } from './uri-token.controller';
 import { URITokenService } from './uri-token.service';
+import { URITokenOwnershipIndex } from './uri-token.index';
 
 @Module({
   controllers: [UriTokenController],
-  providers: [URITokenService, XrplService],
+  providers: [URITokenService, URITokenOwnershipIndex],
+  exports: [URITokenService],
 })
 export class UriTokenModule {}
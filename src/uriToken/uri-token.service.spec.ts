@@ -55,7 +55,6 @@ describe('URITokenService unit spec', () => {
     expect(xrplService.submitTransaction).toBeCalledWith(
       {
         Account: TEST_ADDRESS_ALICE,
-        NetworkID: 21338,
         TransactionType: 'URITokenMint',
         URI: TEST_TOKEN_URI,
       },
@@ -82,7 +81,6 @@ describe('URITokenService unit spec', () => {
     expect(xrplService.submitTransaction).toBeCalledWith(
       {
         Account: TEST_ADDRESS_ALICE,
-        NetworkID: 21338,
         TransactionType: 'URITokenMint',
         URI: TEST_TOKEN_URI,
       },
@@ -138,11 +136,37 @@ describe('URITokenService unit spec', () => {
     expect(xrplService.submitTransaction).toBeCalledWith(
       {
         Account: TEST_ADDRESS_ALICE,
-        NetworkID: 21338,
         TransactionType: 'URITokenBurn',
         URITokenID: 'TEST_TOKEN_URI-TEST_URI_INDEX',
       } as URITokenBurn,
       { address: TEST_ADDRESS_ALICE, secret: TEST_SECRET }
     );
   });
+
+  test('should find URIToken with a single ledger_entry lookup by index', async () => {
+    (xrplService.getLedgerEntryByIndex as jest.Mock).mockResolvedValue({
+      LedgerEntryType: 'URIToken',
+      URI: TEST_TOKEN_URI,
+      index: TEST_URI_INDEX,
+      Issuer: TEST_ADDRESS_ALICE,
+      Owner: TEST_ADDRESS_ALICE,
+      Flags: 1,
+    });
+
+    const token = await underTest.findToken(TEST_ADDRESS_ALICE, TEST_URI_INDEX);
+
+    expect(xrplService.getLedgerEntryByIndex).toBeCalledWith(TEST_URI_INDEX);
+    expect(token).toEqual(expect.objectContaining({ index: TEST_URI_INDEX, owner: TEST_ADDRESS_ALICE, flags: 1 }));
+  });
+
+  test('should not find URIToken owned by another account', async () => {
+    (xrplService.getLedgerEntryByIndex as jest.Mock).mockResolvedValue({
+      LedgerEntryType: 'URIToken',
+      index: TEST_URI_INDEX,
+      Issuer: TEST_ADDRESS_ALICE,
+      Owner: 'rPqH8xKmKGLLiCgiZvXp2kYV4Cr3eNs6Mq',
+    });
+
+    await expect(underTest.findToken(TEST_ADDRESS_ALICE, TEST_URI_INDEX)).resolves.toBeNull();
+  });
 });
@@ -13,37 +13,97 @@ import HookState from '@transia/xrpl/dist/npm/models/ledger/URIToken';
 import { UriTokenMapper } from './mapper/uri-token.mapper';
 import { URITokenOutputDTO } from './dto/uri-token-output.dto';
 import { UriTokenTransactionFactory } from './uri-token.transactionFactory';
+import { URI_TOKEN_DEFAULT_PAGE_SIZE, URI_TOKEN_MAX_PAGE_SIZE } from './uri-token.constant';
+import { IURITokenPage, URITokenOwnershipIndex } from './uri-token.index';
+import { uriTokenKeylet } from '../xrpl/keylet/keylet.utils';
+import { Traced } from '../tracing/tracer';
 
 @Injectable()
 export class URITokenService {
-  constructor(private readonly xrpl: XrplService) {}
+  constructor(private readonly xrpl: XrplService, private readonly index: URITokenOwnershipIndex) {}
 
+  @Traced()
   async mintURIToken(input: MintURITokenInputDTO): Promise<SubmitResponse> {
     const tx: URITokenMint = UriTokenTransactionFactory.prepareURITokenMintTx(input);
     return this.xrpl.submitTransaction(tx, input.account);
   }
 
-  async getAccountTokens(account: string): Promise<URITokenOutputDTO[]> {
-    const tokenReq = {
-      command: 'account_objects',
-      account: account,
-      ledger_index: 'validated',
-      type: 'uri_token',
-      limit: 10,
-    };
-    const response = await this.xrpl.submitRequest<AccountObjectsRequest, AccountObjectsResponse>(
-      tokenReq as AccountObjectsRequest
-    );
-    return response.result.account_objects.map((ledgerObj: HookState) =>
-      UriTokenMapper.mapUriTokenToDto(ledgerObj as unknown as HookState & { Flags: number })
+  @Traced()
+  async getAccountTokens(account: string, pageSize = URI_TOKEN_DEFAULT_PAGE_SIZE): Promise<URITokenOutputDTO[]> {
+    const tokens: URITokenOutputDTO[] = [];
+    for await (const token of this.iterateAccountTokens(account, pageSize)) {
+      tokens.push(token);
+    }
+    return tokens;
+  }
+
+  /**
+   * Yields the account's tokens from the in-memory ownership index when the account can be served from it,
+   * otherwise lazily walks the account_objects pages.
+   */
+  async *iterateAccountTokens(
+    account: string,
+    pageSize = URI_TOKEN_DEFAULT_PAGE_SIZE
+  ): AsyncGenerator<URITokenOutputDTO, void, undefined> {
+    const indexedTokens = await this.index.getAccountTokens(account, () =>
+      this.iterateTokenPages(account, URI_TOKEN_MAX_PAGE_SIZE)
     );
+    if (indexedTokens) {
+      yield* indexedTokens;
+      return;
+    }
+    for await (const page of this.iterateTokenPages(account, pageSize)) {
+      yield* page.tokens;
+    }
   }
 
+  /**
+   * Walks the account_objects pages of an account following the response marker.
+   * All pages are read from the ledger the first page came from, so the listing stays consistent.
+   */
+  async *iterateTokenPages(account: string, pageSize: number): AsyncGenerator<IURITokenPage, void, undefined> {
+    let ledgerIndex: number | string = 'validated';
+    let marker: unknown;
+    do {
+      const tokenReq = {
+        command: 'account_objects',
+        account: account,
+        ledger_index: ledgerIndex,
+        type: 'uri_token',
+        limit: pageSize,
+        ...(marker && { marker }),
+      };
+      const response = await this.xrpl.submitRequest<AccountObjectsRequest, AccountObjectsResponse>(
+        tokenReq as AccountObjectsRequest
+      );
+      ledgerIndex = response.result.ledger_index ?? ledgerIndex;
+      marker = response.result.marker;
+      yield {
+        ledgerIndex: response.result.ledger_index,
+        tokens: response.result.account_objects.map((ledgerObj: HookState) =>
+          UriTokenMapper.mapUriTokenToDto(ledgerObj as unknown as HookState & { Flags: number })
+        ),
+      };
+    } while (marker);
+  }
+
+  @Traced()
   async findToken(address: string, index: string): Promise<URITokenOutputDTO | null> {
-    const accountTokens = await this.getAccountTokens(address);
-    return accountTokens.find((item) => item.index === index) || null;
+    if (this.index.isReady(address)) {
+      return this.index.findToken(address, index);
+    }
+    const ledgerObj = await this.xrpl.getLedgerEntryByIndex<HookState & { Flags: number }>(index);
+    if (!ledgerObj || ledgerObj.LedgerEntryType !== 'URIToken' || ledgerObj.Owner !== address) {
+      return null;
+    }
+    return UriTokenMapper.mapUriTokenToDto(ledgerObj);
+  }
+
+  getURITokenID(issuer: string, uri: string): string {
+    return uriTokenKeylet(issuer, uri);
   }
 
+  @Traced()
   async removeURIToken(account: Account, index: string): Promise<SubmitResponse> {
     const tx: URITokenBurn = UriTokenTransactionFactory.prepareURITokenBurnTx(account, index);
     return this.xrpl.submitTransaction(tx, account);
@@ -1,8 +1,31 @@
-import { Module } from '@nestjs/common';
+import { Global, Module } from '@nestjs/common';
 import { XrplService } from './client/client.service';
+import { LedgerStreamService } from './client/ledger-stream.service';
+import { SigningPool } from './signing/signing.pool';
+import { NetworkStateService } from './client/network-state.service';
+import { SubmissionScheduler } from './client/submission.scheduler';
+import { AccountVersionTracker } from './client/account-version.tracker';
+import { TransactionResubmitter } from './client/transaction.resubmitter';
 
+@Global()
 @Module({
-  providers: [XrplService],
-  exports: [XrplService],
+  providers: [
+    XrplService,
+    LedgerStreamService,
+    SigningPool,
+    NetworkStateService,
+    SubmissionScheduler,
+    AccountVersionTracker,
+    TransactionResubmitter,
+  ],
+  exports: [
+    XrplService,
+    LedgerStreamService,
+    SigningPool,
+    NetworkStateService,
+    SubmissionScheduler,
+    AccountVersionTracker,
+    TransactionResubmitter,
+  ],
 })
 export class ClientModule {}
@@ -0,0 +1,111 @@
+import { TestBed } from '@automock/jest';
+import { Subject } from 'rxjs';
+import { TransactionStream } from '@transia/xrpl';
+import { AccountVersionTracker } from './account-version.tracker';
+import { XrplService } from './client.service';
+import { LedgerStreamService } from './ledger-stream.service';
+import { TEST_ADDRESS_ALICE, TEST_ADDRESS_BOB, TEST_HOOK_HASH, TEST_TX_HASH } from '../../test-utils/test-utils';
+
+const ACCOUNT_ROOT_VERSION = { ledgerIndex: 90, txHash: TEST_TX_HASH };
+
+describe('AccountVersionTracker unit spec', () => {
+  let underTest: AccountVersionTracker;
+  let xrplService: jest.Mocked<XrplService>;
+  let streamService: jest.Mocked<LedgerStreamService>;
+  const transactions$ = new Subject<TransactionStream>();
+  const reset$ = new Subject<void>();
+
+  beforeEach(() => {
+    const { unit, unitRef } = TestBed.create(AccountVersionTracker)
+      .mock(XrplService)
+      .using({
+        submitRequest: jest.fn().mockResolvedValue({
+          result: { account_data: { PreviousTxnID: TEST_TX_HASH, PreviousTxnLgrSeq: 90 } },
+        }),
+      })
+      .mock(LedgerStreamService)
+      .using({
+        transactions$: transactions$.asObservable(),
+        reset$: reset$.asObservable(),
+        isSubscribed: jest.fn().mockReturnValue(true),
+      })
+      .compile();
+    underTest = unit;
+    xrplService = unitRef.get(XrplService);
+    streamService = unitRef.get(LedgerStreamService);
+    underTest.onModuleInit();
+  });
+
+  afterEach(() => {
+    underTest.onModuleDestroy();
+  });
+
+  test('should read the version from the AccountRoot once', async () => {
+    expect(await underTest.getVersion(TEST_ADDRESS_ALICE)).toEqual(ACCOUNT_ROOT_VERSION);
+    expect(await underTest.getVersion(TEST_ADDRESS_ALICE)).toEqual(ACCOUNT_ROOT_VERSION);
+
+    expect(xrplService.submitRequest).toBeCalledTimes(1);
+    expect(xrplService.submitRequest).toBeCalledWith(
+      expect.objectContaining({ command: 'account_info', account: TEST_ADDRESS_ALICE, ledger_index: 'validated' })
+    );
+  });
+
+  test('should advance the version of accounts named by a validated transaction', async () => {
+    await underTest.getVersion(TEST_ADDRESS_ALICE);
+    await underTest.getVersion(TEST_ADDRESS_BOB);
+
+    transactions$.next({
+      validated: true,
+      ledger_index: 95,
+      transaction: { hash: TEST_HOOK_HASH, Account: TEST_ADDRESS_BOB },
+      meta: {
+        AffectedNodes: [{ ModifiedNode: { LedgerEntryType: 'URIToken', FinalFields: { Owner: TEST_ADDRESS_ALICE } } }],
+      },
+    } as any);
+
+    expect(await underTest.getVersion(TEST_ADDRESS_ALICE)).toEqual({ ledgerIndex: 95, txHash: TEST_HOOK_HASH });
+    expect(await underTest.getVersion(TEST_ADDRESS_BOB)).toEqual({ ledgerIndex: 95, txHash: TEST_HOOK_HASH });
+    expect(xrplService.submitRequest).toBeCalledTimes(2);
+  });
+
+  test('should advance the version of accounts whose hook ran', async () => {
+    await underTest.getVersion(TEST_ADDRESS_ALICE);
+
+    transactions$.next({
+      validated: true,
+      ledger_index: 95,
+      transaction: { hash: TEST_HOOK_HASH, Account: TEST_ADDRESS_BOB },
+      meta: { HookExecutions: [{ HookExecution: { HookAccount: TEST_ADDRESS_ALICE } }] },
+    } as any);
+
+    expect(await underTest.getVersion(TEST_ADDRESS_ALICE)).toEqual({ ledgerIndex: 95, txHash: TEST_HOOK_HASH });
+  });
+
+  test('should keep a transaction seen while the AccountRoot is read', async () => {
+    const version = underTest.getVersion(TEST_ADDRESS_ALICE);
+    transactions$.next({
+      validated: true,
+      ledger_index: 95,
+      transaction: { hash: TEST_HOOK_HASH, Account: TEST_ADDRESS_ALICE },
+      meta: {},
+    } as any);
+
+    expect(await version).toEqual({ ledgerIndex: 95, txHash: TEST_HOOK_HASH });
+  });
+
+  test('should read the AccountRoot again after a stream reset', async () => {
+    await underTest.getVersion(TEST_ADDRESS_ALICE);
+    reset$.next();
+    await underTest.getVersion(TEST_ADDRESS_ALICE);
+
+    expect(xrplService.submitRequest).toBeCalledTimes(2);
+  });
+
+  test('should have no version while the stream is down or the account cannot be read', async () => {
+    streamService.isSubscribed.mockReturnValueOnce(false);
+    expect(await underTest.getVersion(TEST_ADDRESS_ALICE)).toBeNull();
+
+    xrplService.submitRequest.mockRejectedValueOnce(new Error('actNotFound'));
+    expect(await underTest.getVersion(TEST_ADDRESS_BOB)).toBeNull();
+  });
+});
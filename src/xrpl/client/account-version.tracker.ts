@@ -0,0 +1,131 @@
+import { Injectable, Logger, OnModuleDestroy, OnModuleInit } from '@nestjs/common';
+import { AccountInfoRequest, AccountInfoResponse, TransactionStream } from '@transia/xrpl';
+import { Subscription } from 'rxjs';
+import { XrplService } from './client.service';
+import { LedgerStreamService } from './ledger-stream.service';
+import { ACCOUNT_VERSION_MAX_ACCOUNTS } from './client.constant';
+
+export interface IAccountVersion {
+  ledgerIndex: number;
+  txHash: string;
+}
+
+// fields of transactions and ledger objects naming an account whose state the transaction may change
+const ACCOUNT_FIELDS = ['Account', 'Destination', 'Owner', 'Issuer'];
+
+/**
+ * Last validated transaction that touched an account, used as the version of everything read for it.
+ * It is taken once from the PreviousTxnID and PreviousTxnLgrSeq of the AccountRoot, then advanced by every
+ * validated transaction naming the account in its fields, its affected nodes or its hook executions, so
+ * answering with a known version needs no request to rippled.
+ */
+@Injectable()
+export class AccountVersionTracker implements OnModuleInit, OnModuleDestroy {
+  private readonly versions = new Map<string, IAccountVersion>();
+  private readonly loading = new Map<string, Promise<IAccountVersion | null>>();
+  private readonly subscriptions: Subscription[] = [];
+  // bumped on every stream reset, versions loaded across a reset may have missed a transaction
+  private generation = 0;
+
+  constructor(
+    private readonly xrpl: XrplService,
+    private readonly stream: LedgerStreamService
+  ) {}
+
+  onModuleInit() {
+    this.subscriptions.push(
+      this.stream.transactions$.subscribe((tx) => this.applyTransaction(tx)),
+      this.stream.reset$.subscribe(() => {
+        this.generation++;
+        this.versions.clear();
+      })
+    );
+  }
+
+  onModuleDestroy() {
+    this.subscriptions.forEach((subscription) => subscription.unsubscribe());
+  }
+
+  /**
+   * Version of the account, or null while the stream is down (changes could go unnoticed)
+   * and for accounts whose AccountRoot cannot be read.
+   */
+  async getVersion(account: string): Promise<IAccountVersion | null> {
+    if (!this.stream.isSubscribed()) {
+      return null;
+    }
+    const known = this.versions.get(account);
+    if (known) {
+      this.versions.delete(account);
+      this.versions.set(account, known);
+      return known;
+    }
+    let loading = this.loading.get(account);
+    if (!loading) {
+      loading = this.load(account).finally(() => this.loading.delete(account));
+      this.loading.set(account, loading);
+    }
+    return loading;
+  }
+
+  applyTransaction(tx: TransactionStream) {
+    if (!tx.validated) {
+      return;
+    }
+    const version = { ledgerIndex: tx.ledger_index, txHash: tx.transaction.hash };
+    touchedAccounts(tx).forEach((account) => {
+      if (this.versions.has(account) || this.loading.has(account)) {
+        this.versions.set(account, version);
+      }
+    });
+  }
+
+  private async load(account: string): Promise<IAccountVersion | null> {
+    const generation = this.generation;
+    let response: AccountInfoResponse;
+    try {
+      response = await this.xrpl.submitRequest<AccountInfoRequest, AccountInfoResponse>({
+        command: 'account_info',
+        account,
+        ledger_index: 'validated',
+      });
+    } catch (err) {
+      Logger.debug(`Version of account: ${account} could not be read: ${err?.message}`);
+      return null;
+    }
+    if (generation !== this.generation) {
+      return null;
+    }
+    const { PreviousTxnID, PreviousTxnLgrSeq } = response.result.account_data;
+    const current = this.versions.get(account);
+    // a transaction seen on the stream while the AccountRoot was read is at least as recent
+    if (current && current.ledgerIndex >= PreviousTxnLgrSeq) {
+      return current;
+    }
+    const version = { ledgerIndex: PreviousTxnLgrSeq, txHash: PreviousTxnID };
+    this.versions.set(account, version);
+    if (this.versions.size > ACCOUNT_VERSION_MAX_ACCOUNTS) {
+      this.versions.delete(this.versions.keys().next().value);
+    }
+    return version;
+  }
+}
+
+function touchedAccounts(tx: TransactionStream): Set<string> {
+  const meta: any = tx.meta;
+  const accounts = new Set<string>();
+  const collect = (fields: Record<string, any> | undefined) => {
+    for (const name of ACCOUNT_FIELDS) {
+      if (typeof fields?.[name] === 'string') {
+        accounts.add(fields[name]);
+      }
+    }
+  };
+  collect(tx.transaction);
+  (meta?.AffectedNodes ?? []).forEach((affected) => {
+    const node: any = Object.values(affected)[0];
+    [node?.NewFields, node?.FinalFields, node?.PreviousFields].forEach(collect);
+  });
+  (meta?.HookExecutions ?? []).forEach(({ HookExecution }) => collect({ Account: HookExecution?.HookAccount }));
+  return accounts;
+}
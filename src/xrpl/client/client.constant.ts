@@ -5,6 +5,7 @@ import {
   RippledNotInitializedError,
   UnexpectedError,
 } from '@transia/xrpl/dist/npm/errors';
+import { XRPL_RESPONSE_CODE } from './interfaces/xrpl.interface';
 
 export const CONNECTION_ERRORS: string[] = [
   NotConnectedError.name,
@@ -16,3 +17,74 @@ export const CONNECTION_ERRORS: string[] = [
 ];
 
 export const XRPL_INTERNAL_ERRORS: string[] = [NotFoundError.name, RippledError.name];
+
+// account_namespace page size used when walking large hook namespaces
+export const ACCOUNT_NAMESPACE_PAGE_SIZE = parseInt(process.env.ACCOUNT_NAMESPACE_PAGE_SIZE || '256');
+
+// commands with side effects on the connection or the ledger are never shared between callers
+export const NON_COALESCED_COMMANDS: string[] = ['submit', 'submit_multisigned', 'subscribe', 'unsubscribe'];
+
+// network id assumed until the server reports its own, transactions are given a NetworkID from it when filled
+export const NETWORK_ID = parseInt(process.env.NETWORK_ID || '21338');
+
+// networks with an id up to this value do not accept the NetworkID field
+export const LEGACY_NETWORK_ID_MAX = 1024;
+
+// ledgers a transaction may wait for inclusion before it expires
+export const LAST_LEDGER_SEQUENCE_OFFSET = parseInt(process.env.LAST_LEDGER_SEQUENCE_OFFSET || '20');
+
+// multiplier on the open ledger fee, absorbing fee escalation between two ledger closes
+export const FEE_CUSHION = parseFloat(process.env.FEE_CUSHION || '1.2');
+
+// lower values are dispatched first when several accounts have submissions waiting
+export enum SubmissionPriority {
+  // transactions returning a rented URIToken, delaying them risks missing the rental deadline
+  RETURN = 0,
+  DEFAULT = 1,
+}
+
+// submissions sent to the server at once across all accounts, one account never has more than one in flight
+export const SUBMISSION_MAX_IN_FLIGHT = parseInt(process.env.SUBMISSION_MAX_IN_FLIGHT || '8');
+
+// waiting submissions above which new ones are refused with 429
+export const SUBMISSION_MAX_QUEUED = parseInt(process.env.SUBMISSION_MAX_QUEUED || '500');
+export const SUBMISSION_MAX_QUEUED_PER_ACCOUNT = parseInt(process.env.SUBMISSION_MAX_QUEUED_PER_ACCOUNT || '16');
+
+// accounts whose version (last validated transaction touching them) is kept to answer conditional GETs
+export const ACCOUNT_VERSION_MAX_ACCOUNTS = parseInt(process.env.ACCOUNT_VERSION_MAX_ACCOUNTS || '10000');
+
+// preliminary results of transient contention, the signed blob is submitted again on every ledger close
+export const RESUBMITTED_ENGINE_RESULTS: string[] = [
+  XRPL_RESPONSE_CODE.QUEUED,
+  XRPL_RESPONSE_CODE.PRE_SEQ,
+  XRPL_RESPONSE_CODE.CAN_NOT_QUEUE,
+];
+
+// resubmissions of a held transaction before it is given up, its LastLedgerSequence usually ends it first
+export const RESUBMIT_MAX_ATTEMPTS = parseInt(process.env.RESUBMIT_MAX_ATTEMPTS || '10');
+
+// rippled/Xahau nodes, comma separated in SERVER_API_ENDPOINT, the first one also carries the ledger stream
+export const SERVER_API_ENDPOINTS: string[] = (
+  process.env.SERVER_API_ENDPOINT || 'wss://hooks-testnet-v3.xrpl-labs.com'
+)
+  .split(',')
+  .map((endpoint) => endpoint.trim())
+  .filter((endpoint) => endpoint.length > 0);
+
+// interval of the ledger_closed probe measuring round trip time and ledger freshness of every endpoint
+export const ENDPOINT_PROBE_INTERVAL_MS = parseInt(process.env.ENDPOINT_PROBE_INTERVAL_MS || '5000');
+
+// closed ledgers an endpoint may trail the most advanced one by before reads avoid it
+export const ENDPOINT_MAX_LEDGER_LAG = parseInt(process.env.ENDPOINT_MAX_LEDGER_LAG || '2');
+
+// wait for the fastest endpoint before a hedged read is also sent to the next one, 0 disables hedging
+export const ENDPOINT_HEDGE_DELAY_MS = parseInt(process.env.ENDPOINT_HEDGE_DELAY_MS || '0');
+
+// endpoints a signed transaction is submitted to at once, each relays it to its own peers
+export const ENDPOINT_SUBMIT_FANOUT = parseInt(process.env.ENDPOINT_SUBMIT_FANOUT || '2');
+
+// weight of the latest probe in the smoothed round trip time of an endpoint
+export const ENDPOINT_RTT_SMOOTHING = 0.2;
+
+// reads on the request path of the API whose tail latency is worth a duplicate request
+export const HEDGED_COMMANDS: string[] = ['account_info', 'account_objects', 'account_namespace', 'ledger_entry'];
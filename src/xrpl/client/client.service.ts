@@ -1,50 +1,179 @@
-import { Injectable, Logger, ServiceUnavailableException } from '@nestjs/common';
-import { Client, SubmitResponse, Transaction } from '@transia/xrpl';
+import { Injectable, Logger, NotFoundException, ServiceUnavailableException } from '@nestjs/common';
+import {
+  AccountInfoRequest,
+  AccountInfoResponse,
+  Client,
+  LedgerEntryRequest,
+  LedgerEntryResponse,
+  SubmitResponse,
+  Transaction,
+} from '@transia/xrpl';
 import { Account } from '../../account/interfaces/account.interface';
-import * as process from 'process';
 import { BaseRequest, BaseResponse } from '@transia/xrpl/dist/npm/models/methods/baseMethod';
-import { derive, signAndSubmit, utils, XRPL_Account, XrplClient } from 'xrpl-accountlib';
+import { utils, XRPL_Account, XrplClient } from 'xrpl-accountlib';
 import { BaseTransaction } from '@transia/xrpl/dist/npm/models/transactions/common';
-import { IHookNamespaceInfo } from './interfaces/namespace.interface';
-import { ICompleteXrplTx } from './interfaces/xrpl.interface';
+import { IHookNamespaceInfo, INamespaceResult } from './interfaces/namespace.interface';
+import { ISubmissionEvent, XRPL_RESPONSE_CODE, XRPL_RESULT_PREFIX } from './interfaces/xrpl.interface';
+import { SigningPool } from '../signing/signing.pool';
+import { NetworkStateService } from './network-state.service';
+import { Observable, Subject } from 'rxjs';
+import { ICoalescingStats, RequestCoalescer, stableStringify } from './request-coalescer';
+import {
+  HEDGED_COMMANDS,
+  NON_COALESCED_COMMANDS,
+  RESUBMITTED_ENGINE_RESULTS,
+  SERVER_API_ENDPOINTS,
+  SubmissionPriority,
+} from './client.constant';
+import { ISubmissionSchedulerStats, SubmissionScheduler } from './submission.scheduler';
+import { Counter, Histogram, MetricsRegistry } from '../../metrics/metrics.registry';
+import { Traced, tracer } from '../../tracing/tracer';
 import { ClientErrorhandler } from './client.error.handler';
+import { EndpointPool, IEndpointPoolStats } from './endpoint.pool';
 
 @Injectable()
 export class XrplService {
-  private readonly client = new Client(process.env.SERVER_API_ENDPOINT || 'wss://hooks-testnet-v3.xrpl-labs.com');
-  private readonly xrpl_client = new XrplClient(
-    process.env.SERVER_API_ENDPOINT || 'wss://hooks-testnet-v3.xrpl-labs.com'
-  );
+  private readonly pool = new EndpointPool(SERVER_API_ENDPOINTS, (reason) => this.endpointRetries.inc({ reason }));
+  private readonly xrpl_client = new XrplClient(SERVER_API_ENDPOINTS);
+  private readonly submissionSubject = new Subject<ISubmissionEvent>();
+  private readonly readCoalescer = new RequestCoalescer();
+  private readonly requestDuration: Histogram;
+  private readonly engineResults: Counter;
+  private readonly coalescedReads: Counter;
+  private readonly endpointRetries: Counter;
+
+  // signed transactions, emitted before the blob is sent and again with the preliminary engine result
+  readonly submissions$: Observable<ISubmissionEvent> = this.submissionSubject.asObservable();
+
+  constructor(
+    private readonly signingPool: SigningPool,
+    private readonly networkState: NetworkStateService,
+    private readonly scheduler: SubmissionScheduler,
+    metrics: MetricsRegistry
+  ) {
+    this.requestDuration = metrics.histogram(
+      'xrpl_request_duration_seconds',
+      'Latency of XRPL requests by command and whether the node answered',
+      ['command', 'outcome']
+    );
+    this.engineResults = metrics.counter('xrpl_engine_results_total', 'Preliminary results of submitted transactions', [
+      'transaction_type',
+      'engine_result',
+    ]);
+    this.coalescedReads = metrics.counter(
+      'xrpl_read_coalescing_requests_total',
+      'Reads sent upstream or shared with one in flight',
+      ['result']
+    );
+    this.endpointRetries = metrics.counter(
+      'xrpl_endpoint_retries_total',
+      'Requests also sent to a second endpoint, by hedge or failover',
+      ['reason']
+    );
+    this.registerQueueGauges(metrics);
+  }
 
+  /**
+   * Concurrent identical reads share one upstream request, so the response may be handed to several
+   * callers at once and must be treated as read-only.
+   */
   async submitRequest<T extends BaseRequest, K extends BaseResponse>(requestInput: T): Promise<K> {
-    Logger.log(`Request to XRPL: ${requestInput.command} fired`);
-    try {
-      const response = await (await this.getClient()).request<T, K>(requestInput);
-      Logger.log(`Request to XRPL: ${requestInput.command} passed successfully`);
-      return response;
-    } catch (err) {
-      ClientErrorhandler.handleRequestError<T>(err, requestInput);
+    if (NON_COALESCED_COMMANDS.includes(requestInput.command)) {
+      return this.fireRequest<T, K>(requestInput);
     }
+    let isFired = false;
+    const response = this.readCoalescer.run(stableStringify(requestInput), () => {
+      isFired = true;
+      return this.fireRequest<T, K>(requestInput);
+    });
+    this.coalescedReads.inc({ result: isFired ? 'fired' : 'shared' });
+    return response;
+  }
+
+  getReadCoalescingStats(): ICoalescingStats {
+    return this.readCoalescer.getStats();
+  }
+
+  /**
+   * Queued in the lane of the account, so Sequence allocation, signing and submit of one account never interleave.
+   */
+  @Traced()
+  async submitTransaction(
+    tx: Transaction,
+    account: Account,
+    priority: SubmissionPriority = SubmissionPriority.DEFAULT
+  ): Promise<SubmitResponse> {
+    return this.scheduler.schedule(account.address, priority, () => this.signAndSubmit(tx, account));
+  }
+
+  getSubmissionStats(): ISubmissionSchedulerStats {
+    return this.scheduler.getStats();
   }
 
-  async submitTransaction(tx: Transaction, account: Account): Promise<SubmitResponse> {
+  @Traced()
+  private async signAndSubmit(tx: Transaction, account: Account): Promise<SubmitResponse> {
     Logger.log(`Submission of transaction: ${tx.TransactionType} has started`);
     let submitRes;
+    let isHeld = false;
     try {
-      const { authorizedAccount, newTx } = await this.fillTxWithAdditionalInfo(account, tx);
-      submitRes = await signAndSubmit(newTx, this.xrpl_client, authorizedAccount);
+      const newTx = await this.fillTxWithAdditionalInfo(account, tx);
+      // the hash is known locally once signed, so the submission is announced before it can be validated
+      const signed = await tracer.trace('SigningPool.sign', () => this.signingPool.sign(newTx, account.secret));
+      const submission: ISubmissionEvent = {
+        hash: signed.hash,
+        transactionType: newTx.TransactionType,
+        account: newTx.Account,
+        lastLedgerSequence: newTx.LastLedgerSequence,
+        signedTransaction: signed.signedTransaction,
+      };
+      this.submissionSubject.next(submission);
+      const response = await this.timed('submit', () =>
+        tracer.trace('xrpl submit', async () => (await this.pool.submit(signed.signedTransaction)).result, {
+          'xrpl.command': 'submit',
+          'xrpl.tx_hash': signed.hash,
+        })
+      );
+      this.engineResults.inc({ transaction_type: newTx.TransactionType, engine_result: response?.engine_result });
+      submitRes = { tx_id: signed.hash, signedTransaction: signed.signedTransaction, response };
+      this.submissionSubject.next({ ...submission, engineResult: response?.engine_result });
+      // the resubmitted blob keeps its Sequence, so the allocation stays as it is
+      isHeld = isHeldForResubmission(response?.engine_result, newTx.LastLedgerSequence);
+      if (!isHeld && !isSequenceConsumed(response?.engine_result)) {
+        this.networkState.releaseSequences(account.address);
+      }
     } catch (err) {
+      this.networkState.releaseSequences(account.address);
       Logger.error(err);
       throw new ServiceUnavailableException(`Transaction submission failure: ${err?.message}`);
     }
+    if (isHeld) {
+      Logger.log(`Transaction: ${tx.TransactionType} got: ${submitRes.response.engine_result}, held for resubmission`);
+      return submitRes;
+    }
     ClientErrorhandler.handleResponse(submitRes, tx);
     Logger.log(`Submission of transaction: ${tx.TransactionType} has been submitted successfully`);
     return submitRes;
   }
 
+  /**
+   * Sends an already signed blob as it is, it keeps its Sequence and hash. Not queued in the account lane:
+   * nothing is allocated for it.
+   */
+  async submitSignedTransaction(signedTransaction: string) {
+    return this.timed('submit', () =>
+      tracer.trace('xrpl submit', async () => (await this.pool.submit(signedTransaction)).result, {
+        'xrpl.command': 'submit',
+      })
+    );
+  }
+
+  // connection of the first endpoint, the one carrying subscriptions
   public async getClient(): Promise<Client> {
-    await this.client.connect();
-    return this.client;
+    return this.pool.getStreamClient();
+  }
+
+  getEndpointStats(): IEndpointPoolStats {
+    return this.pool.getStats();
   }
 
   async getAccountNamespace(accountNumber: string, namespace: string): Promise<IHookNamespaceInfo> {
@@ -56,30 +185,187 @@ export class XrplService {
     return await this.submitRequest<any, IHookNamespaceInfo>(accountNSReq);
   }
 
-  private async fillTxWithAdditionalInfo<T extends BaseTransaction>(
-    account: Account,
-    tx: T
-  ): Promise<ICompleteXrplTx<T>> {
-    const authorizedAccount = this.getAuthorizedAccount(account.secret);
+  /**
+   * Walks the account_namespace pages of a hook namespace following the response marker.
+   * Follow-up pages are pinned to the ledger of the first page, so the state is read from a single ledger.
+   */
+  async *iterateAccountNamespace(
+    accountNumber: string,
+    namespace: string,
+    pageSize: number
+  ): AsyncGenerator<INamespaceResult, void, undefined> {
+    let ledgerIndex: number | undefined;
+    let marker: unknown;
+    do {
+      const accountNSReq = {
+        command: 'account_namespace',
+        account: accountNumber,
+        namespace_id: namespace,
+        limit: pageSize,
+        ...(ledgerIndex && { ledger_index: ledgerIndex }),
+        ...(marker && { marker }),
+      };
+      const response = await this.submitRequest<any, IHookNamespaceInfo>(accountNSReq);
+      ledgerIndex = ledgerIndex ?? response.result.ledger_index ?? response.result.ledger_current_index;
+      marker = response.result.marker;
+      yield response.result;
+    } while (marker);
+  }
+
+  async getLedgerEntryByIndex<T>(index: string): Promise<T | null> {
+    const ledgerEntryReq: LedgerEntryRequest = {
+      command: 'ledger_entry',
+      index,
+      ledger_index: 'validated',
+    };
+    try {
+      const response = await this.submitRequest<LedgerEntryRequest, LedgerEntryResponse>(ledgerEntryReq);
+      return (response?.result?.node as T) ?? null;
+    } catch (err) {
+      if (err instanceof NotFoundException) {
+        return null;
+      }
+      throw err;
+    }
+  }
+
+  private fireRequest<T extends BaseRequest, K extends BaseResponse>(requestInput: T): Promise<K> {
+    return tracer.trace(`xrpl ${requestInput.command}`, () => this.sendRequest<T, K>(requestInput), {
+      'xrpl.command': requestInput.command,
+    });
+  }
+
+  private async sendRequest<T extends BaseRequest, K extends BaseResponse>(requestInput: T): Promise<K> {
+    Logger.debug(`Request to XRPL: ${requestInput.command} fired`);
+    try {
+      const response = await this.timed(requestInput.command, () =>
+        this.pool.request<T, K>(requestInput, HEDGED_COMMANDS.includes(requestInput.command))
+      );
+      Logger.debug(`Request to XRPL: ${requestInput.command} passed successfully`);
+      return response;
+    } catch (err) {
+      ClientErrorhandler.handleRequestError<T>(err, requestInput);
+    }
+  }
+
+  // failed requests are observed too, under outcome="error"
+  private async timed<R>(command: string, execute: () => Promise<R>): Promise<R> {
+    const stopTimer = this.requestDuration.startTimer({ command });
+    let outcome = 'error';
+    try {
+      const result = await execute();
+      outcome = 'success';
+      return result;
+    } finally {
+      stopTimer({ outcome });
+    }
+  }
+
+  // only the address is needed for Sequence and fee lookup, key derivation is left to the signing pool
+  @Traced()
+  private async fillTxWithAdditionalInfo<T extends BaseTransaction>(account: Account, tx: T): Promise<T> {
     try {
-      const networkInfo = await utils.txNetworkAndAccountValues(this.xrpl_client, authorizedAccount);
-      Logger.log(networkInfo);
-      const newTx: T = {
+      if (this.networkState.isReady()) {
+        const txValues = await this.networkState.getTxValues(account.address, () =>
+          this.getAccountSequence(account.address)
+        );
+        return { ...tx, ...txValues };
+      }
+      const networkInfo = await utils.txNetworkAndAccountValues(this.xrpl_client, {
+        address: account.address,
+      } as XRPL_Account);
+      Logger.debug({ msg: 'Network and account values of transaction filled', ...networkInfo.txValues });
+      return {
         ...tx,
         ...networkInfo.txValues,
       };
-      return { authorizedAccount, newTx };
     } catch (err) {
       Logger.error(`Failure in retrieving additional info for transaction: ${err.message}`);
       throw new Error('Failure in retrieving additional info for transaction');
     }
   }
 
-  private getAuthorizedAccount(secret: string): XRPL_Account {
-    try {
-      return derive.familySeed(secret);
-    } catch (err) {
-      throw new Error('Invalid account info');
-    }
+  // sampled when /metrics is scraped
+  private registerQueueGauges(metrics: MetricsRegistry) {
+    metrics.gauge(
+      'xrpl_submission_queue',
+      'Submissions waiting for their account lane or running',
+      ['state'],
+      (gauge) => {
+        const stats = this.scheduler.getStats();
+        gauge.set({ state: 'queued' }, stats.queued);
+        gauge.set({ state: 'in_flight' }, stats.inFlight);
+      }
+    );
+    metrics.gauge('xrpl_signing_pool_jobs', 'Signing jobs waiting for a worker or being signed', ['state'], (gauge) => {
+      const stats = this.signingPool.getStats();
+      gauge.set({ state: 'queued' }, stats.queued);
+      gauge.set({ state: 'busy' }, stats.busy);
+    });
+    metrics.gauge('xrpl_signing_queue_wait_seconds_max', 'Longest wait of a signing job for a worker', [], (gauge) =>
+      gauge.set({}, this.signingPool.getStats().queueWaitMs.max / 1000)
+    );
+    metrics.gauge('xrpl_read_coalescing_in_flight', 'Reads sent upstream and not answered yet', [], (gauge) =>
+      gauge.set({}, this.readCoalescer.getStats().inFlight)
+    );
+    metrics.gauge(
+      'xrpl_endpoint_rtt_seconds',
+      'Smoothed round trip time of the ledger probe of each endpoint',
+      ['endpoint'],
+      (gauge) =>
+        this.pool
+          .getStats()
+          .endpoints.filter(({ rttMs }) => rttMs !== undefined)
+          .forEach(({ url, rttMs }) => gauge.set({ endpoint: url }, rttMs / 1000))
+    );
+    metrics.gauge(
+      'xrpl_endpoint_ledger_lag',
+      'Closed ledgers an endpoint trails the most advanced one by',
+      ['endpoint'],
+      (gauge) => {
+        const endpoints = this.pool.getStats().endpoints.filter(({ ledgerIndex }) => ledgerIndex !== undefined);
+        const newest = Math.max(0, ...endpoints.map(({ ledgerIndex }) => ledgerIndex));
+        endpoints.forEach(({ url, ledgerIndex }) => gauge.set({ endpoint: url }, newest - ledgerIndex));
+      }
+    );
+    metrics.gauge('xrpl_endpoint_healthy', 'Endpoints reads are sent to, 1 when healthy', ['endpoint'], (gauge) =>
+      this.pool.getStats().endpoints.forEach(({ url, healthy }) => gauge.set({ endpoint: url }, healthy ? 1 : 0))
+    );
   }
+
+  private async getAccountSequence(address: string): Promise<number> {
+    const accountInfoReq: AccountInfoRequest = {
+      command: 'account_info',
+      account: address,
+      ledger_index: 'current',
+    };
+    const response = await this.submitRequest<AccountInfoRequest, AccountInfoResponse>(accountInfoReq);
+    return response.result.account_data.Sequence;
+  }
+}
+
+// results after which the sequence of the transaction is used or will be once the queued transaction applies
+function isSequenceConsumed(engineResult?: string): boolean {
+  return (
+    engineResult?.startsWith(XRPL_RESULT_PREFIX.SUCCESS) ||
+    engineResult?.startsWith(XRPL_RESULT_PREFIX.CLAIMED_COST_ONLY) ||
+    engineResult === XRPL_RESPONSE_CODE.QUEUED
+  );
+}
+
+// transient contention, the TransactionResubmitter sends the blob again while its LastLedgerSequence allows
+export function isHeldForResubmission(engineResult?: string, lastLedgerSequence?: number): boolean {
+  return lastLedgerSequence !== undefined && RESUBMITTED_ENGINE_RESULTS.includes(engineResult);
+}
+
+/**
+ * A submission that applied provisionally or is held for resubmission, as returned by submitTransaction:
+ * either can still validate, only its validation tells whether it took effect.
+ */
+export function isSubmissionPending(submitted: any): boolean {
+  const engineResult = submitted?.response?.engine_result;
+  return (
+    engineResult === XRPL_RESPONSE_CODE.SUCCESS.valueOf() ||
+    isHeldForResubmission(engineResult, submitted?.response?.tx_json?.LastLedgerSequence)
+  );
 }
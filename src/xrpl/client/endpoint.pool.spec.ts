@@ -0,0 +1,181 @@
+import { AddressInfo } from 'node:net';
+import { WebSocketServer } from 'ws';
+import { EndpointPool } from './endpoint.pool';
+import { TEST_ADDRESS_ALICE } from '../../test-utils/test-utils';
+
+const HEDGE_DELAY_MS = 30;
+
+// rippled node answering every request after its own latency, tagging results with its index
+class StubNode {
+  readonly commands: string[] = [];
+  delayMs: number;
+  ledgerIndex = 100;
+  // the socket is closed instead of answering, like a node going away under a request
+  isDropping = false;
+  private server: WebSocketServer;
+
+  constructor(
+    private readonly index: number,
+    delayMs: number
+  ) {
+    this.delayMs = delayMs;
+  }
+
+  start(): Promise<string> {
+    this.server = new WebSocketServer({ host: '127.0.0.1', port: 0 });
+    this.server.on('connection', (socket) =>
+      socket.on('message', (data) => {
+        const request = JSON.parse(data.toString());
+        this.commands.push(request.command);
+        if (this.isDropping && request.command !== 'ledger_closed') {
+          socket.terminate();
+          return;
+        }
+        setTimeout(() => socket.send(JSON.stringify(this.answer(request))), this.delayMs);
+      })
+    );
+    return new Promise((resolve) =>
+      this.server.on('listening', () => resolve(`ws://127.0.0.1:${(this.server.address() as AddressInfo).port}`))
+    );
+  }
+
+  stop(): Promise<void> {
+    this.server.clients.forEach((socket) => socket.terminate());
+    return new Promise((resolve) => this.server.close(() => resolve()));
+  }
+
+  private answer(request) {
+    if (request.command === 'account_info' && request.account !== TEST_ADDRESS_ALICE) {
+      return { id: request.id, type: 'response', status: 'error', error: 'actNotFound', error_code: 19, request };
+    }
+    if (typeof request.ledger_index === 'number' && request.ledger_index > this.ledgerIndex) {
+      return { id: request.id, type: 'response', status: 'error', error: 'lgrNotFound', error_code: 21, request };
+    }
+    const result =
+      request.command === 'ledger_closed'
+        ? { ledger_hash: 'HASH', ledger_index: this.ledgerIndex }
+        : { node: this.index, engine_result: 'tesSUCCESS' };
+    return { id: request.id, type: 'response', status: 'success', result };
+  }
+}
+
+class TestEndpointPool extends EndpointPool {
+  protected readonly probeIntervalMs = 60_000;
+  protected readonly maxLedgerLag = 2;
+  protected readonly hedgeDelayMs = HEDGE_DELAY_MS;
+  protected readonly submitFanout = 2;
+}
+
+describe('EndpointPool unit spec', () => {
+  let nodes: StubNode[];
+  let underTest: TestEndpointPool;
+  let retries: string[];
+
+  async function startPool(delaysMs: number[]) {
+    nodes = delaysMs.map((delayMs, index) => new StubNode(index, delayMs));
+    retries = [];
+    const urls = await Promise.all(nodes.map((node) => node.start()));
+    underTest = new TestEndpointPool(urls, (reason) => retries.push(reason));
+    await underTest.getStreamClient();
+    await underTest.probe();
+  }
+
+  function accountInfo(hedged = false, account = TEST_ADDRESS_ALICE): Promise<any> {
+    return underTest.request({ command: 'account_info', account }, hedged);
+  }
+
+  afterEach(async () => {
+    await underTest.close();
+    await Promise.all(nodes.map((node) => node.stop()));
+  });
+
+  test('should send reads to the endpoint with the lowest round trip time', async () => {
+    await startPool([40, 5, 20]);
+
+    const response = await accountInfo();
+
+    expect(response.result.node).toEqual(1);
+    expect(nodes.map((node) => node.commands.includes('account_info'))).toEqual([false, true, false]);
+    expect(underTest.getStats().endpoints.map(({ healthy }) => healthy)).toEqual([true, true, true]);
+  });
+
+  test('should avoid an endpoint trailing the others by more closed ledgers than allowed', async () => {
+    await startPool([5, 30]);
+    nodes[0].ledgerIndex = 100;
+    nodes[1].ledgerIndex = 110;
+    await underTest.probe();
+
+    const response = await accountInfo();
+
+    expect(response.result.node).toEqual(1);
+    expect(underTest.getStats().endpoints.map(({ healthy }) => healthy)).toEqual([false, true]);
+  });
+
+  test('should hedge a read the fastest endpoint is slow to answer', async () => {
+    await startPool([5, 10]);
+    nodes[0].delayMs = 500;
+
+    const response = await accountInfo(true);
+
+    expect(response.result.node).toEqual(1);
+    expect(nodes.map((node) => node.commands.includes('account_info'))).toEqual([true, true]);
+    expect(underTest.getStats().hedges).toEqual(1);
+    expect(retries).toEqual(['hedge']);
+  });
+
+  test('should not hedge reads that are not marked for it', async () => {
+    await startPool([5, 10]);
+    nodes[0].delayMs = 2 * HEDGE_DELAY_MS;
+
+    const response = await accountInfo();
+
+    expect(response.result.node).toEqual(0);
+    expect(nodes[1].commands).not.toContain('account_info');
+  });
+
+  test('should fail over to the next endpoint when the fastest one drops the request', async () => {
+    await startPool([5, 20]);
+    nodes[0].isDropping = true;
+
+    const response = await accountInfo();
+
+    expect(response.result.node).toEqual(1);
+    expect(underTest.getStats().failovers).toEqual(1);
+    expect(retries).toEqual(['failover']);
+    expect(underTest.getStats().endpoints[0].healthy).toEqual(false);
+  });
+
+  test('should return the error an endpoint answered with without asking another one', async () => {
+    await startPool([5, 20]);
+
+    await expect(accountInfo(true, 'rUnfundedAccount')).rejects.toMatchObject({ name: 'RippledError' });
+    expect(nodes[1].commands).not.toContain('account_info');
+  });
+
+  test('should send a read pinned to a ledger only to the endpoints that closed it, without hedging', async () => {
+    await startPool([5, 20]);
+    nodes[0].ledgerIndex = 100;
+    nodes[1].ledgerIndex = 102;
+    await underTest.probe();
+
+    const response: any = await underTest.request(
+      { command: 'account_objects', account: TEST_ADDRESS_ALICE, ledger_index: 102, marker: 'page2' },
+      true
+    );
+
+    expect(response.result.node).toEqual(1);
+    expect(nodes[0].commands).not.toContain('account_objects');
+    expect(retries).toEqual([]);
+  });
+
+  test('should submit to the fastest endpoints and answer with the result of the fastest', async () => {
+    await startPool([20, 5, 40]);
+
+    const response = await underTest.submit('BLOB');
+    await new Promise((resolve) => setTimeout(resolve, 60));
+
+    expect(response.result.engine_result).toEqual('tesSUCCESS');
+    expect((response.result as any).node).toEqual(1);
+    expect(nodes.map((node) => node.commands.includes('submit'))).toEqual([true, true, false]);
+  });
+});
@@ -0,0 +1,282 @@
+import { Logger } from '@nestjs/common';
+import { Client, LedgerClosedRequest, LedgerClosedResponse, SubmitRequest, SubmitResponse } from '@transia/xrpl';
+import { TimeoutError } from '@transia/xrpl/dist/npm/errors';
+import { BaseRequest, BaseResponse } from '@transia/xrpl/dist/npm/models/methods/baseMethod';
+import { performance } from 'node:perf_hooks';
+import {
+  CONNECTION_ERRORS,
+  ENDPOINT_HEDGE_DELAY_MS,
+  ENDPOINT_MAX_LEDGER_LAG,
+  ENDPOINT_PROBE_INTERVAL_MS,
+  ENDPOINT_RTT_SMOOTHING,
+  ENDPOINT_SUBMIT_FANOUT,
+} from './client.constant';
+
+export interface IEndpointStats {
+  url: string;
+  connected: boolean;
+  healthy: boolean;
+  rttMs?: number;
+  ledgerIndex?: number;
+  requests: number;
+  failures: number;
+}
+
+export interface IEndpointPoolStats {
+  endpoints: IEndpointStats[];
+  hedges: number;
+  failovers: number;
+}
+
+// why a request was also sent to a second endpoint
+export type EndpointRetryReason = 'hedge' | 'failover';
+
+interface IEndpoint {
+  url: string;
+  client: Client;
+  rttMs?: number;
+  ledgerIndex?: number;
+  failing: boolean;
+  requests: number;
+  failures: number;
+}
+
+/**
+ * One connection per rippled/Xahau node. A ledger_closed probe keeps a smoothed round trip time and the last
+ * closed ledger of every node: reads go to the fastest connected node that is not behind the others, and fail
+ * over once to the next one when the node cannot answer. Hedged reads are also sent to the next node when the
+ * fastest one is slow to answer, the first answer wins. Signed transactions are submitted to several nodes.
+ * A read naming a ledger by its index, such as a follow-up page of a paged walk, is only sent to the nodes
+ * whose last closed ledger reached it and is never hedged: a trailing node would answer lgrNotFound.
+ */
+export class EndpointPool {
+  protected readonly probeIntervalMs = ENDPOINT_PROBE_INTERVAL_MS;
+  protected readonly maxLedgerLag = ENDPOINT_MAX_LEDGER_LAG;
+  protected readonly hedgeDelayMs = ENDPOINT_HEDGE_DELAY_MS;
+  protected readonly submitFanout = ENDPOINT_SUBMIT_FANOUT;
+  private readonly endpoints: IEndpoint[];
+  private probeTimer?: NodeJS.Timeout;
+  private hedges = 0;
+  private failovers = 0;
+
+  constructor(
+    urls: string[],
+    private readonly onRetry: (reason: EndpointRetryReason) => void = () => undefined
+  ) {
+    this.endpoints = urls.map((url) => ({ url, client: new Client(url), failing: false, requests: 0, failures: 0 }));
+  }
+
+  isHedgingEnabled(): boolean {
+    return this.hedgeDelayMs > 0 && this.endpoints.length > 1;
+  }
+
+  async request<T extends BaseRequest, K extends BaseResponse>(requestInput: T, hedged = false): Promise<K> {
+    this.start();
+    const ledgerIndex = requestInput['ledger_index'];
+    const isPinned = typeof ledgerIndex === 'number';
+    const [fastest, next] = isPinned ? this.rankedHolding(ledgerIndex) : this.ranked();
+    if (!next) {
+      return this.send<T, K>(fastest, requestInput);
+    }
+    return this.race<T, K>(fastest, next, requestInput, hedged && !isPinned && this.isHedgingEnabled());
+  }
+
+  /**
+   * The answer of the fastest node is returned, the others only spread the blob: a node that already received
+   * it from its peers answers tefALREADY. Another node answers only when the fastest one cannot be reached.
+   */
+  async submit(txBlob: string): Promise<SubmitResponse> {
+    this.start();
+    const submitReq: SubmitRequest = { command: 'submit', tx_blob: txBlob };
+    const [fastest, ...others] = this.ranked()
+      .slice(0, Math.max(1, this.submitFanout))
+      .map((endpoint) => this.send<SubmitRequest, SubmitResponse>(endpoint, submitReq));
+    others.forEach((submitted) => submitted.catch(() => undefined));
+    try {
+      return await fastest;
+    } catch (err) {
+      if (!isEndpointFailure(err) || others.length === 0) {
+        throw err;
+      }
+      this.countRetry('failover');
+      return Promise.any(others).catch(() => {
+        throw err;
+      });
+    }
+  }
+
+  // subscriptions stay on a single node, the ledger stream would see every event once per node otherwise
+  async getStreamClient(): Promise<Client> {
+    this.start();
+    const [streamEndpoint] = this.endpoints;
+    await streamEndpoint.client.connect();
+    return streamEndpoint.client;
+  }
+
+  getStats(): IEndpointPoolStats {
+    const newestLedger = this.newestLedger();
+    return {
+      endpoints: this.endpoints.map((endpoint) => ({
+        url: endpoint.url,
+        connected: endpoint.client.isConnected(),
+        healthy: this.isHealthy(endpoint, newestLedger),
+        rttMs: endpoint.rttMs,
+        ledgerIndex: endpoint.ledgerIndex,
+        requests: endpoint.requests,
+        failures: endpoint.failures,
+      })),
+      hedges: this.hedges,
+      failovers: this.failovers,
+    };
+  }
+
+  async close(): Promise<void> {
+    clearInterval(this.probeTimer);
+    this.probeTimer = undefined;
+    await Promise.all(this.endpoints.map((endpoint) => endpoint.client.disconnect().catch(() => undefined)));
+  }
+
+  async probe(): Promise<void> {
+    await Promise.all(this.endpoints.map((endpoint) => this.probeEndpoint(endpoint)));
+  }
+
+  private start() {
+    if (this.probeTimer) {
+      return;
+    }
+    this.probeTimer = setInterval(() => this.probe(), this.probeIntervalMs);
+    this.probeTimer.unref();
+    void this.probe();
+  }
+
+  private async probeEndpoint(endpoint: IEndpoint): Promise<void> {
+    try {
+      await endpoint.client.connect();
+      const startedAt = performance.now();
+      const response = await endpoint.client.request<LedgerClosedRequest, LedgerClosedResponse>({
+        command: 'ledger_closed',
+      });
+      const rttMs = performance.now() - startedAt;
+      endpoint.rttMs =
+        endpoint.rttMs === undefined ? rttMs : endpoint.rttMs + ENDPOINT_RTT_SMOOTHING * (rttMs - endpoint.rttMs);
+      endpoint.ledgerIndex = response.result.ledger_index;
+      endpoint.failing = false;
+    } catch (err) {
+      if (!endpoint.failing) {
+        Logger.warn(`XRPL endpoint: ${endpoint.url} failed its probe: ${err?.message}`);
+      }
+      endpoint.failing = true;
+      endpoint.failures++;
+    }
+  }
+
+  // healthy endpoints by round trip time first, the others in configuration order as a last resort
+  private ranked(): IEndpoint[] {
+    const newestLedger = this.newestLedger();
+    const healthy = this.endpoints
+      .filter((endpoint) => this.isHealthy(endpoint, newestLedger))
+      .sort((a, b) => (a.rttMs ?? Infinity) - (b.rttMs ?? Infinity));
+    return [...healthy, ...this.endpoints.filter((endpoint) => !healthy.includes(endpoint))];
+  }
+
+  // endpoints that closed the given ledger, or the one with the newest ledger when none has closed it yet
+  private rankedHolding(ledgerIndex: number): IEndpoint[] {
+    const ranked = this.ranked();
+    const holding = ranked.filter((endpoint) => (endpoint.ledgerIndex ?? 0) >= ledgerIndex);
+    if (holding.length > 0) {
+      return holding;
+    }
+    const newestLedger = this.newestLedger();
+    return [ranked.find((endpoint) => (endpoint.ledgerIndex ?? 0) === newestLedger)];
+  }
+
+  private newestLedger(): number {
+    return Math.max(0, ...this.endpoints.map((endpoint) => endpoint.ledgerIndex ?? 0));
+  }
+
+  private isHealthy(endpoint: IEndpoint, newestLedger: number): boolean {
+    return (
+      endpoint.client.isConnected() &&
+      !endpoint.failing &&
+      newestLedger - (endpoint.ledgerIndex ?? 0) <= this.maxLedgerLag
+    );
+  }
+
+  /**
+   * Sends to the fastest endpoint, and to the next one when the fastest cannot answer or, for a hedged read,
+   * has not answered within the hedge delay. An error from a node that answered is returned as it is.
+   */
+  private race<T extends BaseRequest, K extends BaseResponse>(
+    fastest: IEndpoint,
+    next: IEndpoint,
+    requestInput: T,
+    hedged: boolean
+  ): Promise<K> {
+    return new Promise<K>((resolve, reject) => {
+      let pending = 0;
+      let isNextSent = false;
+      let hedgeTimer: NodeJS.Timeout | undefined;
+      const settle = (outcome: () => void) => {
+        clearTimeout(hedgeTimer);
+        outcome();
+      };
+      const sendTo = (endpoint: IEndpoint) => {
+        pending++;
+        this.send<T, K>(endpoint, requestInput).then(
+          (response) => settle(() => resolve(response)),
+          (err) => {
+            pending--;
+            if (!isEndpointFailure(err)) {
+              settle(() => reject(err));
+            } else if (!isNextSent) {
+              this.countRetry('failover');
+              sendNext();
+            } else if (pending === 0) {
+              settle(() => reject(err));
+            }
+          }
+        );
+      };
+      const sendNext = () => {
+        clearTimeout(hedgeTimer);
+        isNextSent = true;
+        sendTo(next);
+      };
+      if (hedged) {
+        hedgeTimer = setTimeout(() => {
+          this.countRetry('hedge');
+          sendNext();
+        }, this.hedgeDelayMs);
+      }
+      sendTo(fastest);
+    });
+  }
+
+  private countRetry(reason: EndpointRetryReason) {
+    if (reason === 'hedge') {
+      this.hedges++;
+    } else {
+      this.failovers++;
+    }
+    this.onRetry(reason);
+  }
+
+  private async send<T extends BaseRequest, K extends BaseResponse>(endpoint: IEndpoint, requestInput: T): Promise<K> {
+    endpoint.requests++;
+    try {
+      await endpoint.client.connect();
+      return await endpoint.client.request<T, K>(requestInput);
+    } catch (err) {
+      if (isEndpointFailure(err)) {
+        endpoint.failing = true;
+        endpoint.failures++;
+      }
+      throw err;
+    }
+  }
+}
+
+// the node did not answer, as opposed to an answer carrying an error
+function isEndpointFailure(err): boolean {
+  return CONNECTION_ERRORS.includes(err?.name) || err?.name === TimeoutError.name;
+}
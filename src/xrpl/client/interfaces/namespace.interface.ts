@@ -6,7 +6,9 @@ export interface IHookNamespaceInfo {
 
 export interface INamespaceResult {
   account: string;
-  ledger_current_index: number;
+  ledger_current_index?: number;
+  ledger_index?: number;
+  marker?: unknown;
   namespace_entries: INamespaceEntry[];
   namespace_id: string;
   validated: boolean;
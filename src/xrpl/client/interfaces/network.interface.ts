@@ -0,0 +1,18 @@
+export interface ILedgerState {
+  ledgerIndex: number;
+  // drops
+  baseFee: number;
+  networkId?: number;
+}
+
+export interface IServerLoad {
+  loadBase: number;
+  loadFactor: number;
+}
+
+export interface ITxNetworkValues {
+  Sequence: number;
+  Fee: string;
+  LastLedgerSequence: number;
+  NetworkID?: number;
+}
@@ -1,16 +1,20 @@
-import { XRPL_Account } from 'xrpl-accountlib';
-import { BaseTransaction } from '@transia/xrpl/dist/npm/models/transactions/common';
-
 export enum XRPL_RESULT_PREFIX {
   MALFORMED = 'tem',
   RETRY = 'ter',
   SUCCESS = 'tes',
   CLAIMED_COST_ONLY = 'tec',
+  FAILURE = 'tef',
+  LOCAL_ERROR = 'tel',
 }
 
 export enum XRPL_RESPONSE_CODE {
   SUCCESS = 'tesSUCCESS',
   HOOK_REJECTED = 'tecHOOK_REJECTED',
+  QUEUED = 'terQUEUED',
+  PRE_SEQ = 'terPRE_SEQ',
+  CAN_NOT_QUEUE = 'telCAN_NOT_QUEUE',
+  PAST_SEQ = 'tefPAST_SEQ',
+  ALREADY = 'tefALREADY',
 }
 
 export interface IResultCode {
@@ -18,7 +22,13 @@ export interface IResultCode {
   code: string;
 }
 
-export interface ICompleteXrplTx<T extends BaseTransaction> {
-  authorizedAccount: XRPL_Account;
-  newTx: T;
+
+export interface ISubmissionEvent {
+  hash: string;
+  transactionType: string;
+  account: string;
+  lastLedgerSequence?: number;
+  signedTransaction?: string;
+  // preliminary result of the submit command, absent while the blob is being sent
+  engineResult?: string;
 }
@@ -0,0 +1,93 @@
+import { Injectable, Logger, OnModuleDestroy, OnModuleInit } from '@nestjs/common';
+import { Client, LedgerStream, TransactionStream } from '@transia/xrpl';
+import { Observable, Subject } from 'rxjs';
+import * as process from 'process';
+import { XrplService } from './client.service';
+import { NetworkStateService } from './network-state.service';
+import { Counter, MetricsRegistry } from '../../metrics/metrics.registry';
+
+/**
+ * Single subscription to the validated ledger and transaction streams shared by every in-memory view.
+ * Consumers must drop their state on `reset$`: it fires whenever the socket drops, since events
+ * published while disconnected are lost and the views have to be backfilled again.
+ */
+@Injectable()
+export class LedgerStreamService implements OnModuleInit, OnModuleDestroy {
+  private readonly transactionSubject = new Subject<TransactionStream>();
+  private readonly ledgerSubject = new Subject<LedgerStream>();
+  private readonly resetSubject = new Subject<void>();
+  private client?: Client;
+  private lastLedgerIndex?: number;
+  private readonly reconnects: Counter;
+
+  readonly transactions$: Observable<TransactionStream> = this.transactionSubject.asObservable();
+  readonly ledgerClosed$: Observable<LedgerStream> = this.ledgerSubject.asObservable();
+  readonly reset$: Observable<void> = this.resetSubject.asObservable();
+
+  constructor(
+    private readonly xrpl: XrplService,
+    private readonly networkState: NetworkStateService,
+    metrics: MetricsRegistry
+  ) {
+    this.reconnects = metrics.counter('xrpl_socket_reconnects_total', 'Reconnections of the XRPL websocket');
+  }
+
+  async onModuleInit(): Promise<void> {
+    if (!this.isEnabled()) {
+      return;
+    }
+    try {
+      await this.subscribe();
+    } catch (err) {
+      Logger.error(`Subscription to XRPL ledger stream failed: ${err?.message}`);
+    }
+  }
+
+  async onModuleDestroy(): Promise<void> {
+    this.client?.removeAllListeners('transaction');
+    this.client?.removeAllListeners('ledgerClosed');
+    this.client?.connection.removeAllListeners('serverStatus');
+  }
+
+  isEnabled(): boolean {
+    return process.env.XRPL_STREAM_ENABLED !== 'false';
+  }
+
+  isSubscribed(): boolean {
+    return !!this.client?.isConnected() && this.lastLedgerIndex !== undefined;
+  }
+
+  getLastLedgerIndex(): number | undefined {
+    return this.lastLedgerIndex;
+  }
+
+  private async subscribe(): Promise<void> {
+    this.client = await this.xrpl.getClient();
+    this.client.on('transaction', (tx: TransactionStream) => this.transactionSubject.next(tx));
+    this.client.on('ledgerClosed', (ledger: LedgerStream) => {
+      this.lastLedgerIndex = ledger.ledger_index;
+      this.networkState.applyLedger(ledger);
+      this.ledgerSubject.next(ledger);
+    });
+    this.client.connection.on('serverStatus', (status) => this.networkState.applyServerStatus(status));
+    this.client.on('disconnected', () => {
+      Logger.warn('XRPL ledger stream disconnected, in-memory views are reset');
+      this.lastLedgerIndex = undefined;
+      this.networkState.reset();
+      this.resetSubject.next();
+    });
+    this.client.on('connected', () => {
+      this.reconnects.inc();
+      this.requestSubscription().catch((err) => Logger.error(`Resubscription failed: ${err?.message}`));
+    });
+    await this.requestSubscription();
+    Logger.log('Subscribed to XRPL ledger and transaction streams');
+  }
+
+  private async requestSubscription(): Promise<void> {
+    const response = await this.client.request({ command: 'subscribe', streams: ['ledger', 'transactions', 'server'] });
+    this.lastLedgerIndex = response.result['ledger_index'] ?? this.lastLedgerIndex;
+    this.networkState.applyLedger(response.result as any);
+    this.networkState.applyServerStatus(response.result as any);
+  }
+}
@@ -0,0 +1,62 @@
+import { NetworkStateService } from './network-state.service';
+import { FEE_CUSHION, LAST_LEDGER_SEQUENCE_OFFSET } from './client.constant';
+import { TEST_ADDRESS_ALICE } from '../../test-utils/test-utils';
+
+describe('NetworkStateService unit spec', () => {
+  let underTest: NetworkStateService;
+
+  beforeEach(() => {
+    underTest = new NetworkStateService();
+    underTest.applyLedger({ ledger_index: 100, fee_base: 10, network_id: 21338 });
+  });
+
+  test('should not be ready before the first ledger is applied', () => {
+    underTest.reset();
+
+    expect(underTest.isReady()).toBeFalsy();
+  });
+
+  test('should scale the fee with the server load factor and the cushion', async () => {
+    underTest.applyServerStatus({ load_base: 256, load_factor: 512 });
+
+    const values = await underTest.getTxValues(TEST_ADDRESS_ALICE, jest.fn().mockResolvedValue(5));
+
+    expect(values).toEqual({
+      Sequence: 5,
+      Fee: Math.ceil(20 * FEE_CUSHION).toString(),
+      LastLedgerSequence: 100 + LAST_LEDGER_SEQUENCE_OFFSET,
+      NetworkID: 21338,
+    });
+  });
+
+  test('should leave out the NetworkID on legacy networks', async () => {
+    underTest.applyLedger({ ledger_index: 101, fee_base: 10, network_id: 1 });
+
+    const values = await underTest.getTxValues(TEST_ADDRESS_ALICE, jest.fn().mockResolvedValue(5));
+
+    expect(values.NetworkID).toBeUndefined();
+  });
+
+  test('should fetch the account sequence once and allocate the following ones locally', async () => {
+    const fetchSequence = jest.fn().mockResolvedValue(5);
+
+    const sequences = await Promise.all([
+      underTest.allocateSequence(TEST_ADDRESS_ALICE, fetchSequence),
+      underTest.allocateSequence(TEST_ADDRESS_ALICE, fetchSequence),
+      underTest.allocateSequence(TEST_ADDRESS_ALICE, fetchSequence),
+    ]);
+
+    expect(sequences).toEqual([5, 6, 7]);
+    expect(fetchSequence).toBeCalledTimes(1);
+  });
+
+  test('should fetch the sequence again once the allocation is released', async () => {
+    const fetchSequence = jest.fn().mockResolvedValueOnce(5).mockResolvedValueOnce(5);
+
+    await underTest.allocateSequence(TEST_ADDRESS_ALICE, fetchSequence);
+    underTest.releaseSequences(TEST_ADDRESS_ALICE);
+
+    await expect(underTest.allocateSequence(TEST_ADDRESS_ALICE, fetchSequence)).resolves.toEqual(5);
+    expect(fetchSequence).toBeCalledTimes(2);
+  });
+});
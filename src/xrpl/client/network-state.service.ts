@@ -0,0 +1,95 @@
+import { Injectable, Logger } from '@nestjs/common';
+import { FEE_CUSHION, LAST_LEDGER_SEQUENCE_OFFSET, LEGACY_NETWORK_ID_MAX, NETWORK_ID } from './client.constant';
+import { ILedgerState, IServerLoad, ITxNetworkValues } from './interfaces/network.interface';
+
+interface IAccountSequence {
+  next: number;
+}
+
+/**
+ * Network values needed to prepare a transaction, kept current from the ledger and server streams:
+ * base fee, open ledger fee (base fee scaled by the server load factor), LastLedgerSequence baseline
+ * and NetworkID. Account sequences are fetched once and then allocated locally, so preparing a
+ * transaction needs no network call in steady state.
+ */
+@Injectable()
+export class NetworkStateService {
+  private ledger?: ILedgerState;
+  private load: IServerLoad = { loadBase: 256, loadFactor: 256 };
+  private readonly sequences = new Map<string, Promise<IAccountSequence>>();
+
+  applyLedger(ledger: { ledger_index?: number; fee_base?: number; network_id?: number }) {
+    if (ledger?.ledger_index === undefined || ledger.fee_base === undefined) {
+      return;
+    }
+    this.ledger = {
+      ledgerIndex: ledger.ledger_index,
+      baseFee: ledger.fee_base,
+      networkId: ledger.network_id ?? this.ledger?.networkId,
+    };
+  }
+
+  applyServerStatus(status: { load_base?: number; load_factor?: number }) {
+    if (!status?.load_base || !status.load_factor) {
+      return;
+    }
+    this.load = { loadBase: status.load_base, loadFactor: status.load_factor };
+  }
+
+  // values from before a disconnection cannot be trusted, sequences may have been used meanwhile
+  reset() {
+    this.ledger = undefined;
+    this.sequences.clear();
+  }
+
+  isReady(): boolean {
+    return this.ledger !== undefined;
+  }
+
+  getNetworkId(): number {
+    return this.ledger?.networkId ?? NETWORK_ID;
+  }
+
+  getBaseFee(): number {
+    return this.ledger?.baseFee;
+  }
+
+  getOpenLedgerFee(): number {
+    return Math.ceil((this.ledger?.baseFee * this.load.loadFactor) / this.load.loadBase);
+  }
+
+  getLastLedgerSequence(): number {
+    return this.ledger?.ledgerIndex + LAST_LEDGER_SEQUENCE_OFFSET;
+  }
+
+  /**
+   * Hands out the next sequence of the account; only its first transaction reads the sequence from the ledger.
+   */
+  async allocateSequence(account: string, fetchSequence: () => Promise<number>): Promise<number> {
+    let sequence = this.sequences.get(account);
+    if (!sequence) {
+      sequence = fetchSequence().then((next) => ({ next }));
+      this.sequences.set(account, sequence);
+      sequence.catch(() => this.sequences.delete(account));
+    }
+    return (await sequence).next++;
+  }
+
+  // called when a submission did not consume its sequence, the next one reads it from the ledger again
+  releaseSequences(account: string) {
+    if (this.sequences.delete(account)) {
+      Logger.warn(`Sequence allocation of account: ${account} is reset`);
+    }
+  }
+
+  // the factories leave NetworkID out, it is only set here for networks that require it
+  async getTxValues(account: string, fetchSequence: () => Promise<number>): Promise<ITxNetworkValues> {
+    const networkId = this.getNetworkId();
+    return {
+      Sequence: await this.allocateSequence(account, fetchSequence),
+      Fee: Math.ceil(Math.max(this.getBaseFee(), this.getOpenLedgerFee()) * FEE_CUSHION).toString(),
+      LastLedgerSequence: this.getLastLedgerSequence(),
+      ...(networkId > LEGACY_NETWORK_ID_MAX && { NetworkID: networkId }),
+    };
+  }
+}
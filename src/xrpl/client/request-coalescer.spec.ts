@@ -0,0 +1,32 @@
+import { RequestCoalescer, stableStringify } from './request-coalescer';
+
+describe('RequestCoalescer unit spec', () => {
+  test('should share one execution between concurrent calls with the same key', async () => {
+    const underTest = new RequestCoalescer();
+    let release: (value: string) => void;
+    const execute = jest.fn(() => new Promise<string>((resolve) => (release = resolve)));
+
+    const first = underTest.run('account_info', execute);
+    const second = underTest.run('account_info', execute);
+    release('response');
+
+    await expect(Promise.all([first, second])).resolves.toEqual(['response', 'response']);
+    expect(execute).toBeCalledTimes(1);
+    expect(underTest.getStats()).toEqual({ hits: 1, misses: 1, inFlight: 0 });
+  });
+
+  test('should execute again once the shared call has settled, including after a failure', async () => {
+    const underTest = new RequestCoalescer();
+    const execute = jest.fn().mockRejectedValueOnce(new Error('failure')).mockResolvedValueOnce('response');
+
+    await expect(underTest.run('account_info', execute)).rejects.toThrow('failure');
+    await expect(underTest.run('account_info', execute)).resolves.toEqual('response');
+    expect(execute).toBeCalledTimes(2);
+  });
+
+  test('should build the same key regardless of property order', () => {
+    expect(stableStringify({ command: 'account_info', account: 'r', ledger_index: 'validated' })).toEqual(
+      stableStringify({ ledger_index: 'validated', account: 'r', command: 'account_info' })
+    );
+  });
+});
@@ -0,0 +1,46 @@
+export interface ICoalescingStats {
+  hits: number;
+  misses: number;
+  inFlight: number;
+}
+
+/**
+ * Single-flight execution: concurrent calls under the same key share the promise of the first one
+ * until it settles. Nothing is cached past that point, so every later call reads fresh data.
+ */
+export class RequestCoalescer {
+  private readonly inFlight = new Map<string, Promise<unknown>>();
+  private hits = 0;
+  private misses = 0;
+
+  run<T>(key: string, execute: () => Promise<T>): Promise<T> {
+    const shared = this.inFlight.get(key);
+    if (shared) {
+      this.hits++;
+      return shared as Promise<T>;
+    }
+    this.misses++;
+    const execution = execute().finally(() => this.inFlight.delete(key));
+    this.inFlight.set(key, execution);
+    return execution;
+  }
+
+  getStats(): ICoalescingStats {
+    return { hits: this.hits, misses: this.misses, inFlight: this.inFlight.size };
+  }
+}
+
+// JSON with object keys sorted, so requests differing only in key order share a key
+export function stableStringify(value: unknown): string {
+  if (Array.isArray(value)) {
+    return `[${value.map(stableStringify).join(',')}]`;
+  }
+  if (value && typeof value === 'object') {
+    return `{${Object.keys(value)
+      .filter((key) => value[key] !== undefined)
+      .sort()
+      .map((key) => `${JSON.stringify(key)}:${stableStringify(value[key])}`)
+      .join(',')}}`;
+  }
+  return JSON.stringify(value);
+}
@@ -0,0 +1,87 @@
+import { HttpException, HttpStatus } from '@nestjs/common';
+import { SubmissionScheduler } from './submission.scheduler';
+import { SubmissionPriority } from './client.constant';
+import { TEST_ADDRESS_ALICE, TEST_ADDRESS_BOB } from '../../test-utils/test-utils';
+
+const TEST_ADDRESS_CAROL = 'rLpunkSNPGQmSpZkGyLDpGEJnb2gf2VHXf';
+
+class TestSubmissionScheduler extends SubmissionScheduler {
+  protected readonly maxInFlight = 1;
+  protected readonly maxQueuedPerAccount = 2;
+}
+
+const deferred = () => {
+  let resolve: (value: string) => void;
+  const promise = new Promise<string>((res) => (resolve = res));
+  return { promise, resolve };
+};
+
+const flush = () => new Promise((resolve) => setImmediate(resolve));
+
+describe('SubmissionScheduler unit spec', () => {
+  let underTest: SubmissionScheduler;
+
+  beforeEach(() => {
+    underTest = new TestSubmissionScheduler();
+  });
+
+  test('should run submissions of one account one after another', async () => {
+    const first = deferred();
+    const started: string[] = [];
+
+    const firstResult = underTest.schedule(TEST_ADDRESS_ALICE, SubmissionPriority.DEFAULT, () => {
+      started.push('first');
+      return first.promise;
+    });
+    const secondResult = underTest.schedule(TEST_ADDRESS_ALICE, SubmissionPriority.DEFAULT, async () => {
+      started.push('second');
+      return 'second';
+    });
+    await flush();
+    expect(started).toEqual(['first']);
+
+    first.resolve('first');
+
+    await expect(firstResult).resolves.toEqual('first');
+    await expect(secondResult).resolves.toEqual('second');
+    expect(started).toEqual(['first', 'second']);
+  });
+
+  test('should dispatch returns before other submissions once a slot frees up', async () => {
+    const blocker = deferred();
+    const started: string[] = [];
+    underTest.schedule(TEST_ADDRESS_ALICE, SubmissionPriority.DEFAULT, () => blocker.promise);
+    const offer = underTest.schedule(TEST_ADDRESS_BOB, SubmissionPriority.DEFAULT, async () => started.push('offer'));
+    const ret = underTest.schedule(TEST_ADDRESS_CAROL, SubmissionPriority.RETURN, async () => started.push('return'));
+    expect(underTest.getStats()).toEqual({ inFlight: 1, queued: 2, accounts: 3 });
+
+    blocker.resolve('done');
+    await Promise.all([offer, ret]);
+
+    expect(started).toEqual(['return', 'offer']);
+    expect(underTest.getStats()).toEqual({ inFlight: 0, queued: 0, accounts: 0 });
+  });
+
+  test('should refuse submissions with 429 once the account queue is full', async () => {
+    const blocker = deferred();
+    underTest.schedule(TEST_ADDRESS_ALICE, SubmissionPriority.DEFAULT, () => blocker.promise);
+    await flush();
+    underTest.schedule(TEST_ADDRESS_ALICE, SubmissionPriority.DEFAULT, () => blocker.promise);
+    underTest.schedule(TEST_ADDRESS_ALICE, SubmissionPriority.DEFAULT, () => blocker.promise);
+
+    expect(() => underTest.schedule(TEST_ADDRESS_ALICE, SubmissionPriority.DEFAULT, () => blocker.promise)).toThrow(
+      new HttpException('Too many pending submissions, retry later', HttpStatus.TOO_MANY_REQUESTS)
+    );
+    blocker.resolve('done');
+  });
+
+  test('should pass the failure of a submission to its caller and continue with the lane', async () => {
+    const failed = underTest.schedule(TEST_ADDRESS_ALICE, SubmissionPriority.DEFAULT, async () => {
+      throw new Error('submit failed');
+    });
+    const next = underTest.schedule(TEST_ADDRESS_ALICE, SubmissionPriority.DEFAULT, async () => 'next');
+
+    await expect(failed).rejects.toThrow('submit failed');
+    await expect(next).resolves.toEqual('next');
+  });
+});
@@ -0,0 +1,112 @@
+import { HttpException, HttpStatus, Injectable } from '@nestjs/common';
+import { AsyncResource } from 'node:async_hooks';
+import {
+  SUBMISSION_MAX_IN_FLIGHT,
+  SUBMISSION_MAX_QUEUED,
+  SUBMISSION_MAX_QUEUED_PER_ACCOUNT,
+  SubmissionPriority,
+} from './client.constant';
+
+interface ISubmissionJob {
+  priority: SubmissionPriority;
+  execute: () => Promise<unknown>;
+  resolve: (value: unknown) => void;
+  reject: (err: unknown) => void;
+}
+
+interface IAccountLane {
+  jobs: ISubmissionJob[];
+  running: boolean;
+}
+
+export interface ISubmissionSchedulerStats {
+  inFlight: number;
+  queued: number;
+  accounts: number;
+}
+
+/**
+ * Runs submissions of one account strictly one after another, so sequences are used in order, while
+ * different accounts proceed in parallel up to a global in-flight limit. An account whose lane is
+ * free waits in the ready queue of the priority of its next submission; higher priorities are
+ * dispatched first. Submissions above the queue limits are refused with 429.
+ */
+@Injectable()
+export class SubmissionScheduler {
+  protected readonly maxInFlight: number = SUBMISSION_MAX_IN_FLIGHT;
+  protected readonly maxQueued: number = SUBMISSION_MAX_QUEUED;
+  protected readonly maxQueuedPerAccount: number = SUBMISSION_MAX_QUEUED_PER_ACCOUNT;
+  private readonly lanes = new Map<string, IAccountLane>();
+  private readonly ready = new Map<SubmissionPriority, string[]>();
+  private inFlight = 0;
+  private queued = 0;
+
+  schedule<T>(account: string, priority: SubmissionPriority, execute: () => Promise<T>): Promise<T> {
+    const lane = this.lanes.get(account) ?? { jobs: [], running: false };
+    if (this.queued >= this.maxQueued || lane.jobs.length >= this.maxQueuedPerAccount) {
+      throw new HttpException('Too many pending submissions, retry later', HttpStatus.TOO_MANY_REQUESTS);
+    }
+    this.lanes.set(account, lane);
+    return new Promise<T>((resolve, reject) => {
+      // bound to the caller's async context, so its trace continues when another lane starts the job
+      lane.jobs.push({ priority, execute: AsyncResource.bind(execute), resolve, reject });
+      this.queued++;
+      if (!lane.running && lane.jobs.length === 1) {
+        this.markReady(account, priority);
+      }
+      this.dispatch();
+    });
+  }
+
+  getStats(): ISubmissionSchedulerStats {
+    return { inFlight: this.inFlight, queued: this.queued, accounts: this.lanes.size };
+  }
+
+  private markReady(account: string, priority: SubmissionPriority) {
+    if (!this.ready.has(priority)) {
+      this.ready.set(priority, []);
+    }
+    this.ready.get(priority).push(account);
+  }
+
+  private nextReadyAccount(): string | undefined {
+    const priorities = [...this.ready.keys()].sort((a, b) => a - b);
+    for (const priority of priorities) {
+      const accounts = this.ready.get(priority);
+      if (accounts.length > 0) {
+        return accounts.shift();
+      }
+    }
+    return undefined;
+  }
+
+  private dispatch() {
+    while (this.inFlight < this.maxInFlight) {
+      const account = this.nextReadyAccount();
+      if (account === undefined) {
+        return;
+      }
+      this.run(account, this.lanes.get(account));
+    }
+  }
+
+  private run(account: string, lane: IAccountLane) {
+    const job = lane.jobs.shift();
+    this.queued--;
+    this.inFlight++;
+    lane.running = true;
+    Promise.resolve()
+      .then(() => job.execute())
+      .then(job.resolve, job.reject)
+      .finally(() => {
+        this.inFlight--;
+        lane.running = false;
+        if (lane.jobs.length > 0) {
+          this.markReady(account, lane.jobs[0].priority);
+        } else {
+          this.lanes.delete(account);
+        }
+        this.dispatch();
+      });
+  }
+}
@@ -0,0 +1,140 @@
+import { TestBed } from '@automock/jest';
+import { Subject } from 'rxjs';
+import { LedgerStream, TransactionStream } from '@transia/xrpl';
+import { TransactionResubmitter } from './transaction.resubmitter';
+import { XrplService } from './client.service';
+import { LedgerStreamService } from './ledger-stream.service';
+import { NetworkStateService } from './network-state.service';
+import { ISubmissionEvent } from './interfaces/xrpl.interface';
+import { MetricsRegistry } from '../../metrics/metrics.registry';
+import { TEST_ADDRESS_ALICE, TEST_TX_HASH } from '../../test-utils/test-utils';
+
+const NEXT_TX_HASH = 'C53ECF838647FA5A4C780377025FEC7999AB4182590510CA461444B207AB74A9';
+const HELD_SUBMISSION: ISubmissionEvent = {
+  hash: TEST_TX_HASH,
+  transactionType: 'URITokenBuy',
+  account: TEST_ADDRESS_ALICE,
+  lastLedgerSequence: 20,
+  signedTransaction: 'BLOB',
+  engineResult: 'terQUEUED',
+};
+
+describe('TransactionResubmitter unit spec', () => {
+  let underTest: TransactionResubmitter;
+  let xrplService: jest.Mocked<XrplService>;
+  let networkState: jest.Mocked<NetworkStateService>;
+  let registry: MetricsRegistry;
+  const submissions$ = new Subject<ISubmissionEvent>();
+  const transactions$ = new Subject<TransactionStream>();
+  const ledgerClosed$ = new Subject<LedgerStream>();
+
+  beforeEach(() => {
+    registry = new MetricsRegistry();
+    const { unit, unitRef } = TestBed.create(TransactionResubmitter)
+      .mock(XrplService)
+      .using({
+        submissions$: submissions$.asObservable(),
+        submitSignedTransaction: jest.fn().mockResolvedValue({ engine_result: 'tesSUCCESS' }),
+      })
+      .mock(LedgerStreamService)
+      .using({ transactions$: transactions$.asObservable(), ledgerClosed$: ledgerClosed$.asObservable() })
+      .mock(MetricsRegistry)
+      .using({ counter: registry.counter.bind(registry), gauge: registry.gauge.bind(registry) })
+      .compile();
+    underTest = unit;
+    xrplService = unitRef.get(XrplService);
+    networkState = unitRef.get(NetworkStateService);
+    underTest.onModuleInit();
+  });
+
+  afterEach(() => {
+    underTest.onModuleDestroy();
+  });
+
+  test('should hold only transient results of transactions with a LastLedgerSequence', () => {
+    submissions$.next({ ...HELD_SUBMISSION, engineResult: undefined });
+    submissions$.next({ ...HELD_SUBMISSION, engineResult: 'tesSUCCESS' });
+    submissions$.next({ ...HELD_SUBMISSION, engineResult: 'tefPAST_SEQ' });
+    submissions$.next({ ...HELD_SUBMISSION, lastLedgerSequence: undefined });
+    expect(underTest.getHeldCount()).toEqual(0);
+
+    submissions$.next(HELD_SUBMISSION);
+    submissions$.next({ ...HELD_SUBMISSION, hash: NEXT_TX_HASH, engineResult: 'telCAN_NOT_QUEUE' });
+    expect(underTest.getHeldCount()).toEqual(2);
+  });
+
+  test('should resubmit the held blob on ledger close until it applies', async () => {
+    submissions$.next(HELD_SUBMISSION);
+    xrplService.submitSignedTransaction.mockResolvedValueOnce({ engine_result: 'terPRE_SEQ' });
+
+    await underTest.resubmit(10);
+    expect(underTest.getHeldCount()).toEqual(1);
+    await underTest.resubmit(11);
+
+    expect(xrplService.submitSignedTransaction).toBeCalledTimes(2);
+    expect(xrplService.submitSignedTransaction).toBeCalledWith('BLOB');
+    expect(underTest.getHeldCount()).toEqual(0);
+    expect(networkState.releaseSequences).not.toBeCalled();
+    expect(registry.render()).toContain(
+      'xrpl_resubmissions_total{transaction_type="URITokenBuy",engine_result="terPRE_SEQ"} 1'
+    );
+    expect(registry.render()).toContain(
+      'xrpl_resubmitted_transactions_total{transaction_type="URITokenBuy",outcome="applied"} 1'
+    );
+  });
+
+  test('should resubmit the transactions of an account in signing order', async () => {
+    const order: string[] = [];
+    xrplService.submitSignedTransaction.mockImplementation(async (blob) => {
+      order.push(blob);
+      return { engine_result: 'tesSUCCESS' };
+    });
+    submissions$.next(HELD_SUBMISSION);
+    submissions$.next({ ...HELD_SUBMISSION, hash: NEXT_TX_HASH, signedTransaction: 'NEXT_BLOB' });
+
+    await underTest.resubmit(10);
+
+    expect(order).toEqual(['BLOB', 'NEXT_BLOB']);
+  });
+
+  test('should stop resubmitting once the transaction is validated', async () => {
+    submissions$.next(HELD_SUBMISSION);
+
+    transactions$.next({ validated: true, ledger_index: 10, transaction: { hash: TEST_TX_HASH } } as any);
+    await underTest.resubmit(10);
+
+    expect(xrplService.submitSignedTransaction).not.toBeCalled();
+    expect(underTest.getHeldCount()).toEqual(0);
+  });
+
+  test('should give up past the LastLedgerSequence and let the Sequence be read again', async () => {
+    submissions$.next(HELD_SUBMISSION);
+
+    await underTest.resubmit(20);
+
+    expect(xrplService.submitSignedTransaction).not.toBeCalled();
+    expect(networkState.releaseSequences).toBeCalledWith(TEST_ADDRESS_ALICE);
+    expect(registry.render()).toContain(
+      'xrpl_resubmitted_transactions_total{transaction_type="URITokenBuy",outcome="expired"} 1'
+    );
+  });
+
+  test('should release a transaction rejected on resubmission', async () => {
+    submissions$.next(HELD_SUBMISSION);
+    xrplService.submitSignedTransaction.mockResolvedValueOnce({ engine_result: 'telINSUF_FEE_P' });
+
+    await underTest.resubmit(10);
+
+    expect(underTest.getHeldCount()).toEqual(0);
+    expect(networkState.releaseSequences).toBeCalledWith(TEST_ADDRESS_ALICE);
+  });
+
+  test('should keep the transaction held when the resubmission cannot be sent', async () => {
+    submissions$.next(HELD_SUBMISSION);
+    xrplService.submitSignedTransaction.mockRejectedValueOnce(new Error('Not connected'));
+
+    await underTest.resubmit(10);
+
+    expect(underTest.getHeldCount()).toEqual(1);
+  });
+});
@@ -0,0 +1,161 @@
+import { Injectable, Logger, OnModuleDestroy, OnModuleInit } from '@nestjs/common';
+import { TransactionStream } from '@transia/xrpl';
+import { Subscription } from 'rxjs';
+import { isHeldForResubmission, XrplService } from './client.service';
+import { LedgerStreamService } from './ledger-stream.service';
+import { NetworkStateService } from './network-state.service';
+import { ISubmissionEvent, XRPL_RESPONSE_CODE, XRPL_RESULT_PREFIX } from './interfaces/xrpl.interface';
+import { Counter, MetricsRegistry } from '../../metrics/metrics.registry';
+import { RESUBMIT_MAX_ATTEMPTS } from './client.constant';
+
+interface IHeldTransaction {
+  hash: string;
+  transactionType: string;
+  account: string;
+  signedTransaction: string;
+  lastLedgerSequence: number;
+  attempts: number;
+}
+
+type ResubmissionOutcome = 'validated' | 'applied' | 'rejected' | 'expired' | 'exhausted';
+
+// the Sequence of the blob is used once any of these come back, by the blob itself or by its queued copy
+const SEQUENCE_USED_RESULTS: string[] = [XRPL_RESPONSE_CODE.PAST_SEQ, XRPL_RESPONSE_CODE.ALREADY];
+
+/**
+ * Holds the signed blob of transactions whose submit met transient contention (a full transaction queue, a
+ * preceding Sequence not applied yet) and submits it again on every ledger close, in signing order per
+ * account, until it applies, fails for good or a ledger past its LastLedgerSequence closes. The caller is
+ * answered with the preliminary result and follows the transaction through its validation status.
+ */
+@Injectable()
+export class TransactionResubmitter implements OnModuleInit, OnModuleDestroy {
+  private readonly held = new Map<string, IHeldTransaction>();
+  private readonly subscriptions: Subscription[] = [];
+  private readonly resubmissions: Counter;
+  private readonly outcomes: Counter;
+  private isResubmitting = false;
+
+  constructor(
+    private readonly xrpl: XrplService,
+    private readonly stream: LedgerStreamService,
+    private readonly networkState: NetworkStateService,
+    metrics: MetricsRegistry
+  ) {
+    this.resubmissions = metrics.counter(
+      'xrpl_resubmissions_total',
+      'Resubmissions of held transactions by preliminary result',
+      ['transaction_type', 'engine_result']
+    );
+    this.outcomes = metrics.counter(
+      'xrpl_resubmitted_transactions_total',
+      'Transactions held for resubmission by how their resubmission ended',
+      ['transaction_type', 'outcome']
+    );
+    metrics.gauge('xrpl_held_transactions', 'Transactions waiting for the next ledger close to resubmit', [], (gauge) =>
+      gauge.set({}, this.held.size)
+    );
+  }
+
+  onModuleInit() {
+    this.subscriptions.push(
+      this.xrpl.submissions$.subscribe((submission) => this.applySubmission(submission)),
+      this.stream.transactions$.subscribe((tx) => this.applyTransaction(tx)),
+      this.stream.ledgerClosed$.subscribe((ledger) => this.resubmit(ledger.ledger_index))
+    );
+  }
+
+  onModuleDestroy() {
+    this.subscriptions.forEach((subscription) => subscription.unsubscribe());
+  }
+
+  getHeldCount(): number {
+    return this.held.size;
+  }
+
+  applySubmission(submission: ISubmissionEvent) {
+    if (
+      !submission.signedTransaction ||
+      !isHeldForResubmission(submission.engineResult, submission.lastLedgerSequence)
+    ) {
+      return;
+    }
+    this.held.set(submission.hash, {
+      hash: submission.hash,
+      transactionType: submission.transactionType,
+      account: submission.account,
+      signedTransaction: submission.signedTransaction,
+      lastLedgerSequence: submission.lastLedgerSequence,
+      attempts: 0,
+    });
+  }
+
+  applyTransaction(tx: TransactionStream) {
+    const hash = tx.transaction?.hash;
+    if (tx.validated && hash && this.held.has(hash)) {
+      this.release(this.held.get(hash), 'validated');
+    }
+  }
+
+  async resubmit(ledgerIndex: number): Promise<void> {
+    // a slow round is not overlapped, the next ledger close resubmits whatever is still held
+    if (this.isResubmitting || this.held.size === 0) {
+      return;
+    }
+    this.isResubmitting = true;
+    try {
+      const byAccount = new Map<string, IHeldTransaction[]>();
+      this.held.forEach((held) => byAccount.set(held.account, [...(byAccount.get(held.account) || []), held]));
+      await Promise.all([...byAccount.values()].map((held) => this.resubmitInOrder(held, ledgerIndex)));
+    } finally {
+      this.isResubmitting = false;
+    }
+  }
+
+  // held in the order the lane of the account signed them, which is their Sequence order
+  private async resubmitInOrder(held: IHeldTransaction[], ledgerIndex: number) {
+    for (const entry of held) {
+      if (!this.held.has(entry.hash)) {
+        continue;
+      }
+      if (ledgerIndex >= entry.lastLedgerSequence) {
+        this.release(entry, 'expired');
+        continue;
+      }
+      if (entry.attempts >= RESUBMIT_MAX_ATTEMPTS) {
+        this.release(entry, 'exhausted');
+        continue;
+      }
+      entry.attempts++;
+      let engineResult: string | undefined;
+      try {
+        engineResult = (await this.xrpl.submitSignedTransaction(entry.signedTransaction))?.engine_result;
+      } catch (err) {
+        Logger.warn(`Resubmission of tx: ${entry.hash} failed, retried on next ledger: ${err?.message}`);
+        continue;
+      }
+      this.resubmissions.inc({ transaction_type: entry.transactionType, engine_result: engineResult });
+      if (!isHeldForResubmission(engineResult, entry.lastLedgerSequence) && this.held.has(entry.hash)) {
+        this.release(entry, isApplied(engineResult) ? 'applied' : 'rejected');
+      }
+    }
+  }
+
+  private release(entry: IHeldTransaction, outcome: ResubmissionOutcome) {
+    this.held.delete(entry.hash);
+    this.outcomes.inc({ transaction_type: entry.transactionType, outcome });
+    // the Sequence of the blob will never be used, the next allocation reads it again
+    if (outcome === 'rejected' || outcome === 'expired' || outcome === 'exhausted') {
+      this.networkState.releaseSequences(entry.account);
+    }
+    Logger.log(`Transaction: ${entry.transactionType} ${entry.hash} resubmission ended: ${outcome}`);
+  }
+}
+
+function isApplied(engineResult?: string): boolean {
+  return (
+    engineResult?.startsWith(XRPL_RESULT_PREFIX.SUCCESS) ||
+    engineResult?.startsWith(XRPL_RESULT_PREFIX.CLAIMED_COST_ONLY) ||
+    SEQUENCE_USED_RESULTS.includes(engineResult)
+  );
+}
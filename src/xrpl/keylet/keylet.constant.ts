@@ -0,0 +1,10 @@
+// Ledger namespace prefixes used by rippled/Xahau when hashing ledger object indexes (LedgerNameSpace)
+export enum LedgerNameSpace {
+  ACCOUNT = 0x0061, // 'a'
+  HOOK = 0x0048, // 'H'
+  HOOK_DEFINITION = 0x0044, // 'D'
+  URI_TOKEN = 0x0055, // 'U'
+  HOOK_STATE = 0x0076, // 'v'
+}
+
+export const KEYLET_HASH_BYTES = 32;
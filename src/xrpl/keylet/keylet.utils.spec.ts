@@ -0,0 +1,52 @@
+import { createHash } from 'node:crypto';
+import { decodeAccountID } from '@transia/xrpl';
+import { accountKeylet, hookKeylet, hookStateKeylet, toHash256, uriTokenKeylet } from './keylet.utils';
+import {
+  TEST_ADDRESS_ALICE,
+  TEST_ADDRESS_BOB,
+  TEST_HOOK_NS,
+  TEST_TOKEN_URI,
+  TEST_URI_INDEX,
+} from '../../test-utils/test-utils';
+
+const sha512HalfOfHex = (hex: string) =>
+  createHash('sha512').update(Buffer.from(hex, 'hex')).digest('hex').slice(0, 64).toUpperCase();
+const accountIdHex = (address: string) => Buffer.from(decodeAccountID(address)).toString('hex').toUpperCase();
+
+describe('Keylet utils unit spec', () => {
+  test('should hash URIToken index from U namespace, issuer AccountID and raw URI bytes', () => {
+    const expected = sha512HalfOfHex('0055' + accountIdHex(TEST_ADDRESS_ALICE) + TEST_TOKEN_URI);
+
+    expect(uriTokenKeylet(TEST_ADDRESS_ALICE, TEST_TOKEN_URI)).toEqual(expected);
+  });
+
+  test('should derive different URIToken indexes for different issuers of the same URI', () => {
+    expect(uriTokenKeylet(TEST_ADDRESS_ALICE, TEST_TOKEN_URI)).not.toEqual(
+      uriTokenKeylet(TEST_ADDRESS_BOB, TEST_TOKEN_URI)
+    );
+  });
+
+  test('should hash HookState index from v namespace, account, state key and namespace', () => {
+    const accountID = accountIdHex(TEST_ADDRESS_ALICE);
+    const expected = sha512HalfOfHex('0076' + accountID + TEST_URI_INDEX + TEST_HOOK_NS);
+
+    expect(hookStateKeylet(TEST_ADDRESS_ALICE, TEST_URI_INDEX, TEST_HOOK_NS)).toEqual(expected);
+  });
+
+  test('should hash AccountRoot index from a namespace and account', () => {
+    expect(accountKeylet('rHb9CJAWyB4rj91VRWn96DkukG4bwdtyTh')).toEqual(
+      '2B6AC232AA4C4BE41BF49D2459FA4A0347E1B543A4C92FCEE0821C0201E2E9A8'
+    );
+  });
+
+  test('should hash Hook index from H namespace and account', () => {
+    const expected = sha512HalfOfHex('0048' + accountIdHex(TEST_ADDRESS_ALICE));
+
+    expect(hookKeylet(TEST_ADDRESS_ALICE)).toEqual(expected);
+  });
+
+  test('should left pad short hook state keys to 32 bytes', () => {
+    expect(toHash256('70000000').toString('hex')).toEqual('0'.repeat(56) + '70000000');
+    expect(() => toHash256('00'.repeat(33))).toThrow();
+  });
+});
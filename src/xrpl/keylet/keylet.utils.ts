@@ -0,0 +1,57 @@
+import { createHash } from 'node:crypto';
+import { decodeAccountID } from '@transia/xrpl';
+import { KEYLET_HASH_BYTES, LedgerNameSpace } from './keylet.constant';
+
+/**
+ * Ledger object indexes (keylets) computed locally the same way rippled does:
+ * SHA-512Half over the 16-bit namespace prefix followed by the raw identifying fields.
+ */
+export function sha512Half(...parts: Buffer[]): string {
+  const hash = createHash('sha512');
+  parts.forEach((part) => hash.update(part));
+  return hash.digest().subarray(0, KEYLET_HASH_BYTES).toString('hex').toUpperCase();
+}
+
+export function accountKeylet(account: string): string {
+  return sha512Half(namespacePrefix(LedgerNameSpace.ACCOUNT), accountIdBytes(account));
+}
+
+export function hookKeylet(account: string): string {
+  return sha512Half(namespacePrefix(LedgerNameSpace.HOOK), accountIdBytes(account));
+}
+
+export function hookDefinitionKeylet(hookHash: string): string {
+  return sha512Half(namespacePrefix(LedgerNameSpace.HOOK_DEFINITION), Buffer.from(hookHash, 'hex'));
+}
+
+export function uriTokenKeylet(issuer: string, uriHex: string): string {
+  return sha512Half(namespacePrefix(LedgerNameSpace.URI_TOKEN), accountIdBytes(issuer), Buffer.from(uriHex, 'hex'));
+}
+
+export function hookStateKeylet(account: string, stateKeyHex: string, namespaceHex: string): string {
+  return sha512Half(
+    namespacePrefix(LedgerNameSpace.HOOK_STATE),
+    accountIdBytes(account),
+    toHash256(stateKeyHex),
+    toHash256(namespaceHex)
+  );
+}
+
+// hook state keys shorter than 32 bytes are left padded with zeros by the hook API
+export function toHash256(hex: string): Buffer {
+  const bytes = Buffer.from(hex, 'hex');
+  if (bytes.length > KEYLET_HASH_BYTES) {
+    throw new Error(`Value: ${hex} does not fit into Hash256`);
+  }
+  return Buffer.concat([Buffer.alloc(KEYLET_HASH_BYTES - bytes.length), bytes]);
+}
+
+function namespacePrefix(space: LedgerNameSpace): Buffer {
+  const prefix = Buffer.alloc(2);
+  prefix.writeUInt16BE(space);
+  return prefix;
+}
+
+function accountIdBytes(address: string): Buffer {
+  return Buffer.from(decodeAccountID(address));
+}
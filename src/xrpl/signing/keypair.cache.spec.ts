@@ -0,0 +1,72 @@
+import { XRPL_Account } from 'xrpl-accountlib';
+import { KeypairCache } from './keypair.cache';
+import { TEST_ADDRESS_ALICE, TEST_SECRET } from '../../test-utils/test-utils';
+
+const deriveAccount = jest.fn(
+  (secret: string) =>
+    ({
+      address: TEST_ADDRESS_ALICE,
+      secret: { familySeed: secret },
+      keypair: { algorithm: 'secp256k1', publicKey: 'PUBLIC', privateKey: 'PRIVATE' },
+    }) as unknown as XRPL_Account
+);
+
+describe('KeypairCache unit spec', () => {
+  let now: number;
+
+  beforeEach(() => {
+    now = 0;
+    deriveAccount.mockClear();
+  });
+
+  test('should derive a secret once while its entry is alive', () => {
+    const underTest = new KeypairCache(10, 1000, () => now);
+
+    const first = underTest.getOrDerive(TEST_SECRET, deriveAccount);
+    const second = underTest.getOrDerive(TEST_SECRET, deriveAccount);
+
+    expect(second).toBe(first);
+    expect(deriveAccount).toBeCalledTimes(1);
+  });
+
+  test('should not keep the raw secret as a key', () => {
+    const underTest = new KeypairCache(10, 1000, () => now);
+    underTest.getOrDerive(TEST_SECRET, deriveAccount);
+
+    expect([...underTest['entries'].keys()]).not.toContain(TEST_SECRET);
+  });
+
+  test('should derive again and wipe the previous keypair once the ttl elapsed', () => {
+    const underTest = new KeypairCache(10, 1000, () => now);
+    const expired = underTest.getOrDerive(TEST_SECRET, deriveAccount);
+
+    now = 1000;
+    underTest.getOrDerive(TEST_SECRET, deriveAccount);
+
+    expect(deriveAccount).toBeCalledTimes(2);
+    expect(expired.keypair.privateKey).toEqual('');
+    expect(expired.secret.familySeed).toEqual('');
+  });
+
+  test('should evict the least recently used keypair beyond the bound', () => {
+    const underTest = new KeypairCache(2, 1000, () => now);
+    const evicted = underTest.getOrDerive('secret-1', deriveAccount);
+    underTest.getOrDerive('secret-2', deriveAccount);
+    underTest.getOrDerive('secret-3', deriveAccount);
+
+    expect(underTest.size).toEqual(2);
+    expect(evicted.keypair.privateKey).toEqual('');
+  });
+
+  test('should not cache nor wipe keypairs when the ttl is 0', () => {
+    const underTest = new KeypairCache(10, 0, () => now);
+
+    const first = underTest.getOrDerive(TEST_SECRET, deriveAccount);
+    const second = underTest.getOrDerive(TEST_SECRET, deriveAccount);
+
+    expect(second).not.toBe(first);
+    expect(deriveAccount).toBeCalledTimes(2);
+    expect(underTest.size).toEqual(0);
+    expect(first.keypair.privateKey).toEqual('PRIVATE');
+  });
+});
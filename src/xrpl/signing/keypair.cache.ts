@@ -0,0 +1,77 @@
+import { createHmac, randomBytes } from 'node:crypto';
+import { XRPL_Account } from 'xrpl-accountlib';
+import { KEYPAIR_CACHE_MAX_ENTRIES, KEYPAIR_CACHE_TTL_MS } from './signing.constants';
+
+interface ICachedKeypair {
+  account: XRPL_Account;
+  expiresAt: number;
+}
+
+const SENSITIVE_FIELDS = ['secret', 'keypair'];
+
+/**
+ * Bounded LRU of derived accounts with an absolute TTL. Entries are keyed by an HMAC of the secret under
+ * a per-thread random key, so no secret is kept as a map key. Evicted accounts have their secret and keypair
+ * fields overwritten; JS strings cannot be wiped in place, so this only drops the cache's references to them.
+ * Accounts must be used synchronously after lookup, an eviction on the next lookup clears them.
+ */
+export class KeypairCache {
+  private readonly hmacKey = randomBytes(32);
+  private readonly entries = new Map<string, ICachedKeypair>();
+
+  constructor(
+    private readonly maxEntries = KEYPAIR_CACHE_MAX_ENTRIES,
+    private readonly ttlMs = KEYPAIR_CACHE_TTL_MS,
+    private readonly now: () => number = Date.now
+  ) {}
+
+  get size(): number {
+    return this.entries.size;
+  }
+
+  getOrDerive(secret: string, deriveAccount: (secret: string) => XRPL_Account): XRPL_Account {
+    if (this.maxEntries <= 0 || this.ttlMs <= 0) {
+      return deriveAccount(secret);
+    }
+    const key = createHmac('sha256', this.hmacKey).update(secret).digest('hex');
+    const cached = this.entries.get(key);
+    if (cached && cached.expiresAt > this.now()) {
+      this.entries.delete(key);
+      this.entries.set(key, cached);
+      return cached.account;
+    }
+    if (cached) {
+      this.evict(key);
+    }
+    // evicting first makes room without ever touching the account handed out below
+    this.evictStale();
+    const account = deriveAccount(secret);
+    this.entries.set(key, { account, expiresAt: this.now() + this.ttlMs });
+    return account;
+  }
+
+  clear() {
+    [...this.entries.keys()].forEach((key) => this.evict(key));
+  }
+
+  private evictStale() {
+    const now = this.now();
+    for (const [key, entry] of this.entries) {
+      if (this.entries.size < this.maxEntries && entry.expiresAt > now) {
+        return;
+      }
+      this.evict(key);
+    }
+  }
+
+  private evict(key: string) {
+    const entry = this.entries.get(key);
+    this.entries.delete(key);
+    SENSITIVE_FIELDS.forEach((field) => {
+      const value = entry?.account?.[field];
+      if (value && typeof value === 'object') {
+        Object.keys(value).forEach((property) => (value[property] = typeof value[property] === 'string' ? '' : null));
+      }
+    });
+  }
+}
@@ -0,0 +1,25 @@
+import { derive, sign, XRPL_Account } from 'xrpl-accountlib';
+import { KeypairCache } from './keypair.cache';
+
+export interface ISignedTransaction {
+  hash: string;
+  signedTransaction: string;
+}
+
+// one cache per thread: every signing worker and the main thread keep their own derived keypairs
+const keypairCache = new KeypairCache();
+
+// shared by the signing workers and the inline path, so both derive and sign the same way
+export function signTransaction(tx: object, secret: string): ISignedTransaction {
+  const authorizedAccount = keypairCache.getOrDerive(secret, deriveAccount);
+  const signed = sign(tx, authorizedAccount);
+  return { hash: signed.id, signedTransaction: signed.signedTransaction };
+}
+
+function deriveAccount(secret: string): XRPL_Account {
+  try {
+    return derive.familySeed(secret);
+  } catch (err) {
+    throw new Error('Invalid account info');
+  }
+}
@@ -0,0 +1,11 @@
+// worker threads signing transactions; 0 signs inline on the main thread
+export const SIGNING_POOL_SIZE = parseInt(process.env.SIGNING_POOL_SIZE || '2');
+
+// compiled next to this file by nest build
+export const SIGNING_WORKER_FILE = 'signing.worker.js';
+
+// derived keypairs kept per signing thread, 0 disables the cache
+export const KEYPAIR_CACHE_MAX_ENTRIES = parseInt(process.env.KEYPAIR_CACHE_MAX_ENTRIES || '1000');
+
+// lifetime of a cached keypair counted from its derivation, use does not extend it, 0 disables the cache
+export const KEYPAIR_CACHE_TTL_MS = parseInt(process.env.KEYPAIR_CACHE_TTL_MS || '300000');
@@ -0,0 +1,26 @@
+import { ISignedTransaction } from './signer';
+
+// only the unsigned transaction and the key material cross the thread boundary
+export interface ISigningRequest {
+  id: number;
+  tx: object;
+  secret: string;
+}
+
+export interface ISigningResponse {
+  id: number;
+  result?: ISignedTransaction;
+  error?: string;
+}
+
+export interface ISigningPoolStats {
+  size: number;
+  busy: number;
+  queued: number;
+  // time spent by signing jobs waiting for a free worker
+  queueWaitMs: {
+    last: number;
+    max: number;
+    avg: number;
+  };
+}
@@ -0,0 +1,83 @@
+import { EventEmitter } from 'node:events';
+import { Worker } from 'node:worker_threads';
+import { SigningPool } from './signing.pool';
+import { ISigningRequest } from './signing.interface';
+import { signTransaction } from './signer';
+
+jest.mock('./signer', () => ({
+  signTransaction: jest.fn(() => ({ hash: 'HASH', signedTransaction: 'BLOB' })),
+}));
+
+class FakeWorker extends EventEmitter {
+  readonly received: ISigningRequest[] = [];
+  postMessage(request: ISigningRequest) {
+    this.received.push(request);
+  }
+  reply(result = { hash: 'HASH', signedTransaction: 'BLOB' }) {
+    this.emit('message', { id: this.received[this.received.length - 1].id, result });
+  }
+  terminate() {
+    return Promise.resolve(0);
+  }
+}
+
+class TestSigningPool extends SigningPool {
+  protected readonly size: number;
+  protected readonly workerFile = __filename;
+  readonly fakeWorkers: FakeWorker[] = [];
+
+  constructor(size: number) {
+    super();
+    this.size = size;
+  }
+
+  protected createWorker(): Worker {
+    const worker = new FakeWorker();
+    this.fakeWorkers.push(worker);
+    return worker as unknown as Worker;
+  }
+}
+
+describe('SigningPool unit spec', () => {
+  test('should sign inline when the pool size is 0', async () => {
+    const underTest = new TestSigningPool(0);
+
+    await expect(underTest.sign({ TransactionType: 'URITokenBuy' }, 'secret')).resolves.toEqual({
+      hash: 'HASH',
+      signedTransaction: 'BLOB',
+    });
+    expect(signTransaction).toBeCalledWith({ TransactionType: 'URITokenBuy' }, 'secret');
+    expect(underTest.fakeWorkers).toHaveLength(0);
+  });
+
+  test('should send only the transaction and secret to a worker and queue jobs beyond the pool size', async () => {
+    const underTest = new TestSigningPool(1);
+
+    const first = underTest.sign({ Sequence: 1 }, 'secret');
+    const second = underTest.sign({ Sequence: 2 }, 'secret');
+    const [worker] = underTest.fakeWorkers;
+
+    expect(underTest.fakeWorkers).toHaveLength(1);
+    expect(worker.received).toEqual([{ id: 0, tx: { Sequence: 1 }, secret: 'secret' }]);
+    expect(underTest.getStats()).toEqual(expect.objectContaining({ busy: 1, queued: 1 }));
+
+    worker.reply();
+    await expect(first).resolves.toEqual({ hash: 'HASH', signedTransaction: 'BLOB' });
+    expect(worker.received[1]).toEqual({ id: 1, tx: { Sequence: 2 }, secret: 'secret' });
+    worker.reply({ hash: 'HASH2', signedTransaction: 'BLOB2' });
+    await expect(second).resolves.toEqual({ hash: 'HASH2', signedTransaction: 'BLOB2' });
+    expect(underTest.getStats()).toEqual(expect.objectContaining({ busy: 0, queued: 0 }));
+  });
+
+  test('should reject the job of a worker that exited and replace it for the next job', async () => {
+    const underTest = new TestSigningPool(1);
+
+    const failed = underTest.sign({ Sequence: 1 }, 'secret');
+    underTest.fakeWorkers[0].emit('exit', 1);
+    await expect(failed).rejects.toThrow('Signing worker exited');
+
+    const next = underTest.sign({ Sequence: 2 }, 'secret');
+    underTest.fakeWorkers[1].reply();
+    await expect(next).resolves.toEqual({ hash: 'HASH', signedTransaction: 'BLOB' });
+  });
+});
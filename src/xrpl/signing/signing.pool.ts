@@ -0,0 +1,138 @@
+import { Injectable, Logger, OnModuleDestroy } from '@nestjs/common';
+import { existsSync } from 'node:fs';
+import { join } from 'node:path';
+import { Worker } from 'node:worker_threads';
+import { ISignedTransaction, signTransaction } from './signer';
+import { ISigningPoolStats, ISigningRequest, ISigningResponse } from './signing.interface';
+import { SIGNING_POOL_SIZE, SIGNING_WORKER_FILE } from './signing.constants';
+
+interface ISigningJob {
+  request: ISigningRequest;
+  enqueuedAt: number;
+  resolve: (signed: ISignedTransaction) => void;
+  reject: (err: Error) => void;
+}
+
+interface IPoolWorker {
+  worker: Worker;
+  job?: ISigningJob;
+}
+
+/**
+ * Moves key derivation and signing off the event loop onto a fixed set of worker threads started on first use.
+ * Jobs wait in a FIFO queue for a free worker; the time they spend there is recorded as the queue wait.
+ */
+@Injectable()
+export class SigningPool implements OnModuleDestroy {
+  protected readonly size: number = SIGNING_POOL_SIZE;
+  protected readonly workerFile: string = join(__dirname, SIGNING_WORKER_FILE);
+  private inline?: boolean;
+  private readonly workers: IPoolWorker[] = [];
+  private readonly queue: ISigningJob[] = [];
+  private nextJobId = 0;
+  private waits = 0;
+  private totalWaitMs = 0;
+  private lastWaitMs = 0;
+  private maxWaitMs = 0;
+
+  async sign(tx: object, secret: string): Promise<ISignedTransaction> {
+    if (this.isInline()) {
+      return signTransaction(tx, secret);
+    }
+    return new Promise((resolve, reject) => {
+      this.queue.push({ request: { id: this.nextJobId++, tx, secret }, enqueuedAt: Date.now(), resolve, reject });
+      this.dispatch();
+    });
+  }
+
+  getStats(): ISigningPoolStats {
+    return {
+      size: this.size,
+      busy: this.workers.filter(({ job }) => !!job).length,
+      queued: this.queue.length,
+      queueWaitMs: {
+        last: this.lastWaitMs,
+        max: this.maxWaitMs,
+        avg: this.waits === 0 ? 0 : this.totalWaitMs / this.waits,
+      },
+    };
+  }
+
+  async onModuleDestroy(): Promise<void> {
+    const workers = this.workers.splice(0, this.workers.length);
+    await Promise.all(workers.map(({ worker }) => worker.terminate()));
+  }
+
+  protected createWorker(): Worker {
+    return new Worker(this.workerFile);
+  }
+
+  // sources run through ts-node or jest have no compiled worker next to them
+  private isInline(): boolean {
+    if (this.inline === undefined) {
+      this.inline = this.size <= 0 || !existsSync(this.workerFile);
+      if (this.size > 0 && this.inline) {
+        Logger.warn(`Signing worker: ${this.workerFile} not found, transactions are signed on the main thread`);
+      }
+    }
+    return this.inline;
+  }
+
+  private dispatch() {
+    while (this.queue.length > 0) {
+      const poolWorker = this.getIdleWorker();
+      if (!poolWorker) {
+        return;
+      }
+      const job = this.queue.shift();
+      this.recordWait(Date.now() - job.enqueuedAt);
+      poolWorker.job = job;
+      poolWorker.worker.postMessage(job.request);
+    }
+  }
+
+  private getIdleWorker(): IPoolWorker | undefined {
+    const idle = this.workers.find(({ job }) => !job);
+    if (idle || this.workers.length >= this.size) {
+      return idle;
+    }
+    return this.startWorker();
+  }
+
+  private startWorker(): IPoolWorker {
+    const poolWorker: IPoolWorker = { worker: this.createWorker() };
+    poolWorker.worker.on('message', (response: ISigningResponse) => {
+      const job = poolWorker.job;
+      poolWorker.job = undefined;
+      if (response.error !== undefined) {
+        job?.reject(new Error(response.error));
+      } else {
+        job?.resolve(response.result);
+      }
+      this.dispatch();
+    });
+    poolWorker.worker.on('error', (err) => {
+      Logger.error(`Signing worker failed: ${err?.message}`);
+      poolWorker.job?.reject(err);
+      poolWorker.job = undefined;
+    });
+    poolWorker.worker.on('exit', () => {
+      const index = this.workers.indexOf(poolWorker);
+      if (index === -1) {
+        return;
+      }
+      this.workers.splice(index, 1);
+      poolWorker.job?.reject(new Error('Signing worker exited'));
+      this.dispatch();
+    });
+    this.workers.push(poolWorker);
+    return poolWorker;
+  }
+
+  private recordWait(waitMs: number) {
+    this.waits++;
+    this.totalWaitMs += waitMs;
+    this.lastWaitMs = waitMs;
+    this.maxWaitMs = Math.max(this.maxWaitMs, waitMs);
+  }
+}
@@ -0,0 +1,13 @@
+import { parentPort } from 'node:worker_threads';
+import { signTransaction } from './signer';
+import { ISigningRequest, ISigningResponse } from './signing.interface';
+
+parentPort.on('message', ({ id, tx, secret }: ISigningRequest) => {
+  let response: ISigningResponse;
+  try {
+    response = { id, result: signTransaction(tx, secret) };
+  } catch (err) {
+    response = { id, error: err?.message };
+  }
+  parentPort.postMessage(response);
+});
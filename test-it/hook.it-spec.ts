@@ -24,6 +24,13 @@ import { URITokenService } from '../src/uriToken/uri-token.service';
 import { RentalService } from '../src/rentals/rental.service';
 import { RentalType } from '../src/uriToken/uri-token.constant';
 import { HookService } from '../src/hooks/hook.service';
+import { HookGrantManager } from '../src/hooks/hook-grant.manager';
+import { LedgerStreamService } from '../src/xrpl/client/ledger-stream.service';
+import { URITokenOwnershipIndex } from '../src/uriToken/uri-token.index';
+import { SigningPool } from '../src/xrpl/signing/signing.pool';
+import { NetworkStateService } from '../src/xrpl/client/network-state.service';
+import { SubmissionScheduler } from '../src/xrpl/client/submission.scheduler';
+import { MetricsRegistry } from '../src/metrics/metrics.registry';
 import { RentalsTransactionFactory } from '../src/rentals/rentals.transactionFactory';
 import { ConflictException, ServiceUnavailableException } from '@nestjs/common';
 import { readFileSync } from 'fs';
@@ -48,21 +55,29 @@ describe('Hook rental logic testing', () => {
 
   beforeAll(async () => {
     await client.connect();
-    const firstWallet = await client.fundWallet(null, {
-      faucetHost: 'hooks-testnet-v3.xrpl-labs.com',
-    });
-    aliceWallet = firstWallet.wallet;
-    await setTimeout(10000);
-    const secondWallet = await client.fundWallet(null, {
-      faucetHost: 'hooks-testnet-v3.xrpl-labs.com',
-    });
-    bobWallet = secondWallet.wallet;
+    aliceWallet = await fundWallet();
+    // the testnet faucet rate limits funding requests
+    await setTimeout(process.env.XRPL_GENESIS_SECRET ? 0 : 10000);
+    bobWallet = await fundWallet();
     console.log(bobWallet);
   }, 30000);
 
   beforeEach(async () => {
     const module: TestingModule = await Test.createTestingModule({
-      providers: [XrplService, URITokenService, RentalService, HookService, RentalsTransactionFactory],
+      providers: [
+        XrplService,
+        URITokenService,
+        RentalService,
+        HookService,
+        RentalsTransactionFactory,
+        HookGrantManager,
+        LedgerStreamService,
+        URITokenOwnershipIndex,
+        SigningPool,
+        NetworkStateService,
+        SubmissionScheduler,
+        MetricsRegistry,
+      ],
     }).compile();
 
     xrplService = module.get<XrplService>(XrplService);
@@ -373,6 +388,28 @@ describe('Hook rental logic testing', () => {
     });
   }, 30000);
 
+  // against the local ledger simulator (npm run simulator) wallets are funded by its genesis account
+  async function fundWallet(): Promise<Wallet> {
+    if (!process.env.XRPL_GENESIS_SECRET) {
+      const { wallet } = await client.fundWallet(null, {
+        faucetHost: 'hooks-testnet-v3.xrpl-labs.com',
+      });
+      return wallet;
+    }
+    const genesis = Wallet.fromSeed(process.env.XRPL_GENESIS_SECRET);
+    const wallet = Wallet.generate();
+    await client.submitAndWait(
+      {
+        TransactionType: 'Payment',
+        Account: genesis.address,
+        Destination: wallet.address,
+        Amount: xrpToDrops(10000),
+      },
+      { wallet: genesis }
+    );
+    return wallet;
+  }
+
   function generateRandomNamespace() {
     const randomBytesForNS = randomBytes(32);
     const hash = createHash('sha256');
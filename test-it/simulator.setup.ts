@@ -0,0 +1,30 @@
+import { readFileSync } from 'node:fs';
+import { loadFixtures } from '../bench/rippled-stub';
+import { RippledSimulator } from '../bench/simulator/rippled-simulator';
+import {
+  BENCH_ACCOUNT,
+  BENCH_FIXTURES,
+  BENCH_HOOK_CODE,
+  BENCH_LEDGER_INTERVAL_MS,
+  SIMULATOR_NETWORK,
+} from '../bench/bench.constants';
+
+/**
+ * Starts the ledger simulator the integration tests run against, funding the test wallets from its genesis
+ * account. Setting SERVER_API_ENDPOINT runs them against that node instead (funded by XRPL_GENESIS_SECRET,
+ * or by the testnet faucet without it). The test workers are forked afterwards and inherit the endpoint.
+ */
+export default async function startSimulator() {
+  if (process.env.SERVER_API_ENDPOINT) {
+    return;
+  }
+  const simulator = RippledSimulator.fromFixtures(loadFixtures(BENCH_FIXTURES), readFileSync(BENCH_HOOK_CODE), {
+    latencyMs: 0,
+    jitterMs: 0,
+    ledgerIntervalMs: BENCH_LEDGER_INTERVAL_MS,
+    ...SIMULATOR_NETWORK,
+  });
+  process.env.SERVER_API_ENDPOINT = await simulator.start();
+  process.env.XRPL_GENESIS_SECRET = BENCH_ACCOUNT.secret;
+  globalThis.__SIMULATOR__ = simulator;
+}
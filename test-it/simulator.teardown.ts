@@ -0,0 +1,5 @@
+import { RippledSimulator } from '../bench/simulator/rippled-simulator';
+
+export default async function stopSimulator() {
+  await (globalThis.__SIMULATOR__ as RippledSimulator | undefined)?.stop();
+}